@@ -0,0 +1,312 @@
+// Порівняння моделей паралелізму курсу на однакових задачах:
+// pthreads (lab1), std::thread (lab2), std::async (lab3), Boost.Thread (lab4),
+// OpenMP (lab5) та паралельні алгоритми STL (std::execution::par_unseq).
+//
+// Для кожного бекенда вимірюються:
+//   накладні витрати — запуск і очікування T порожніх завдань;
+//   сума ряду 1/i² блоками series.h (результат має збігатися до біта);
+//   множення матриць рядками (matmul_rows, ядро rowstream).
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <execution>
+#include <future>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <pthread.h>
+#include <omp.h>
+#include <boost/thread/thread.hpp>
+
+#if __has_include(<tbb/global_control.h>)
+#include <tbb/global_control.h>
+#define BENCH_HAVE_TBB 1
+#endif
+
+#include "../common/matmul_kernels.hpp"
+#include "../common/matrix_gen.hpp"
+#include "../common/series.h"
+
+using namespace std;
+
+enum class Backend { Pthreads, StdThread, Async, Boost, OpenMP, ParallelStl };
+
+const Backend all_backends[] = {Backend::Pthreads, Backend::StdThread, Backend::Async,
+                                Backend::Boost, Backend::OpenMP, Backend::ParallelStl};
+
+const char* backend_name(Backend backend) {
+    switch (backend) {
+    case Backend::Pthreads: return "pthreads";
+    case Backend::StdThread: return "thread";
+    case Backend::Async: return "async";
+    case Backend::Boost: return "boost";
+    case Backend::OpenMP: return "openmp";
+    case Backend::ParallelStl: return "parstl";
+    }
+    return "?";
+}
+
+// Межі частини worker з threads рівних суцільних частин [0, count)
+void split_range(long long count, int threads, int worker, long long& begin, long long& end) {
+    long long per = count / threads, extra = count % threads;
+    begin = worker * per + min<long long>(worker, extra);
+    end = begin + per + (worker < extra ? 1 : 0);
+}
+
+// Ітератор по числах [begin, end): паралельний STL отримує індекси без
+// масиву, тож у вимірюваний час не входить його виділення й заповнення
+struct CountingIterator {
+    using iterator_category = random_access_iterator_tag;
+    using value_type = long long;
+    using difference_type = long long;
+    using pointer = const long long*;
+    using reference = long long;
+
+    long long i;
+
+    long long operator*() const { return i; }
+    long long operator[](long long d) const { return i + d; }
+    CountingIterator& operator++() { ++i; return *this; }
+    CountingIterator operator++(int) { return {i++}; }
+    CountingIterator& operator--() { --i; return *this; }
+    CountingIterator operator--(int) { return {i--}; }
+    CountingIterator& operator+=(long long d) { i += d; return *this; }
+    CountingIterator& operator-=(long long d) { i -= d; return *this; }
+    CountingIterator operator+(long long d) const { return {i + d}; }
+    CountingIterator operator-(long long d) const { return {i - d}; }
+    friend CountingIterator operator+(long long d, CountingIterator it) { return {it.i + d}; }
+    long long operator-(CountingIterator other) const { return i - other.i; }
+    bool operator==(CountingIterator other) const { return i == other.i; }
+    bool operator!=(CountingIterator other) const { return i != other.i; }
+    bool operator<(CountingIterator other) const { return i < other.i; }
+    bool operator>(CountingIterator other) const { return i > other.i; }
+    bool operator<=(CountingIterator other) const { return i <= other.i; }
+    bool operator>=(CountingIterator other) const { return i >= other.i; }
+};
+
+template <class Body>
+struct PthreadTask {
+    const Body* body;
+    long long begin;
+    long long end;
+
+    static void* run(void* arg) {
+        PthreadTask* task = static_cast<PthreadTask*>(arg);
+        (*task->body)(task->begin, task->end);
+        return nullptr;
+    }
+};
+
+// Виконує body(begin, end) над [0, count) на обраному бекенді.
+// Потокові бекенди ділять діапазон на threads суцільних частин;
+// паралельний STL отримує індекси поштучно й розподіляє їх сам.
+// Потік pthreads, який не вдалося створити, виконує свою частину тут же.
+template <class Body>
+void parallel_ranges(Backend backend, int threads, long long count, const Body& body) {
+    switch (backend) {
+    case Backend::Pthreads: {
+        vector<pthread_t> ids(threads);
+        vector<PthreadTask<Body>> tasks(threads);
+        vector<char> started(threads);
+        for (int t = 0; t < threads; t++) {
+            tasks[t].body = &body;
+            split_range(count, threads, t, tasks[t].begin, tasks[t].end);
+            started[t] = pthread_create(&ids[t], nullptr, PthreadTask<Body>::run, &tasks[t]) == 0;
+            if (!started[t]) {
+                PthreadTask<Body>::run(&tasks[t]);
+            }
+        }
+        for (int t = 0; t < threads; t++) {
+            if (started[t]) {
+                pthread_join(ids[t], nullptr);
+            }
+        }
+        break;
+    }
+    case Backend::StdThread: {
+        vector<thread> pool;
+        for (int t = 0; t < threads; t++) {
+            long long begin, end;
+            split_range(count, threads, t, begin, end);
+            pool.emplace_back([&body, begin, end] { body(begin, end); });
+        }
+        for (thread& th : pool) {
+            th.join();
+        }
+        break;
+    }
+    case Backend::Async: {
+        vector<future<void>> futures;
+        for (int t = 0; t < threads; t++) {
+            long long begin, end;
+            split_range(count, threads, t, begin, end);
+            futures.push_back(async(launch::async, [&body, begin, end] { body(begin, end); }));
+        }
+        for (future<void>& f : futures) {
+            f.get();
+        }
+        break;
+    }
+    case Backend::Boost: {
+        vector<boost::thread> pool;
+        for (int t = 0; t < threads; t++) {
+            long long begin, end;
+            split_range(count, threads, t, begin, end);
+            pool.push_back(boost::thread([&body, begin, end] { body(begin, end); }));
+        }
+        for (boost::thread& th : pool) {
+            th.join();
+        }
+        break;
+    }
+    case Backend::OpenMP: {
+        #pragma omp parallel num_threads(threads)
+        {
+            long long begin, end;
+            split_range(count, threads, omp_get_thread_num(), begin, end);
+            body(begin, end);
+        }
+        break;
+    }
+    case Backend::ParallelStl: {
+#ifdef BENCH_HAVE_TBB
+        tbb::global_control limit(tbb::global_control::max_allowed_parallelism, threads);
+#endif
+        for_each(execution::par_unseq, CountingIterator{0}, CountingIterator{count},
+                 [&body](long long i) { body(i, i + 1); });
+        break;
+    }
+    }
+}
+
+struct SquareMatrix {
+    size_t n;
+    vector<double> data;
+
+    explicit SquareMatrix(size_t n) : n(n), data(n * n) {}
+
+    double* operator[](size_t i) { return data.data() + i * n; }
+    const double* operator[](size_t i) const { return data.data() + i * n; }
+};
+
+struct BenchRow {
+    double overheadUs = 0.0;
+    double seriesMs = 0.0;
+    double seriesSum = 0.0;
+    double matmulMs = 0.0;
+    bool matmulExact = false;
+};
+
+template <class Fn>
+double best_time_ms(int repeats, Fn fn) {
+    double best = 1e300;
+    for (int r = 0; r < repeats; r++) {
+        auto start = chrono::steady_clock::now();
+        fn();
+        chrono::duration<double, milli> elapsed = chrono::steady_clock::now() - start;
+        best = min(best, elapsed.count());
+    }
+    return best;
+}
+
+int main(int argc, char* argv[]) {
+    int threads = (argc > 1) ? atoi(argv[1]) : (int)max(1u, thread::hardware_concurrency());
+    long long terms = (argc > 2) ? strtoll(argv[2], nullptr, 10) : 100000000LL;
+    size_t n = (argc > 3) ? strtoul(argv[3], nullptr, 10) : 512;
+    string selected = (argc > 4) ? argv[4] : "all";
+
+    vector<Backend> backends;
+    for (Backend b : all_backends) {
+        if (selected == "all" || ("," + selected + ",").find(string(",") + backend_name(b) + ",") != string::npos) {
+            backends.push_back(b);
+        }
+    }
+
+    if (threads < 1 || terms < 1 || n < 1 || backends.empty()) {
+        cerr << "Використання: " << argv[0] << " [потоків] [доданків] [розмір_матриці]"
+             << " [all|pthreads,thread,async,boost,openmp,parstl]" << endl;
+        return 1;
+    }
+
+    const int REPEATS = 3;
+    const int OVERHEAD_REPEATS = 50;
+
+    MatrixGenOptions opts;
+    opts.a = -1.0;
+    opts.b = 1.0;
+    SquareMatrix A(n), B(n), reference(n);
+    opts.seed = 1;
+    matrix_generate(A, n, n, opts);
+    opts.seed = 2;
+    matrix_generate(B, n, n, opts);
+    matmul_rows(A, B, reference, n, n, 0, n, MatmulKernel::RowStream, 64);
+
+    const long long blocks = series_block_count(terms);
+    vector<double> blockSums(blocks);
+    const double seriesReference = [&] {
+        for (long long b = 0; b < blocks; b++) {
+            long long first, last;
+            series_block_range(b, terms, &first, &last);
+            blockSums[b] = series_inv_square_block(first, last);
+        }
+        return series_pairwise_sum(blockSums.data(), blocks);
+    }();
+
+    cout << "Потоків: " << threads << ", доданків ряду: " << terms
+         << ", матриці " << n << "x" << n << endl;
+
+    vector<BenchRow> rows;
+    for (Backend backend : backends) {
+        BenchRow row;
+
+        // Накладні витрати: запуск і очікування threads порожніх завдань
+        row.overheadUs = 1000.0 * best_time_ms(OVERHEAD_REPEATS, [&] {
+            parallel_ranges(backend, threads, threads, [](long long, long long) {});
+        });
+
+        row.seriesMs = best_time_ms(REPEATS, [&] {
+            parallel_ranges(backend, threads, blocks, [&](long long begin, long long end) {
+                for (long long b = begin; b < end; b++) {
+                    long long first, last;
+                    series_block_range(b, terms, &first, &last);
+                    blockSums[b] = series_inv_square_block(first, last);
+                }
+            });
+            row.seriesSum = series_pairwise_sum(blockSums.data(), blocks);
+        });
+
+        SquareMatrix C(n);
+        row.matmulMs = best_time_ms(REPEATS, [&] {
+            parallel_ranges(backend, threads, (long long)n, [&](long long begin, long long end) {
+                matmul_rows(A, B, C, n, n, (size_t)begin, (size_t)end, MatmulKernel::RowStream, 64);
+            });
+        });
+        row.matmulExact = C.data == reference.data;
+
+        rows.push_back(row);
+    }
+
+    cout << "\nБекенд    Запуск (мкс)  Ряд (мс)  Млн дод./с  Множення (мс)  GFLOP/с  Збіг\n";
+    cout << fixed;
+    for (size_t i = 0; i < rows.size(); i++) {
+        const BenchRow& r = rows[i];
+        bool exact = r.seriesSum == seriesReference && r.matmulExact;
+        cout << left << setw(10) << backend_name(backends[i]) << right
+             << setw(12) << setprecision(1) << r.overheadUs
+             << setw(10) << setprecision(3) << r.seriesMs
+             << setw(12) << setprecision(1) << terms / (r.seriesMs * 1000.0)
+             << setw(15) << setprecision(3) << r.matmulMs
+             << setw(9) << setprecision(2) << 2.0 * n * n * n / (r.matmulMs * 1e6)
+             << "  " << (exact ? "так" : "НІ") << "\n";
+    }
+    cout << "Сума ряду: " << setprecision(15) << seriesReference << endl;
+
+    return 0;
+}
@@ -0,0 +1,212 @@
+#pragma once
+
+// Автопідбір конфігурації множення (кількість потоків, ядро, розмір плитки)
+// для заданої форми задачі m x n · n x p. Переможець зберігається у файл
+// конфігурації поточного хоста (autotune_<hostname>.conf або шлях з
+// AUTOTUNE_FILE) і підхоплюється наступними запусками автоматично.
+// Записи розрізняються ще й програмою: lab2_2 (std::thread) і lab5_2
+// (OpenMP) ділять рядки між потоками по-різному, тож переможець однієї
+// не годиться іншій.
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <unistd.h>
+
+#include "matmul_kernels.hpp"
+
+struct AutotuneEntry {
+    std::string program;
+    size_t m = 0;
+    size_t n = 0;
+    size_t p = 0;
+    MatmulConfig config;
+    double timeMs = 0.0;
+};
+
+inline std::string autotune_default_path() {
+    const char* env = std::getenv("AUTOTUNE_FILE");
+    if (env != nullptr && env[0] != '\0') {
+        return env;
+    }
+    char host[256] = "localhost";
+    if (gethostname(host, sizeof(host)) != 0) {
+        std::snprintf(host, sizeof(host), "localhost");
+    }
+    host[sizeof(host) - 1] = '\0';
+    return std::string("autotune_") + host + ".conf";
+}
+
+class AutotuneStore {
+public:
+    explicit AutotuneStore(const std::string& program, const std::string& path = autotune_default_path())
+        : program_(program), path_(path) {
+        load();
+    }
+
+    const std::string& path() const { return path_; }
+
+    // Точний збіг форми — швидкий шлях; інакше найближча за об'ємом
+    // налаштована форма як наближення. false, якщо для цієї програми
+    // записів немає.
+    bool lookup(size_t m, size_t n, size_t p, MatmulConfig& config, bool& exact) const {
+        const AutotuneEntry* best = nullptr;
+        double bestDistance = std::numeric_limits<double>::max();
+        for (const AutotuneEntry& e : entries_) {
+            if (e.program != program_) {
+                continue;
+            }
+            if (e.m == m && e.n == n && e.p == p) {
+                config = e.config;
+                exact = true;
+                return true;
+            }
+            double distance = std::fabs(std::log(double(e.m) * e.n * e.p) - std::log(double(m) * n * p));
+            if (distance < bestDistance) {
+                bestDistance = distance;
+                best = &e;
+            }
+        }
+        if (best == nullptr) {
+            return false;
+        }
+        config = best->config;
+        exact = false;
+        return true;
+    }
+
+    void put(AutotuneEntry entry) {
+        entry.program = program_;
+        for (AutotuneEntry& e : entries_) {
+            if (e.program == entry.program && e.m == entry.m && e.n == entry.n && e.p == entry.p) {
+                e = entry;
+                return;
+            }
+        }
+        entries_.push_back(entry);
+    }
+
+    bool save() const {
+        std::ofstream file(path_);
+        if (!file.is_open()) {
+            std::cerr << "Помилка створення файлу конфігурації: " << path_ << std::endl;
+            return false;
+        }
+        file << "# програма m n p потоків ядро плитка час_мс\n";
+        for (const AutotuneEntry& e : entries_) {
+            file << e.program << " " << e.m << " " << e.n << " " << e.p << " " << e.config.threads << " "
+                 << matmul_kernel_name(e.config.kernel) << " " << e.config.tile << " "
+                 << std::fixed << std::setprecision(3) << e.timeMs << "\n";
+        }
+        return true;
+    }
+
+private:
+    void load() {
+        std::ifstream file(path_);
+        std::string line;
+        while (std::getline(file, line)) {
+            if (line.empty() || line[0] == '#') {
+                continue;
+            }
+            std::istringstream iss(line);
+            AutotuneEntry e;
+            std::string kernel;
+            // Рядки старого формату, без програми, не розбираються і
+            // відкидаються: чия це конфігурація, невідомо
+            if (iss >> e.program >> e.m >> e.n >> e.p >> e.config.threads >> kernel >> e.config.tile >> e.timeMs &&
+                matmul_kernel_parse(kernel, e.config.kernel) && e.config.threads > 0) {
+                entries_.push_back(e);
+            }
+        }
+    }
+
+    std::string program_;
+    std::string path_;
+    std::vector<AutotuneEntry> entries_;
+};
+
+// Перебір: спершу ядро та плитка на всіх ядрах, потім кількість потоків
+// для переможця. run(config) повертає час одного множення в мс.
+inline AutotuneEntry autotune_search(size_t m, size_t n, size_t p,
+                                     const std::function<double(const MatmulConfig&)>& run) {
+    const size_t hw = std::max(1u, std::thread::hardware_concurrency());
+    const int RUNS = 2;
+
+    auto measure = [&](const MatmulConfig& config) {
+        double best = std::numeric_limits<double>::max();
+        for (int r = 0; r < RUNS; ++r) {
+            best = std::min(best, run(config));
+        }
+        std::cout << "  " << std::setw(9) << matmul_kernel_name(config.kernel)
+                  << " плитка " << std::setw(4) << config.tile
+                  << " потоків " << std::setw(3) << config.threads
+                  << ": " << std::fixed << std::setprecision(3) << best << " мс" << std::endl;
+        return best;
+    };
+
+    std::vector<MatmulConfig> candidates;
+    MatmulConfig c;
+    c.threads = hw;
+    c.kernel = MatmulKernel::Naive;
+    candidates.push_back(c);
+    c.kernel = MatmulKernel::RowStream;
+    candidates.push_back(c);
+    c.kernel = MatmulKernel::Tiled;
+    for (size_t tile : {32, 64, 128, 256}) {
+        if (tile / 2 < std::max(n, p)) {
+            c.tile = tile;
+            candidates.push_back(c);
+        }
+    }
+
+    AutotuneEntry best;
+    best.m = m;
+    best.n = n;
+    best.p = p;
+    best.timeMs = std::numeric_limits<double>::max();
+
+    std::cout << "Автопідбір для форми " << m << "x" << n << " · " << n << "x" << p << std::endl;
+    for (const MatmulConfig& config : candidates) {
+        double t = measure(config);
+        if (t < best.timeMs) {
+            best.timeMs = t;
+            best.config = config;
+        }
+    }
+
+    std::vector<size_t> threadCounts;
+    for (size_t t = 1; t <= 2 * hw; t *= 2) {
+        threadCounts.push_back(t);
+    }
+    threadCounts.push_back(hw);
+    std::sort(threadCounts.begin(), threadCounts.end());
+    threadCounts.erase(std::unique(threadCounts.begin(), threadCounts.end()), threadCounts.end());
+
+    MatmulConfig base = best.config;
+    for (size_t threads : threadCounts) {
+        if (threads == base.threads || threads > m) {
+            continue;
+        }
+        MatmulConfig config = base;
+        config.threads = threads;
+        double t = measure(config);
+        if (t < best.timeMs) {
+            best.timeMs = t;
+            best.config = config;
+        }
+    }
+
+    return best;
+}
@@ -0,0 +1,370 @@
+#ifndef CHUNKSCAN_H
+#define CHUNKSCAN_H
+
+/*
+ * Паралельне сканування одного файлу діапазонами байтів.
+ *
+ * Файл ділиться на threads суцільних діапазонів. Якщо файл вдалося
+ * відобразити (mapped_file.h), кожен потік сканує свій діапазон на місці
+ * одним викликом ops->scan; інакше читає його через pread() буферами по
+ * CHUNKSCAN_BUFFER і для кожного буфера будує окремий стан, який одразу
+ * зливає у свій накопичувач (ops->merge). Наприкінці стани потоків
+ * зливаються у result зліва направо. Злиття має бути асоціативним, тоді
+ * результат не залежить від кількості потоків і меж буферів, а збігається
+ * з послідовним проходом.
+ *
+ * Кожен ініціалізований стан рано чи пізно передається в ops->merge як
+ * next і більше не використовується, тож стан може володіти пам'яттю
+ * (wordfreq.h): merge забирає або звільняє її.
+ *
+ * chunkscan_mapped_from() сканує звичайний файл лише від заданого
+ * зміщення і зливає в result, що вже містить стан початку файлу (так
+ * кеш статистики, statcache.h, дочитує файли, до яких лише дописали).
+ *
+ * Файли, менші за CHUNKSCAN_PARALLEL_MIN, скануються одним потоком
+ * (тим самим кодом), щоб не платити за запуск потоків.
+ *
+ * Канали, stdin і пристрої (розмір невідомий, діапазонів немає) читаються
+ * потоково з подвійною буферизацією: окремий потік-читач заповнює блок
+ * CHUNKSCAN_STREAM_BLOCK через read(), поки сканер обробляє попередній.
+ * Блоки зливаються тим самим merge, тож рядки і слова будь-якої довжини,
+ * розрізані межами блоків, рахуються так само, як у відображеному файлі.
+ * Стиснений файл (decompress.h) власного читача не потребує: блоки
+ * кільця розпаковувача скануються на місці.
+ *
+ * Заголовок придатний і для C (lab1), і для C++ (lab2).
+ */
+
+#include <errno.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "mapped_file.h"
+#include "trace.h"
+
+#define CHUNKSCAN_BUFFER (1 << 20)
+#define CHUNKSCAN_PARALLEL_MIN (8LL << 20)
+#define CHUNKSCAN_STREAM_BLOCK (4 << 20)
+
+typedef struct {
+    size_t state_size;
+    /* Порожній стан без лівого контексту — нейтральний елемент злиття */
+    void (*init)(void* state);
+    /* Сканує окремий шматок у щойно ініціалізований стан */
+    void (*scan)(void* state, const unsigned char* data, size_t len);
+    /* acc = acc · next */
+    void (*merge)(void* acc, const void* next);
+} ChunkScanOps;
+
+typedef struct {
+    const ChunkScanOps* ops;
+    int fd;
+    const unsigned char* data;  /* відображення файлу або NULL */
+    long long begin;
+    long long end;
+    void* state;
+    int error;
+    int threaded;  /* діапазон сканує окремий потік, його треба дочекатися */
+} ChunkScanRange;
+
+static inline void* chunkscan_range_thread(void* arg) {
+    ChunkScanRange* range = (ChunkScanRange*)arg;
+    uint64_t trace_start = trace_begin();
+    const ChunkScanOps* ops = range->ops;
+
+    if (range->data != NULL) {
+        ops->init(range->state);
+        ops->scan(range->state, range->data + range->begin, (size_t)(range->end - range->begin));
+        trace_end_detail("chunkscan_range", trace_start, NULL, range->begin);
+        return NULL;
+    }
+
+    unsigned char* buffer = (unsigned char*)malloc(CHUNKSCAN_BUFFER);
+    void* piece = malloc(ops->state_size);
+
+    ops->init(range->state);
+    if (buffer == NULL || piece == NULL) {
+        range->error = ENOMEM;
+    }
+
+    long long offset = range->begin;
+    while (range->error == 0 && offset < range->end) {
+        long long want = range->end - offset;
+        if (want > CHUNKSCAN_BUFFER) {
+            want = CHUNKSCAN_BUFFER;
+        }
+        ssize_t got = pread(range->fd, buffer, (size_t)want, (off_t)offset);
+        if (got < 0) {
+            if (errno != EINTR) {
+                range->error = errno;
+            }
+            continue;
+        }
+        if (got == 0) {
+            break; /* файл укоротили під час читання */
+        }
+        ops->init(piece);
+        ops->scan(piece, buffer, (size_t)got);
+        ops->merge(range->state, piece);
+        offset += got;
+    }
+
+    free(piece);
+    free(buffer);
+    trace_end_detail("chunkscan_range", trace_start, NULL, range->begin);
+    return NULL;
+}
+
+/* Два блоки потокового читання: читач заповнює один, поки сканер
+ * обробляє інший */
+typedef struct {
+    int fd;
+    unsigned char* blocks[2];
+    size_t len[2];
+    int full[2];                /* блок заповнено і ще не відскановано */
+    int last[2];                /* після цього блоку даних немає */
+    int error;
+    pthread_mutex_t mutex;
+    pthread_cond_t changed;
+} ChunkScanStream;
+
+/* Заповнює блок read() до кінця, щоб сканер отримував великі шматки навіть
+ * з каналу, що віддає дрібними порціями; 1 — кінець даних, 0 — ні */
+static inline int chunkscan_stream_fill(int fd, unsigned char* block, size_t* len, int* error) {
+    *len = 0;
+    while (*len < CHUNKSCAN_STREAM_BLOCK) {
+        ssize_t got = read(fd, block + *len, CHUNKSCAN_STREAM_BLOCK - *len);
+        if (got < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            *error = errno;
+            return 1;
+        }
+        if (got == 0) {
+            return 1;
+        }
+        *len += (size_t)got;
+    }
+    return 0;
+}
+
+static inline void* chunkscan_reader_thread(void* arg) {
+    ChunkScanStream* s = (ChunkScanStream*)arg;
+    for (int b = 0, last = 0; !last; b ^= 1) {
+        pthread_mutex_lock(&s->mutex);
+        while (s->full[b]) {
+            pthread_cond_wait(&s->changed, &s->mutex);
+        }
+        pthread_mutex_unlock(&s->mutex);
+
+        size_t len;
+        int error = 0;
+        last = chunkscan_stream_fill(s->fd, s->blocks[b], &len, &error);
+
+        pthread_mutex_lock(&s->mutex);
+        s->len[b] = len;
+        s->last[b] = last;
+        s->full[b] = 1;
+        if (error != 0) {
+            s->error = error;
+        }
+        pthread_cond_signal(&s->changed);
+        pthread_mutex_unlock(&s->mutex);
+    }
+    return NULL;
+}
+
+static inline void chunkscan_stream_piece(const ChunkScanOps* ops, void* piece, void* result,
+                                          const unsigned char* data, size_t len) {
+    if (len > 0) {
+        ops->init(piece);
+        ops->scan(piece, data, len);
+        ops->merge(result, piece);
+    }
+}
+
+/* Потокове читання каналу чи пристрою до кінця, починаючи з байтів, уже
+ * прочитаних mapped_file_peek(); 0 або код помилки */
+static inline int chunkscan_stream(MappedFile* file, const ChunkScanOps* ops, void* result) {
+    uint64_t trace_start = trace_begin();
+    ChunkScanStream s;
+    memset(&s, 0, sizeof(s));
+    s.fd = file->fd;
+    s.blocks[0] = (unsigned char*)malloc(CHUNKSCAN_STREAM_BLOCK);
+    s.blocks[1] = (unsigned char*)malloc(CHUNKSCAN_STREAM_BLOCK);
+    void* piece = malloc(ops->state_size);
+    int error = (s.blocks[0] == NULL || s.blocks[1] == NULL || piece == NULL) ? ENOMEM : 0;
+
+    pthread_t reader;
+    int threaded = 0;
+    if (error == 0 && !file->eof) {
+        pthread_mutex_init(&s.mutex, NULL);
+        pthread_cond_init(&s.changed, NULL);
+        threaded = pthread_create(&reader, NULL, chunkscan_reader_thread, &s) == 0;
+        if (!threaded) {
+            pthread_mutex_destroy(&s.mutex);
+            pthread_cond_destroy(&s.changed);
+        }
+    }
+
+    /* Байти з mapped_file_peek() — поки читач уже заповнює перший блок */
+    if (error == 0) {
+        chunkscan_stream_piece(ops, piece, result, file->head, file->head_len);
+    }
+
+    if (threaded) {
+        for (int b = 0, last = 0; !last; b ^= 1) {
+            pthread_mutex_lock(&s.mutex);
+            while (!s.full[b]) {
+                pthread_cond_wait(&s.changed, &s.mutex);
+            }
+            pthread_mutex_unlock(&s.mutex);
+
+            chunkscan_stream_piece(ops, piece, result, s.blocks[b], s.len[b]);
+            last = s.last[b];
+
+            pthread_mutex_lock(&s.mutex);
+            s.full[b] = 0;
+            pthread_cond_signal(&s.changed);
+            pthread_mutex_unlock(&s.mutex);
+        }
+        pthread_join(reader, NULL);
+        pthread_mutex_destroy(&s.mutex);
+        pthread_cond_destroy(&s.changed);
+        error = s.error;
+    } else if (error == 0 && !file->eof) {
+        /* Потік не запустився: те саме без перекриття */
+        for (int last = 0; !last;) {
+            size_t len;
+            last = chunkscan_stream_fill(file->fd, s.blocks[0], &len, &error);
+            chunkscan_stream_piece(ops, piece, result, s.blocks[0], len);
+        }
+    }
+    file->eof = 1;
+
+    free(piece);
+    free(s.blocks[0]);
+    free(s.blocks[1]);
+    trace_end_detail("chunkscan_stream", trace_start, NULL, TRACE_NO_ARG);
+    return error;
+}
+
+/* Стиснений вхід: розпаковані блоки скануються просто в кільці */
+static inline int chunkscan_decoded(MappedFile* file, const ChunkScanOps* ops, void* result) {
+    void* piece = malloc(ops->state_size);
+    if (piece == NULL) {
+        return ENOMEM;
+    }
+    chunkscan_stream_piece(ops, piece, result, file->head, file->head_len);
+    int error = 0;
+    const unsigned char* data;
+    size_t len;
+    int rc;
+    while ((rc = decompress_next(file->decoder, &data, &len)) > 0) {
+        chunkscan_stream_piece(ops, piece, result, data, len);
+    }
+    if (rc < 0) {
+        error = errno;
+    }
+    file->eof = 1;
+    free(piece);
+    return error;
+}
+
+/* Сканує відкритий файл від зміщення offset (для каналів — лише 0) і
+ * зливає результат у result (ініціалізований викликачем, наприклад
+ * віртуальним префіксом). Файл лишається відкритим.
+ * 0 — успіх, -1 — помилка з errno. */
+static inline int chunkscan_mapped_from(MappedFile* file, const ChunkScanOps* ops, int threads,
+                                        long long offset, void* result) {
+    if (!file->regular) {
+        if (offset != 0) {
+            errno = ESPIPE;
+            return -1;
+        }
+        int error = file->decoder != NULL ? chunkscan_decoded(file, ops, result)
+                                          : chunkscan_stream(file, ops, result);
+        if (error != 0) {
+            errno = error;
+            return -1;
+        }
+        return 0;
+    }
+
+    long long size = (long long)file->size;
+    if (offset > size) {
+        offset = size;
+    }
+    if (threads < 1 || size - offset < CHUNKSCAN_PARALLEL_MIN) {
+        threads = 1;
+    }
+
+    ChunkScanRange* ranges = (ChunkScanRange*)calloc((size_t)threads, sizeof(ChunkScanRange));
+    char* states = (char*)malloc((size_t)threads * ops->state_size);
+    pthread_t* ids = (pthread_t*)malloc((size_t)threads * sizeof(pthread_t));
+    int error = (ranges == NULL || states == NULL || ids == NULL) ? ENOMEM : 0;
+
+    if (error == 0) {
+        for (int t = 0; t < threads; t++) {
+            ranges[t].ops = ops;
+            ranges[t].fd = file->fd;
+            ranges[t].data = file->data;
+            ranges[t].begin = offset + (size - offset) / threads * t;
+            ranges[t].end = (t == threads - 1) ? size : offset + (size - offset) / threads * (t + 1);
+            ranges[t].state = states + (size_t)t * ops->state_size;
+        }
+        if (threads == 1) {
+            chunkscan_range_thread(&ranges[0]);
+        } else {
+            /* Не вдалося створити потік — діапазон сканується тут же */
+            for (int t = 0; t < threads; t++) {
+                ranges[t].threaded =
+                    pthread_create(&ids[t], NULL, chunkscan_range_thread, &ranges[t]) == 0;
+                if (!ranges[t].threaded) {
+                    chunkscan_range_thread(&ranges[t]);
+                }
+            }
+            for (int t = 0; t < threads; t++) {
+                if (ranges[t].threaded) {
+                    pthread_join(ids[t], NULL);
+                }
+            }
+        }
+        for (int t = 0; t < threads; t++) {
+            if (ranges[t].error != 0 && error == 0) {
+                error = ranges[t].error;
+            }
+            ops->merge(result, ranges[t].state);
+        }
+    }
+
+    free(ids);
+    free(states);
+    free(ranges);
+    if (error != 0) {
+        errno = error;
+        return -1;
+    }
+    return 0;
+}
+
+static inline int chunkscan_mapped(MappedFile* file, const ChunkScanOps* ops, int threads, void* result) {
+    return chunkscan_mapped_from(file, ops, threads, 0, result);
+}
+
+static inline int chunkscan_file(const char* path, const ChunkScanOps* ops, int threads, void* result) {
+    MappedFile file;
+    if (mapped_file_open(&file, path) != 0) {
+        return -1;
+    }
+    int rc = chunkscan_mapped(&file, ops, threads, result);
+    int saved = errno;
+    mapped_file_close(&file);
+    errno = saved;
+    return rc;
+}
+
+#endif
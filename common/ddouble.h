@@ -0,0 +1,120 @@
+#ifndef DDOUBLE_H
+#define DDOUBLE_H
+
+/*
+ * Арифметика double-double: значення hi + lo, де |lo| ≤ ulp(hi)/2, дає
+ * ~106 біт мантиси (≈32 десяткові цифри) на звичайних double.
+ * Побудована на безпомилкових перетвореннях: TwoSum для суми і FMA
+ * (або розщеплення Деккера без -mfma) для добутку. Гілок немає, тож
+ * кілька незалежних акумуляторів векторизуються.
+ *
+ * DD_HAVE_FLOAT128 визначено, якщо компілятор підтримує __float128
+ * (GCC/Clang на x86-64); libquadmath не потрібна.
+ *
+ * Заголовок придатний і для C (lab1), і для C++ (lab5).
+ */
+
+#include <math.h>
+
+#ifdef __SIZEOF_FLOAT128__
+#define DD_HAVE_FLOAT128 1
+#endif
+
+typedef struct {
+    double hi;
+    double lo;
+} ddouble;
+
+/* π²/6 з точністю double-double — еталон для ряду 1/i² */
+#define DD_ZETA2_HI 1.6449340668482264
+#define DD_ZETA2_LO 3.040672350398476e-17
+
+static inline ddouble dd_make(double hi, double lo) {
+    ddouble r;
+    r.hi = hi;
+    r.lo = lo;
+    return r;
+}
+
+/* a + b = s + *err точно */
+static inline double dd_two_sum(double a, double b, double* err) {
+    double s = a + b;
+    double bb = s - a;
+    *err = (a - (s - bb)) + (b - bb);
+    return s;
+}
+
+/* Те саме за умови |a| ≥ |b| */
+static inline double dd_fast_two_sum(double a, double b, double* err) {
+    double s = a + b;
+    *err = b - (s - a);
+    return s;
+}
+
+/* a · b = p + *err точно */
+static inline double dd_two_prod(double a, double b, double* err) {
+    double p = a * b;
+#ifdef __FMA__
+    *err = fma(a, b, -p);
+#else
+    const double split = 134217729.0; /* 2^27 + 1 */
+    double ta = split * a, tb = split * b;
+    double ah = ta - (ta - a), al = a - ah;
+    double bh = tb - (tb - b), bl = b - bh;
+    *err = ((ah * bh - p) + ah * bl + al * bh) + al * bl;
+#endif
+    return p;
+}
+
+/* Додавання доданка double-double до суми одного знаку з нею
+ * (дешевший варіант без другого TwoSum для молодших частин) */
+static inline ddouble dd_accumulate(ddouble s, ddouble x) {
+    double e;
+    double h = dd_two_sum(s.hi, x.hi, &e);
+    e += s.lo + x.lo;
+    h = dd_fast_two_sum(h, e, &e);
+    return dd_make(h, e);
+}
+
+/* Повне додавання double-double */
+static inline ddouble dd_add(ddouble a, ddouble b) {
+    double e1, e2;
+    double h = dd_two_sum(a.hi, b.hi, &e1);
+    double l = dd_two_sum(a.lo, b.lo, &e2);
+    e1 += l;
+    h = dd_fast_two_sum(h, e1, &e1);
+    e1 += e2;
+    h = dd_fast_two_sum(h, e1, &e1);
+    return dd_make(h, e1);
+}
+
+static inline ddouble dd_sub(ddouble a, ddouble b) {
+    return dd_add(a, dd_make(-b.hi, -b.lo));
+}
+
+/* 1 / (a.hi + a.lo) з точністю double-double: один крок Ньютона
+ * за точно обчисленим залишком 1 - q·a */
+static inline ddouble dd_reciprocal(ddouble a) {
+    double q = 1.0 / a.hi;
+    double pe;
+    double p = dd_two_prod(q, a.hi, &pe);
+    double r = ((1.0 - p) - pe) - q * a.lo;
+    double lo;
+    double hi = dd_fast_two_sum(q, r * q, &lo);
+    return dd_make(hi, lo);
+}
+
+/* Попарна сума values[0..count) у double-double */
+static inline ddouble dd_pairwise_sum(const ddouble* values, long long count) {
+    if (count <= 8) {
+        ddouble sum = dd_make(0.0, 0.0);
+        for (long long i = 0; i < count; i++) {
+            sum = dd_add(sum, values[i]);
+        }
+        return sum;
+    }
+    long long half = count / 2;
+    return dd_add(dd_pairwise_sum(values, half), dd_pairwise_sum(values + half, count - half));
+}
+
+#endif
@@ -0,0 +1,412 @@
+#ifndef DECOMPRESS_H
+#define DECOMPRESS_H
+
+/*
+ * Розпакування стисненого входу окремим потоком конвеєра.
+ *
+ * Формат визначається за сигнатурою перших байтів (gzip — 1f 8b, zstd —
+ * 28 b5 2f fd), а не за розширенням. Потік-розпаковувач читає стиснені
+ * байти (з відображення чи через read()) і заповнює кільце з
+ * DECOMPRESS_RING блоків по DECOMPRESS_BLOCK байтів; споживач забирає
+ * блоки по черзі (decompress_next()) і сканує їх на місці, без
+ * копіювання. Кільце обмежене: якщо споживач відстає, розпаковувач
+ * чекає, тож пам'ять не росте з розміром файлу, а розпакування
+ * перекривається з розбором.
+ *
+ * Кілька gzip-членів поспіль (cat a.gz b.gz) і кілька кадрів zstd
+ * розпаковуються як один потік, як це робить gzip -d.
+ *
+ * Обидва формати вмикаються явно, щоб збірка без додаткових бібліотек
+ * лишалася робочою: gzip — -DDECOMPRESS_ZLIB=1 і -lz, zstd —
+ * -DDECOMPRESS_ZSTD=1 і -lzstd; makefile у lab1-lab4 вмикають gzip
+ * завжди, а zstd — якщо pkg-config знаходить libzstd. Формат, не
+ * ввімкнений у збірці, дає помилку ENOTSUP, а не сміття в статистиці.
+ *
+ * Заголовок придатний і для C (lab1), і для C++ (lab2-lab4).
+ */
+
+#include <errno.h>
+#include <pthread.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "trace.h"
+
+#ifndef DECOMPRESS_ZLIB
+#define DECOMPRESS_ZLIB 0
+#endif
+#ifndef DECOMPRESS_ZSTD
+#define DECOMPRESS_ZSTD 0
+#endif
+
+#if DECOMPRESS_ZLIB
+#include <zlib.h>
+#endif
+#if DECOMPRESS_ZSTD
+#include <zstd.h>
+#endif
+
+#define DECOMPRESS_BLOCK (1 << 20)
+#define DECOMPRESS_RING 4
+#define DECOMPRESS_INPUT (256 << 10)
+#define DECOMPRESS_MAGIC_LEN 4
+
+typedef enum {
+    DECOMPRESS_NONE,
+    DECOMPRESS_GZIP,
+    DECOMPRESS_ZSTD_FORMAT
+} DecompressFormat;
+
+typedef struct {
+    DecompressFormat format;
+    /* Стиснений вхід: спершу input[0..input_len) (відображення чи вже
+     * прочитані байти), далі read(fd), якщо fd >= 0 */
+    const unsigned char* input;
+    size_t input_len;
+    int fd;
+    unsigned char* own_input;       /* буфер для read() і копії префікса */
+
+    unsigned char* blocks[DECOMPRESS_RING];
+    size_t len[DECOMPRESS_RING];
+    unsigned long long produced;    /* заповнених блоків */
+    unsigned long long consumed;    /* повернених у кільце */
+    int finished;                   /* більше блоків не буде */
+    int error;
+    int stop;                       /* споживач закрив потік */
+    pthread_mutex_t mutex;
+    pthread_cond_t changed;
+    pthread_t thread;
+
+    int holding;                    /* споживач тримає блок consumed */
+    size_t pos;                     /* прочитано з утримуваного блоку */
+} DecompressStream;
+
+/* Формат за першими байтами; коротший за сигнатуру вхід — не стиснений */
+static inline DecompressFormat decompress_format(const unsigned char* data, size_t len) {
+    if (len >= 2 && data[0] == 0x1f && data[1] == 0x8b) {
+        return DECOMPRESS_GZIP;
+    }
+    if (len >= 4 && data[0] == 0x28 && data[1] == 0xb5 && data[2] == 0x2f && data[3] == 0xfd) {
+        return DECOMPRESS_ZSTD_FORMAT;
+    }
+    return DECOMPRESS_NONE;
+}
+
+static inline int decompress_supported(DecompressFormat format) {
+    return (format == DECOMPRESS_GZIP && DECOMPRESS_ZLIB) ||
+           (format == DECOMPRESS_ZSTD_FORMAT && DECOMPRESS_ZSTD);
+}
+
+/* Наступна порція стисненого входу в s->input; 0 — кінець, -1 — помилка */
+static inline int decompress_refill(DecompressStream* s) {
+    if (s->fd < 0) {
+        return 0;
+    }
+    for (;;) {
+        ssize_t got = read(s->fd, s->own_input, DECOMPRESS_INPUT);
+        if (got < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            s->error = errno;
+            return -1;
+        }
+        if (got == 0) {
+            s->fd = -1;
+            return 0;
+        }
+        s->input = s->own_input;
+        s->input_len = (size_t)got;
+        return 1;
+    }
+}
+
+/* Вільний блок кільця, або -1, якщо споживач закрив потік */
+static inline int decompress_wait_free(DecompressStream* s) {
+    pthread_mutex_lock(&s->mutex);
+    while (s->produced - s->consumed == DECOMPRESS_RING && !s->stop) {
+        pthread_cond_wait(&s->changed, &s->mutex);
+    }
+    int index = s->stop ? -1 : (int)(s->produced % DECOMPRESS_RING);
+    pthread_mutex_unlock(&s->mutex);
+    return index;
+}
+
+static inline void decompress_publish(DecompressStream* s, int index, size_t len) {
+    pthread_mutex_lock(&s->mutex);
+    s->len[index] = len;
+    s->produced++;
+    pthread_cond_broadcast(&s->changed);
+    pthread_mutex_unlock(&s->mutex);
+}
+
+#if DECOMPRESS_ZLIB
+static inline void decompress_run_gzip(DecompressStream* s) {
+    z_stream z;
+    memset(&z, 0, sizeof(z));
+    if (inflateInit2(&z, 15 + 16) != Z_OK) {
+        s->error = ENOMEM;
+        return;
+    }
+    int index = decompress_wait_free(s);
+    size_t filled = 0;
+    int more = 1;
+    while (index >= 0 && more) {
+        if (s->input_len == 0) {
+            int rc = decompress_refill(s);
+            if (rc <= 0) {
+                /* Обірваний член gzip — помилка; кінець після цілого члена — ні */
+                if (rc == 0 && z.total_in > 0) {
+                    s->error = EBADMSG;
+                }
+                break;
+            }
+        }
+        /* zlib приймає лише uInt за раз */
+        size_t chunk = s->input_len < (1u << 30) ? s->input_len : (1u << 30);
+        z.next_in = (Bytef*)s->input;
+        z.avail_in = (uInt)chunk;
+        z.next_out = s->blocks[index] + filled;
+        z.avail_out = (uInt)(DECOMPRESS_BLOCK - filled);
+        int rc = inflate(&z, Z_NO_FLUSH);
+        size_t used = chunk - z.avail_in;
+        s->input += used;
+        s->input_len -= used;
+        filled = DECOMPRESS_BLOCK - z.avail_out;
+        if (rc == Z_STREAM_END) {
+            /* Наступний член починається з сигнатури; решта — хвіст, який
+             * gzip -d теж пропускає */
+            if (s->input_len == 0 && decompress_refill(s) <= 0) {
+                more = 0;
+            } else if (decompress_format(s->input, s->input_len) == DECOMPRESS_GZIP) {
+                inflateReset(&z);
+            } else {
+                more = 0;
+            }
+        } else if (rc != Z_OK && rc != Z_BUF_ERROR) {
+            s->error = rc == Z_MEM_ERROR ? ENOMEM : EBADMSG;
+            break;
+        }
+        if (filled == DECOMPRESS_BLOCK || (!more && filled > 0)) {
+            decompress_publish(s, index, filled);
+            filled = 0;
+            if (more) {
+                index = decompress_wait_free(s);
+            }
+        }
+    }
+    if (index >= 0 && filled > 0) {  /* і те, що встигло розпакуватися до помилки */
+        decompress_publish(s, index, filled);
+    }
+    inflateEnd(&z);
+}
+#endif
+
+#if DECOMPRESS_ZSTD
+static inline void decompress_run_zstd(DecompressStream* s) {
+    ZSTD_DCtx* z = ZSTD_createDCtx();
+    if (z == NULL) {
+        s->error = ENOMEM;
+        return;
+    }
+    int index = decompress_wait_free(s);
+    size_t filled = 0;
+    size_t pending = 0;             /* > 0 — кадр ще не завершено */
+    while (index >= 0) {
+        if (s->input_len == 0) {
+            int rc = decompress_refill(s);
+            if (rc <= 0) {
+                if (rc == 0 && pending != 0) {
+                    s->error = EBADMSG;
+                }
+                break;
+            }
+        }
+        ZSTD_inBuffer in = { s->input, s->input_len, 0 };
+        ZSTD_outBuffer out = { s->blocks[index], DECOMPRESS_BLOCK, filled };
+        pending = ZSTD_decompressStream(z, &out, &in);
+        if (ZSTD_isError(pending)) {
+            s->error = EBADMSG;
+            break;
+        }
+        s->input += in.pos;
+        s->input_len -= in.pos;
+        filled = out.pos;
+        if (filled == DECOMPRESS_BLOCK) {
+            decompress_publish(s, index, filled);
+            filled = 0;
+            index = decompress_wait_free(s);
+        }
+    }
+    if (index >= 0 && filled > 0) {  /* і те, що встигло розпакуватися до помилки */
+        decompress_publish(s, index, filled);
+    }
+    ZSTD_freeDCtx(z);
+}
+#endif
+
+static inline void* decompress_thread(void* arg) {
+    DecompressStream* s = (DecompressStream*)arg;
+    uint64_t trace_start = trace_begin();
+#if DECOMPRESS_ZLIB
+    if (s->format == DECOMPRESS_GZIP) {
+        decompress_run_gzip(s);
+    }
+#endif
+#if DECOMPRESS_ZSTD
+    if (s->format == DECOMPRESS_ZSTD_FORMAT) {
+        decompress_run_zstd(s);
+    }
+#endif
+    pthread_mutex_lock(&s->mutex);
+    s->finished = 1;
+    pthread_cond_broadcast(&s->changed);
+    pthread_mutex_unlock(&s->mutex);
+    trace_end_detail("decompress", trace_start, NULL, TRACE_NO_ARG);
+    return NULL;
+}
+
+static inline void decompress_free_buffers(DecompressStream* s) {
+    for (int i = 0; i < DECOMPRESS_RING; i++) {
+        free(s->blocks[i]);
+    }
+    free(s->own_input);
+}
+
+/* Запускає розпаковувач. input — початок стисненого входу (лишається
+ * живим до decompress_stop(); короткий префікс копіюється), далі —
+ * read(fd), якщо fd >= 0. 0 — успіх, -1 — помилка з errno (ENOTSUP —
+ * формат не ввімкнено у збірці) */
+static inline int decompress_start(DecompressStream* s, DecompressFormat format,
+                                   const unsigned char* input, size_t input_len, int copy_input, int fd) {
+    memset(s, 0, sizeof(*s));
+    if (!decompress_supported(format)) {
+        errno = ENOTSUP;
+        return -1;
+    }
+    s->format = format;
+    s->fd = fd;
+    int failed = 0;
+    for (int i = 0; i < DECOMPRESS_RING; i++) {
+        s->blocks[i] = (unsigned char*)malloc(DECOMPRESS_BLOCK);
+        failed |= s->blocks[i] == NULL;
+    }
+    size_t own = fd >= 0 ? DECOMPRESS_INPUT : 0;
+    if (copy_input && input_len > own) {
+        own = input_len;
+    }
+    if (own > 0) {
+        s->own_input = (unsigned char*)malloc(own);
+        failed |= s->own_input == NULL;
+    }
+    if (failed) {
+        decompress_free_buffers(s);
+        errno = ENOMEM;
+        return -1;
+    }
+    if (copy_input && input_len > 0) {
+        memcpy(s->own_input, input, input_len);
+        input = s->own_input;
+    }
+    s->input = input;
+    s->input_len = input_len;
+
+    pthread_mutex_init(&s->mutex, NULL);
+    pthread_cond_init(&s->changed, NULL);
+    int rc = pthread_create(&s->thread, NULL, decompress_thread, s);
+    if (rc != 0) {
+        pthread_mutex_destroy(&s->mutex);
+        pthread_cond_destroy(&s->changed);
+        decompress_free_buffers(s);
+        errno = rc;
+        return -1;
+    }
+    return 0;
+}
+
+/* Наступні розпаковані байти на місці, у кільці: решта утримуваного
+ * блоку або наступний блок (попередній повертається розпаковувачу).
+ * Дійсні до наступного виклику. 1 — є, 0 — кінець, -1 — помилка з errno */
+static inline int decompress_next(DecompressStream* s, const unsigned char** data, size_t* len) {
+    pthread_mutex_lock(&s->mutex);
+    int index = (int)(s->consumed % DECOMPRESS_RING);
+    if (s->holding && s->pos < s->len[index]) {
+        pthread_mutex_unlock(&s->mutex);
+        *data = s->blocks[index] + s->pos;
+        *len = s->len[index] - s->pos;
+        s->pos = s->len[index];
+        return 1;
+    }
+    if (s->holding) {
+        s->consumed++;
+        s->holding = 0;
+        pthread_cond_broadcast(&s->changed);
+    }
+    while (s->produced == s->consumed && !s->finished) {
+        pthread_cond_wait(&s->changed, &s->mutex);
+    }
+    int ready = s->produced > s->consumed;
+    int error = s->error;
+    index = (int)(s->consumed % DECOMPRESS_RING);
+    size_t block_len = ready ? s->len[index] : 0;
+    if (ready) {
+        s->holding = 1;
+        s->pos = block_len;
+    }
+    pthread_mutex_unlock(&s->mutex);
+    if (ready) {
+        *data = s->blocks[index];
+        *len = block_len;
+        return 1;
+    }
+    if (error != 0) {
+        errno = error;
+        return -1;
+    }
+    return 0;
+}
+
+/* Копіює до len розпакованих байтів; кількість, 0 — кінець, -1 — помилка */
+static inline ssize_t decompress_read(DecompressStream* s, void* buffer, size_t len) {
+    size_t done = 0;
+    while (done < len) {
+        int index = (int)(s->consumed % DECOMPRESS_RING);
+        if (!s->holding || s->pos == s->len[index]) {
+            const unsigned char* data;
+            size_t got;
+            int rc = decompress_next(s, &data, &got);
+            if (rc < 0) {
+                return done > 0 ? (ssize_t)done : -1;
+            }
+            if (rc == 0) {
+                break;
+            }
+            s->pos -= got;  /* блок узято, але ще не прочитано */
+            continue;
+        }
+        size_t n = s->len[index] - s->pos;
+        if (n > len - done) {
+            n = len - done;
+        }
+        memcpy((unsigned char*)buffer + done, s->blocks[index] + s->pos, n);
+        s->pos += n;
+        done += n;
+    }
+    return (ssize_t)done;
+}
+
+/* Зупиняє розпаковувач (навіть не дочитаний до кінця) і звільняє буфери */
+static inline void decompress_stop(DecompressStream* s) {
+    pthread_mutex_lock(&s->mutex);
+    s->stop = 1;
+    pthread_cond_broadcast(&s->changed);
+    pthread_mutex_unlock(&s->mutex);
+    pthread_join(s->thread, NULL);
+    pthread_mutex_destroy(&s->mutex);
+    pthread_cond_destroy(&s->changed);
+    decompress_free_buffers(s);
+}
+
+#endif
@@ -0,0 +1,112 @@
+#ifndef FILETYPE_H
+#define FILETYPE_H
+
+/*
+ * Визначення типу файлу (текст чи числа) за першим блоком.
+ *
+ * Вибірка — перші FILETYPE_SAMPLE байтів, отримані mapped_file_peek(),
+ * тож окремого читання файлу немає: обробник потім сканує те саме
+ * відображення або продовжує той самий потік. Вибірка ділиться на токени
+ * за пробільними байтами; частка токенів, що цілком є числом за
+ * граматикою operator>>(double), визначає тип (числа — щонайменше
+ * половина), а впевненість — наскільки ця частка далека від 1/2:
+ * |2·частка − 1|. Токен, обрізаний кінцем неповної вибірки, не
+ * рахується.
+ *
+ * Якщо впевненість менша за FILETYPE_MIN_CONFIDENCE, вибірка
+ * збільшується у 8 разів (до FILETYPE_SAMPLE_MAX або кінця файлу), а
+ * далі рішення приймається за більшістю.
+ *
+ * Заголовок придатний і для C (lab1), і для C++ (lab2).
+ */
+
+#include "numscan.h"
+#include "textscan.h"
+
+#define FILETYPE_SAMPLE (64 << 10)
+#define FILETYPE_SAMPLE_MAX (4 << 20)
+#define FILETYPE_MIN_CONFIDENCE 0.5
+
+typedef enum {
+    FILETYPE_UNKNOWN = -1,  /* порожній файл */
+    FILETYPE_TEXT = 0,
+    FILETYPE_NUMBERS = 1
+} FileType;
+
+typedef struct {
+    FileType type;
+    double confidence;        /* 0 — навпіл, 1 — однозначно */
+    size_t sampled;           /* байтів у вибірці */
+    int complete;             /* вибірка — увесь файл */
+    unsigned long long tokens;
+    unsigned long long numeric;
+} FileTypeGuess;
+
+static inline void filetype_guess_sample(const unsigned char* data, size_t len, int complete, FileTypeGuess* g) {
+    g->sampled = len;
+    g->complete = complete;
+    g->tokens = 0;
+    g->numeric = 0;
+
+    size_t i = 0;
+    while (i < len) {
+        while (i < len && textscan_is_space(data[i])) {
+            i++;
+        }
+        size_t start = i;
+        while (i < len && !textscan_is_space(data[i])) {
+            i++;
+        }
+        if (i == start || (i == len && !complete)) {
+            break;
+        }
+        g->tokens++;
+        if (numscan_stream_span((const char*)data + start, i - start) == i - start) {
+            g->numeric++;
+        }
+    }
+
+    if (len == 0) {
+        g->type = FILETYPE_UNKNOWN;
+        g->confidence = complete ? 1.0 : 0.0;
+        return;
+    }
+    if (g->tokens == 0) {
+        /* самі пробіли або один обрізаний токен */
+        g->type = FILETYPE_TEXT;
+        g->confidence = complete ? 1.0 : 0.0;
+        return;
+    }
+    double ratio = (double)g->numeric / (double)g->tokens;
+    g->type = ratio >= 0.5 ? FILETYPE_NUMBERS : FILETYPE_TEXT;
+    g->confidence = ratio >= 0.5 ? 2.0 * ratio - 1.0 : 1.0 - 2.0 * ratio;
+}
+
+/* 0 — успіх, -1 — помилка читання з errno */
+static inline int filetype_detect(MappedFile* file, FileTypeGuess* g) {
+    size_t want = FILETYPE_SAMPLE;
+    for (;;) {
+        const unsigned char* data;
+        size_t got;
+        if (mapped_file_peek(file, want, &data, &got) != 0) {
+            return -1;
+        }
+        int complete = got < want || (file->regular && got == file->size);
+        filetype_guess_sample(data, got, complete, g);
+        if (complete || g->confidence >= FILETYPE_MIN_CONFIDENCE || want >= FILETYPE_SAMPLE_MAX) {
+            return 0;
+        }
+        want *= 8;
+    }
+}
+
+static inline const char* filetype_name(FileType type) {
+    switch (type) {
+    case FILETYPE_NUMBERS: return "числовий";
+    case FILETYPE_TEXT: return "текстовий";
+    case FILETYPE_UNKNOWN:
+    default: return "невідомий";
+    }
+}
+
+#endif
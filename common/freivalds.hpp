@@ -0,0 +1,140 @@
+#pragma once
+
+// Імовірнісна перевірка добутку матриць (алгоритм Фрейвалдса).
+// Замість повторного множення за O(n³) перевіряється C·r == A·(B·r)
+// для k випадкових векторів r, що коштує O(k·n²).
+//
+// Матриці передаються будь-якого типу з доступом m[i][j];
+// розміри передаються явно, бо кожна лабораторна має власний Matrix.
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+
+struct FreivaldsOptions {
+    int rounds = 3;            // кількість випадкових векторів
+    double rtol = 0.0;         // додатковий відносний допуск до |A|·|B|·|r|
+    double ulps = 2.0;         // множник для апріорної оцінки похибки заокруглення
+    uint64_t seed = 0x5eedf00dULL;
+};
+
+struct FreivaldsResult {
+    bool ok = true;
+    int rounds = 0;
+    size_t worst_row = 0;
+    double worst_diff = 0.0;   // |(C·r)_i - (A·B·r)_i| у найгіршому рядку
+    double worst_ratio = 0.0;  // worst_diff / допуск; > 1 означає помилку
+};
+
+namespace freivalds_detail {
+
+// y = M·x та ya = |M|·xa (оцінка для абсолютних значень)
+template <class M>
+void matvec(const M& m, size_t rows, size_t cols,
+            const std::vector<double>& x, const std::vector<double>& xa,
+            std::vector<double>& y, std::vector<double>& ya) {
+    y.assign(rows, 0.0);
+    ya.assign(rows, 0.0);
+    for (size_t i = 0; i < rows; ++i) {
+        double s = 0.0;
+        double sa = 0.0;
+        for (size_t j = 0; j < cols; ++j) {
+            double v = m[i][j];
+            s += v * x[j];
+            sa += std::fabs(v) * xa[j];
+        }
+        y[i] = s;
+        ya[i] = sa;
+    }
+}
+
+}
+
+// Перевіряє product == factors[0]·factors[1]·...·factors[k-1].
+// dims має k+1 елемент: factors[t] має розмір dims[t] x dims[t+1].
+template <class M, class P>
+FreivaldsResult freivalds_verify_chain(const std::vector<const M*>& factors,
+                                       const std::vector<size_t>& dims,
+                                       const P& product,
+                                       const FreivaldsOptions& opts = FreivaldsOptions()) {
+    FreivaldsResult result;
+    if (factors.empty() || dims.size() != factors.size() + 1) {
+        result.ok = false;
+        return result;
+    }
+
+    const size_t rows = dims.front();
+    const size_t cols = dims.back();
+
+    // Сумарна довжина скалярних добутків: похибка кожного множення
+    // обмежена γ_n·|A|·|B|, де γ_n ≈ n·u.
+    double inner = 0.0;
+    for (size_t t = 1; t + 1 < dims.size(); ++t) {
+        inner += static_cast<double>(dims[t]);
+    }
+    const double u = std::numeric_limits<double>::epsilon() / 2.0;
+    const double gamma_chain = opts.ulps * u * (inner + 2.0 * cols);
+    const double gamma_product = opts.ulps * u * cols;
+
+    std::mt19937_64 gen(opts.seed);
+    std::uniform_real_distribution<double> dist(1.0, 2.0);
+
+    std::vector<double> r(cols), ra(cols);
+    std::vector<double> x, xa, y, ya;
+    std::vector<double> cr, cra;
+
+    for (int round = 0; round < opts.rounds; ++round) {
+        // Неперервний розподіл зі знаком: взаємне скорочення похибок
+        // у різних стовпцях має нульову ймовірність.
+        for (size_t j = 0; j < cols; ++j) {
+            double v = dist(gen);
+            r[j] = (gen() & 1) ? v : -v;
+            ra[j] = v;
+        }
+
+        x = r;
+        xa = ra;
+        for (size_t t = factors.size(); t-- > 0;) {
+            freivalds_detail::matvec(*factors[t], dims[t], dims[t + 1], x, xa, y, ya);
+            x.swap(y);
+            xa.swap(ya);
+        }
+
+        freivalds_detail::matvec(product, rows, cols, r, ra, cr, cra);
+
+        for (size_t i = 0; i < rows; ++i) {
+            double diff = std::fabs(cr[i] - x[i]);
+            double tol = (gamma_chain + opts.rtol) * xa[i] + gamma_product * cra[i];
+            tol = std::max(tol, std::numeric_limits<double>::denorm_min());
+
+            double ratio = diff / tol;
+            if (!(ratio <= 1.0)) {
+                result.ok = false;
+            }
+            if (!(ratio <= result.worst_ratio)) {
+                result.worst_ratio = ratio;
+                result.worst_diff = diff;
+                result.worst_row = i;
+            }
+        }
+        result.rounds = round + 1;
+
+        if (!result.ok) {
+            break;
+        }
+    }
+
+    return result;
+}
+
+// Перевіряє C == A·B, де A має розмір m x n, B — n x p.
+template <class M, class P>
+FreivaldsResult freivalds_verify(const M& A, const M& B, const P& C,
+                                 size_t m, size_t n, size_t p,
+                                 const FreivaldsOptions& opts = FreivaldsOptions()) {
+    return freivalds_verify_chain<M, P>({&A, &B}, {m, n, p}, C, opts);
+}
@@ -0,0 +1,84 @@
+#!/usr/bin/env python3
+"""Генерує unicode_classes.h — класи символів поза ASCII для utf8class.h.
+
+Біти класів збігаються з TextClass у textclass.h:
+  ALPHA — категорії L*, DIGIT — Nd, SPACE — пробільні (str.isspace),
+  PUNCT — P* і S* (як ispunct для ASCII: графічні, не літери й не цифри),
+  MARK — лише P* (розділові знаки). NEWLINE поза ASCII не буває.
+
+Запуск: python3 gen_unicode_classes.py > unicode_classes.h
+"""
+
+import unicodedata
+
+ALPHA, DIGIT, SPACE, PUNCT, NEWLINE, MARK = (1 << i for i in range(6))
+
+
+def bits(cp):
+    ch = chr(cp)
+    cat = unicodedata.category(ch)
+    b = 0
+    if cat.startswith("L"):
+        b |= ALPHA
+    if cat == "Nd":
+        b |= DIGIT
+    if ch.isspace():
+        b |= SPACE
+    if cat.startswith("P"):
+        b |= PUNCT | MARK
+    if cat.startswith("S"):
+        b |= PUNCT
+    return b
+
+
+def main():
+    two_byte = [bits(cp) for cp in range(0x80, 0x800)]
+
+    ranges = []
+    for cp in range(0x800, 0x110000):
+        if 0xD800 <= cp <= 0xDFFF:
+            continue
+        b = bits(cp)
+        if ranges and ranges[-1][2] == b and ranges[-1][1] == cp - 1:
+            ranges[-1][1] = cp
+        else:
+            ranges.append([cp, cp, b])
+    ranges = [r for r in ranges if r[2] != 0]
+
+    out = []
+    out.append("#ifndef UNICODE_CLASSES_H")
+    out.append("#define UNICODE_CLASSES_H")
+    out.append("")
+    out.append("/*")
+    out.append(" * Класи символів Unicode %s поза ASCII (біти TextClass)." % unicodedata.unidata_version)
+    out.append(" * Згенеровано gen_unicode_classes.py, вручну не редагувати.")
+    out.append(" */")
+    out.append("")
+    out.append("#include <stdint.h>")
+    out.append("")
+    out.append("typedef struct {")
+    out.append("    uint32_t first;")
+    out.append("    uint32_t last;")
+    out.append("    unsigned char bits;")
+    out.append("} UnicodeClassRange;")
+    out.append("")
+    out.append("/* U+0080..U+07FF (двобайтові послідовності): напряму за кодом */")
+    out.append("static const unsigned char unicode_class_2byte[0x800 - 0x80] = {")
+    for i in range(0, len(two_byte), 16):
+        out.append("    " + ", ".join("%d" % b for b in two_byte[i:i + 16]) + ",")
+    out.append("};")
+    out.append("")
+    out.append("/* Від U+0800: відсортовані непорожні діапазони, решта — без класу */")
+    out.append("static const UnicodeClassRange unicode_class_ranges[] = {")
+    for i in range(0, len(ranges), 4):
+        out.append("    " + " ".join("{0x%04X, 0x%04X, %d}," % tuple(r) for r in ranges[i:i + 4]))
+    out.append("};")
+    out.append("")
+    out.append("#define UNICODE_CLASS_RANGES (sizeof(unicode_class_ranges) / sizeof(unicode_class_ranges[0]))")
+    out.append("")
+    out.append("#endif")
+    print("\n".join(out))
+
+
+if __name__ == "__main__":
+    main()
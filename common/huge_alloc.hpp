@@ -0,0 +1,217 @@
+#pragma once
+
+// Неперервний буфер для великих матриць на сторінках 2 МБ.
+// Спершу пробується MAP_HUGETLB (зарезервовані huge pages), потім
+// вирівняне анонімне відображення з madvise(MADV_HUGEPAGE) (THP),
+// інакше — звичайні сторінки 4 КБ. Отримане підкріплення можна дізнатися
+// через backing() та resident_huge_bytes().
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <utility>
+
+#include <sys/mman.h>
+
+#ifndef MAP_HUGE_SHIFT
+#define MAP_HUGE_SHIFT 26
+#endif
+#ifndef MAP_HUGE_2MB
+#define MAP_HUGE_2MB (21 << MAP_HUGE_SHIFT)
+#endif
+
+enum class PagePolicy {
+    Auto,   // великі сторінки для буферів від HUGE_PAGE_THRESHOLD
+    Small,  // лише 4 КБ (MADV_NOHUGEPAGE) — для порівняння
+    Huge    // великі сторінки незалежно від розміру
+};
+
+enum class PageBacking {
+    None,
+    Heap,             // звичайний malloc для малих буферів
+    Small4K,          // mmap зі сторінками 4 КБ
+    TransparentHuge,  // mmap + MADV_HUGEPAGE
+    HugeTLB           // mmap + MAP_HUGETLB
+};
+
+constexpr size_t HUGE_PAGE_SIZE = 2u << 20;
+constexpr size_t HUGE_PAGE_THRESHOLD = 4u << 20;
+
+inline const char* page_backing_name(PageBacking backing) {
+    switch (backing) {
+    case PageBacking::Heap: return "купа (malloc)";
+    case PageBacking::Small4K: return "сторінки 4 КБ";
+    case PageBacking::TransparentHuge: return "THP 2 МБ (madvise)";
+    case PageBacking::HugeTLB: return "hugetlb 2 МБ";
+    case PageBacking::None:
+    default: return "немає";
+    }
+}
+
+class HugeBuffer {
+public:
+    HugeBuffer() = default;
+
+    explicit HugeBuffer(size_t bytes, PagePolicy policy = PagePolicy::Auto) {
+        allocate(bytes, policy);
+    }
+
+    ~HugeBuffer() { release(); }
+
+    HugeBuffer(const HugeBuffer&) = delete;
+    HugeBuffer& operator=(const HugeBuffer&) = delete;
+
+    HugeBuffer(HugeBuffer&& other) noexcept { swap(other); }
+
+    HugeBuffer& operator=(HugeBuffer&& other) noexcept {
+        if (this != &other) {
+            release();
+            swap(other);
+        }
+        return *this;
+    }
+
+    template <class T>
+    T* as() { return static_cast<T*>(ptr_); }
+
+    template <class T>
+    const T* as() const { return static_cast<const T*>(ptr_); }
+
+    size_t size() const { return bytes_; }
+    PageBacking backing() const { return backing_; }
+
+    // Скільки байтів відображення фактично лежить на великих сторінках
+    // (AnonHugePages з /proc/self/smaps для THP; весь буфер для hugetlb).
+    size_t resident_huge_bytes() const {
+        if (backing_ == PageBacking::HugeTLB) {
+            return mapped_;
+        }
+        if (backing_ != PageBacking::TransparentHuge) {
+            return 0;
+        }
+
+        FILE* smaps = std::fopen("/proc/self/smaps", "r");
+        if (smaps == nullptr) {
+            return 0;
+        }
+        uintptr_t addr = reinterpret_cast<uintptr_t>(ptr_);
+        bool inside = false;
+        size_t huge_kb = 0;
+        char line[256];
+        while (std::fgets(line, sizeof(line), smaps) != nullptr) {
+            unsigned long start = 0, end = 0;
+            if (std::sscanf(line, "%lx-%lx ", &start, &end) == 2 && std::strchr(line, '-') != nullptr &&
+                std::strncmp(line, "AnonHugePages", 13) != 0) {
+                inside = (start <= addr && addr < end);
+                continue;
+            }
+            if (inside && std::sscanf(line, "AnonHugePages: %zu kB", &huge_kb) == 1) {
+                break;
+            }
+        }
+        std::fclose(smaps);
+        size_t bytes = huge_kb * 1024;
+        return bytes < mapped_ ? bytes : mapped_;
+    }
+
+private:
+    void allocate(size_t bytes, PagePolicy policy) {
+        bytes_ = bytes;
+        if (bytes == 0) {
+            return;
+        }
+
+        bool want_huge = policy == PagePolicy::Huge ||
+                         (policy == PagePolicy::Auto && bytes >= HUGE_PAGE_THRESHOLD);
+
+        if (!want_huge && policy == PagePolicy::Auto) {
+            ptr_ = std::calloc(1, bytes);
+            if (ptr_ != nullptr) {
+                backing_ = PageBacking::Heap;
+                return;
+            }
+        }
+
+        if (want_huge) {
+            size_t rounded = (bytes + HUGE_PAGE_SIZE - 1) / HUGE_PAGE_SIZE * HUGE_PAGE_SIZE;
+
+            void* p = mmap(nullptr, rounded, PROT_READ | PROT_WRITE,
+                           MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB | MAP_HUGE_2MB, -1, 0);
+            if (p != MAP_FAILED) {
+                ptr_ = p;
+                mapped_ = rounded;
+                backing_ = PageBacking::HugeTLB;
+                return;
+            }
+
+            // Вирівнювання на 2 МБ, інакше ядро не зможе скласти великі сторінки
+            size_t over = rounded + HUGE_PAGE_SIZE;
+            p = mmap(nullptr, over, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (p != MAP_FAILED) {
+                uintptr_t raw = reinterpret_cast<uintptr_t>(p);
+                uintptr_t aligned = (raw + HUGE_PAGE_SIZE - 1) & ~(uintptr_t)(HUGE_PAGE_SIZE - 1);
+                size_t head = aligned - raw;
+                size_t tail = over - head - rounded;
+                if (head > 0) {
+                    munmap(p, head);
+                }
+                if (tail > 0) {
+                    munmap(reinterpret_cast<void*>(aligned + rounded), tail);
+                }
+                ptr_ = reinterpret_cast<void*>(aligned);
+                mapped_ = rounded;
+#ifdef MADV_HUGEPAGE
+                if (madvise(ptr_, mapped_, MADV_HUGEPAGE) == 0) {
+                    backing_ = PageBacking::TransparentHuge;
+                    return;
+                }
+#endif
+                backing_ = PageBacking::Small4K;
+                return;
+            }
+        }
+
+        size_t rounded = (bytes + 4095) / 4096 * 4096;
+        void* p = mmap(nullptr, rounded, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (p == MAP_FAILED) {
+            bytes_ = 0;
+            throw std::bad_alloc();
+        }
+#ifdef MADV_NOHUGEPAGE
+        madvise(p, rounded, MADV_NOHUGEPAGE);
+#endif
+        ptr_ = p;
+        mapped_ = rounded;
+        backing_ = PageBacking::Small4K;
+    }
+
+    void release() {
+        if (ptr_ == nullptr) {
+            return;
+        }
+        if (backing_ == PageBacking::Heap) {
+            std::free(ptr_);
+        } else {
+            munmap(ptr_, mapped_);
+        }
+        ptr_ = nullptr;
+        bytes_ = 0;
+        mapped_ = 0;
+        backing_ = PageBacking::None;
+    }
+
+    void swap(HugeBuffer& other) noexcept {
+        std::swap(ptr_, other.ptr_);
+        std::swap(bytes_, other.bytes_);
+        std::swap(mapped_, other.mapped_);
+        std::swap(backing_, other.backing_);
+    }
+
+    void* ptr_ = nullptr;
+    size_t bytes_ = 0;
+    size_t mapped_ = 0;
+    PageBacking backing_ = PageBacking::None;
+};
@@ -0,0 +1,129 @@
+#pragma once
+
+// Вхідний потік для завантажувачів матриць (Matrix::loadFromFile).
+//
+// Замість std::ifstream: файл відкривається через mapped_file.h, тож
+// звичайний файл читається прямо з відображення, без копіювання у буфер
+// потоку, а стиснений (gzip, zstd — за сигнатурою, decompress.h)
+// розпаковується окремим потоком. Розпаковані блоки з кільця стають
+// областю читання std::streambuf як є, і operator>> розбирає числа, поки
+// розпаковувач уже готує наступні блоки.
+//
+// Помилка розпакування (обірваний чи пошкоджений файл) виглядає для
+// розбору як кінець даних; error() повертає її errno. Тому завантажувач
+// після розбору викликає finish(): той дочитує хвіст (контрольна сума
+// gzip і кінець кадру zstd перевіряються лише там) і повертає помилку.
+
+#include <cerrno>
+#include <istream>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+#include "mapped_file.h"
+
+class InputFileBuf : public std::streambuf {
+public:
+    InputFileBuf() : open_(false), error_(0) {}
+    ~InputFileBuf() override { close(); }
+
+    InputFileBuf(const InputFileBuf&) = delete;
+    InputFileBuf& operator=(const InputFileBuf&) = delete;
+
+    bool open(const std::string& path) {
+        close();
+        if (mapped_file_open(&file_, path.c_str()) != 0) {
+            error_ = errno;
+            return false;
+        }
+        open_ = true;
+        if (file_.decoder == nullptr && file_.mapped) {
+            expose(file_.data, file_.size);
+        } else {
+            // Байти, які mapped_file_open() уже прочитав із каналу
+            expose(file_.head, file_.head_len);
+        }
+        return true;
+    }
+
+    void close() {
+        if (open_) {
+            mapped_file_close(&file_);
+            open_ = false;
+        }
+        setg(nullptr, nullptr, nullptr);
+    }
+
+    bool is_open() const { return open_; }
+    int error() const { return error_; }
+
+    // Пропускає решту даних; 0 — файл прочитано до кінця без помилок
+    int finish() {
+        while (open_ && !traits_type::eq_int_type(underflow(), traits_type::eof())) {
+            setg(eback(), egptr(), egptr());
+        }
+        return error_;
+    }
+
+protected:
+    int_type underflow() override {
+        if (gptr() < egptr()) {
+            return traits_type::to_int_type(*gptr());
+        }
+        if (!open_ || (file_.mapped && file_.decoder == nullptr)) {
+            return traits_type::eof();
+        }
+        if (file_.decoder != nullptr) {
+            const unsigned char* data;
+            size_t len;
+            int rc = decompress_next(file_.decoder, &data, &len);
+            if (rc <= 0) {
+                error_ = rc < 0 ? errno : 0;
+                return traits_type::eof();
+            }
+            expose(data, len);
+        } else {
+            buffer_.resize(DECOMPRESS_BLOCK);
+            ssize_t got;
+            do {
+                got = read(file_.fd, buffer_.data(), buffer_.size());
+            } while (got < 0 && errno == EINTR);
+            if (got <= 0) {
+                error_ = got < 0 ? errno : 0;
+                return traits_type::eof();
+            }
+            expose(buffer_.data(), static_cast<size_t>(got));
+        }
+        return traits_type::to_int_type(*gptr());
+    }
+
+private:
+    // Область читання лише читається: putback за межі не записує
+    void expose(const unsigned char* data, size_t len) {
+        char* begin = const_cast<char*>(reinterpret_cast<const char*>(data));
+        setg(begin, begin, begin + len);
+    }
+
+    MappedFile file_;
+    bool open_;
+    int error_;
+    std::vector<unsigned char> buffer_;
+};
+
+class InputFile : public std::istream {
+public:
+    explicit InputFile(const std::string& path) : std::istream(nullptr) {
+        init(&buf_);
+        if (!buf_.open(path)) {
+            setstate(std::ios::failbit);
+        }
+    }
+
+    bool is_open() const { return buf_.is_open(); }
+    int error() const { return buf_.error(); }
+    int finish() { return buf_.finish(); }
+    void close() { buf_.close(); }
+
+private:
+    InputFileBuf buf_;
+};
@@ -0,0 +1,195 @@
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+/*
+ * Файл, відображений у пам'ять лише для читання.
+ *
+ * Звичайний непорожній файл відображається цілком з порадою
+ * MADV_SEQUENTIAL (ядро читає наперед і звільняє прочитані сторінки), і
+ * статистика сканує байти на місці, без копіювання у буфер. Канали,
+ * пристрої та файли, які не вдалося відобразити, лишаються відкритими
+ * дескрипторами (mapped == 0) — їх читають потоково через read().
+ * Шлях "-" — стандартний ввід (копія дескриптора 0): перенаправлений
+ * файл теж відображається, канал читається потоково.
+ *
+ * Стиснений файл (gzip, zstd — за сигнатурою, decompress.h) відкривається
+ * як канал: regular == 0, а байти дає потік-розпаковувач (decoder).
+ * Сам стиснений файл при цьому відображається чи читається як завжди.
+ *
+ * mapped_file_peek() дає перші байти файлу, не витрачаючи окремого
+ * проходу: для відображення це просто вказівник, а з каналу байти
+ * читаються у буфер head, і потоковий читач (chunkscan.h) спершу віддає
+ * їх, а вже потім продовжує read().
+ *
+ * Заголовок придатний і для C (lab1), і для C++ (lab2).
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "decompress.h"
+
+typedef struct {
+    int fd;
+    int mapped;                 /* 1 — data вказує на відображення */
+    int regular;                /* звичайний файл, size відомий заздалегідь */
+    const unsigned char* data;
+    size_t size;
+    unsigned char* head;        /* уже прочитані з каналу байти */
+    size_t head_len;
+    int eof;                    /* канал прочитано до кінця */
+    DecompressStream* decoder;  /* стиснений вхід, або NULL */
+} MappedFile;
+
+static inline int mapped_file_peek(MappedFile* f, size_t want, const unsigned char** data, size_t* got);
+static inline void mapped_file_close(MappedFile* f);
+
+/* Стиснений вхід — запускає розпаковувач; 0 — успіх (або не стиснений),
+ * -1 — помилка з errno */
+static inline int mapped_file_decoder(MappedFile* f) {
+    unsigned char magic[DECOMPRESS_MAGIC_LEN];
+    const unsigned char* head;
+    size_t len;
+    if (f->mapped) {
+        head = f->data;
+        len = f->size < DECOMPRESS_MAGIC_LEN ? f->size : DECOMPRESS_MAGIC_LEN;
+    } else if (f->regular) {
+        ssize_t n = pread(f->fd, magic, DECOMPRESS_MAGIC_LEN, 0);
+        head = magic;
+        len = n > 0 ? (size_t)n : 0;
+    } else if (mapped_file_peek(f, DECOMPRESS_MAGIC_LEN, &head, &len) != 0) {
+        return -1;
+    }
+    DecompressFormat format = decompress_format(head, len);
+    if (format == DECOMPRESS_NONE) {
+        return 0;
+    }
+
+    DecompressStream* decoder = (DecompressStream*)malloc(sizeof(DecompressStream));
+    if (decoder == NULL) {
+        errno = ENOMEM;
+        return -1;
+    }
+    /* Відображення — увесь вхід; інакше вже прочитані байти, далі read() */
+    int rc = f->mapped ? decompress_start(decoder, format, f->data, f->size, 0, -1)
+                       : decompress_start(decoder, format, f->head, f->head_len, 1, f->eof ? -1 : f->fd);
+    if (rc != 0) {
+        free(decoder);
+        return -1;
+    }
+    f->decoder = decoder;
+    f->regular = 0;
+    f->head_len = 0;
+    f->eof = 0;
+    return 0;
+}
+
+/* 0 — успіх, -1 — помилка з errno */
+static inline int mapped_file_open(MappedFile* f, const char* path) {
+    f->fd = strcmp(path, "-") == 0 ? dup(STDIN_FILENO) : open(path, O_RDONLY);
+    f->mapped = 0;
+    f->regular = 0;
+    f->data = NULL;
+    f->size = 0;
+    f->head = NULL;
+    f->head_len = 0;
+    f->eof = 0;
+    f->decoder = NULL;
+    if (f->fd < 0) {
+        return -1;
+    }
+    struct stat st;
+    if (fstat(f->fd, &st) != 0) {
+        int saved = errno;
+        close(f->fd);
+        f->fd = -1;
+        errno = saved;
+        return -1;
+    }
+    if (S_ISREG(st.st_mode)) {
+        f->regular = 1;
+        f->size = (size_t)st.st_size;
+    }
+    if (f->size > 0) {
+        void* p = mmap(NULL, f->size, PROT_READ, MAP_PRIVATE, f->fd, 0);
+        if (p != MAP_FAILED) { /* інакше лишається read() */
+            madvise(p, f->size, MADV_SEQUENTIAL);
+            f->data = (const unsigned char*)p;
+            f->mapped = 1;
+        }
+    }
+    if (mapped_file_decoder(f) != 0) {
+        int saved = errno;
+        mapped_file_close(f);
+        errno = saved;
+        return -1;
+    }
+    return 0;
+}
+
+/* Перші min(want, розмір) байтів файлу у *data, їх кількість у *got.
+ * Повторний виклик з більшим want дочитує. 0 — успіх, -1 — помилка з errno. */
+static inline int mapped_file_peek(MappedFile* f, size_t want, const unsigned char** data, size_t* got) {
+    if (f->decoder == NULL && (f->mapped || (f->regular && f->size == 0))) {
+        *data = f->data;
+        *got = want < f->size ? want : f->size;
+        return 0;
+    }
+    if (f->head_len < want && !f->eof) {
+        unsigned char* grown = (unsigned char*)realloc(f->head, want);
+        if (grown == NULL) {
+            errno = ENOMEM;
+            return -1;
+        }
+        f->head = grown;
+        while (f->head_len < want) {
+            ssize_t n = f->decoder != NULL
+                ? decompress_read(f->decoder, f->head + f->head_len, want - f->head_len)
+                : f->regular
+                ? pread(f->fd, f->head + f->head_len, want - f->head_len, (off_t)f->head_len)
+                : read(f->fd, f->head + f->head_len, want - f->head_len);
+            if (n < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                return -1;
+            }
+            if (n == 0) {
+                f->eof = 1;
+                break;
+            }
+            f->head_len += (size_t)n;
+        }
+    }
+    *data = f->head;
+    *got = want < f->head_len ? want : f->head_len;
+    return 0;
+}
+
+static inline void mapped_file_close(MappedFile* f) {
+    if (f->decoder != NULL) {
+        decompress_stop(f->decoder);
+        free(f->decoder);
+        f->decoder = NULL;
+    }
+    if (f->mapped) {
+        munmap((void*)f->data, f->size);
+    }
+    if (f->fd >= 0) {
+        close(f->fd);
+    }
+    free(f->head);
+    f->head = NULL;
+    f->head_len = 0;
+    f->fd = -1;
+    f->mapped = 0;
+    f->data = NULL;
+}
+
+#endif
@@ -0,0 +1,103 @@
+#pragma once
+
+// Варіанти ядра множення матриць для діапазону рядків.
+// Матриці — будь-якого типу з доступом m[i][j]. Усі варіанти додають
+// доданки A[i][k]*B[k][j] у порядку зростання k, тому результати
+// побітово збігаються з наївним ijk-множенням.
+
+#include <algorithm>
+#include <cstddef>
+#include <string>
+
+enum class MatmulKernel {
+    Naive,      // i-j-k: стовпець B читається з кроком у рядок
+    RowStream,  // i-k-j: рядки B та C читаються послідовно
+    Tiled       // i-k-j плитками tile x tile по k та j
+};
+
+struct MatmulConfig {
+    size_t threads = 1;
+    size_t tile = 64;
+    MatmulKernel kernel = MatmulKernel::Naive;
+};
+
+inline const char* matmul_kernel_name(MatmulKernel kernel) {
+    switch (kernel) {
+    case MatmulKernel::RowStream: return "rowstream";
+    case MatmulKernel::Tiled: return "tiled";
+    case MatmulKernel::Naive:
+    default: return "naive";
+    }
+}
+
+inline bool matmul_kernel_parse(const std::string& name, MatmulKernel& kernel) {
+    if (name == "naive") {
+        kernel = MatmulKernel::Naive;
+    } else if (name == "rowstream") {
+        kernel = MatmulKernel::RowStream;
+    } else if (name == "tiled") {
+        kernel = MatmulKernel::Tiled;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+// C[rowBegin..rowEnd) = A[rowBegin..rowEnd) · B, де A має n стовпців, B — p стовпців.
+template <class MA, class MB, class MC>
+void matmul_rows(const MA& A, const MB& B, MC& C, size_t n, size_t p,
+                 size_t rowBegin, size_t rowEnd, MatmulKernel kernel, size_t tile) {
+    if (kernel == MatmulKernel::Naive) {
+        for (size_t i = rowBegin; i < rowEnd; ++i) {
+            for (size_t j = 0; j < p; ++j) {
+                double sum = 0.0;
+                for (size_t k = 0; k < n; ++k) {
+                    sum += A[i][k] * B[k][j];
+                }
+                C[i][j] = sum;
+            }
+        }
+        return;
+    }
+
+    for (size_t i = rowBegin; i < rowEnd; ++i) {
+        auto&& Ci = C[i];
+        for (size_t j = 0; j < p; ++j) {
+            Ci[j] = 0.0;
+        }
+    }
+
+    if (kernel == MatmulKernel::RowStream) {
+        for (size_t i = rowBegin; i < rowEnd; ++i) {
+            auto&& Ci = C[i];
+            const auto& Ai = A[i];
+            for (size_t k = 0; k < n; ++k) {
+                const double a = Ai[k];
+                const auto& Bk = B[k];
+                for (size_t j = 0; j < p; ++j) {
+                    Ci[j] += a * Bk[j];
+                }
+            }
+        }
+        return;
+    }
+
+    tile = std::max<size_t>(tile, 8);
+    for (size_t jj = 0; jj < p; jj += tile) {
+        const size_t jEnd = std::min(p, jj + tile);
+        for (size_t kk = 0; kk < n; kk += tile) {
+            const size_t kEnd = std::min(n, kk + tile);
+            for (size_t i = rowBegin; i < rowEnd; ++i) {
+                auto&& Ci = C[i];
+                const auto& Ai = A[i];
+                for (size_t k = kk; k < kEnd; ++k) {
+                    const double a = Ai[k];
+                    const auto& Bk = B[k];
+                    for (size_t j = jj; j < jEnd; ++j) {
+                        Ci[j] += a * Bk[j];
+                    }
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,285 @@
+#pragma once
+
+// Відтворюваний генератор синтетичних матриць.
+// Значення елемента (i, j) залежить лише від seed та лінійного індексу
+// i*cols + j (лічильниковий ГВЧ Philox4x32-10), тому результат однаковий
+// за будь-якої кількості потоків і порядку обходу плиток.
+
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+enum class MatrixDistribution {
+    Uniform,    // рівномірний на [a, b)
+    Normal,     // нормальний: середнє a, стандартне відхилення b
+    IntRange    // цілі числа з [a, b]
+};
+
+enum class MatrixFileFormat {
+    Text,           // лише рядки значень (lab5_2)
+    TextRowsCols,   // перший рядок "rows cols" (lab2, lab4)
+    TextSquare,     // перший рядок "n" (lab3)
+    Binary          // "PLMX", версія u32, rows u64, cols u64, далі double по рядках
+};
+
+struct MatrixGenOptions {
+    uint64_t seed = 42;
+    MatrixDistribution distribution = MatrixDistribution::Uniform;
+    double a = 0.0;
+    double b = 10.0;
+    double density = 1.0;      // частка ненульових елементів (розріджені матриці)
+    unsigned threads = 0;      // 0 — hardware_concurrency
+};
+
+namespace matrix_gen_detail {
+
+constexpr size_t TILE_ROWS = 64;
+
+struct Philox4x32 {
+    uint32_t v[4];
+};
+
+inline Philox4x32 philox4x32_10(uint64_t counter, uint32_t stream, uint64_t key) {
+    uint32_t c0 = static_cast<uint32_t>(counter);
+    uint32_t c1 = static_cast<uint32_t>(counter >> 32);
+    uint32_t c2 = stream;
+    uint32_t c3 = 0;
+    uint32_t k0 = static_cast<uint32_t>(key);
+    uint32_t k1 = static_cast<uint32_t>(key >> 32);
+
+    for (int round = 0; round < 10; ++round) {
+        uint64_t p0 = static_cast<uint64_t>(0xD2511F53u) * c0;
+        uint64_t p1 = static_cast<uint64_t>(0xCD9E8D57u) * c2;
+        uint32_t n0 = static_cast<uint32_t>(p1 >> 32) ^ c1 ^ k0;
+        uint32_t n2 = static_cast<uint32_t>(p0 >> 32) ^ c3 ^ k1;
+        c1 = static_cast<uint32_t>(p1);
+        c3 = static_cast<uint32_t>(p0);
+        c0 = n0;
+        c2 = n2;
+        k0 += 0x9E3779B9u;
+        k1 += 0xBB67AE85u;
+    }
+    return {{c0, c1, c2, c3}};
+}
+
+// 53 випадкові біти -> [0, 1)
+inline double to_unit(uint32_t hi, uint32_t lo) {
+    uint64_t bits = (static_cast<uint64_t>(hi) << 32 | lo) >> 11;
+    return static_cast<double>(bits) * 0x1.0p-53;
+}
+
+inline unsigned resolve_threads(unsigned threads) {
+    if (threads == 0) {
+        threads = std::thread::hardware_concurrency();
+    }
+    return std::max(1u, threads);
+}
+
+// Виконує fn(tile) для кожної плитки рядків; плитки розбираються
+// потоками через атомарний лічильник.
+template <class Fn>
+void for_each_tile(size_t tiles, unsigned threads, Fn fn) {
+    threads = static_cast<unsigned>(std::min<size_t>(threads, std::max<size_t>(tiles, 1)));
+    std::atomic<size_t> next(0);
+    auto worker = [&]() {
+        for (size_t t = next.fetch_add(1); t < tiles; t = next.fetch_add(1)) {
+            fn(t);
+        }
+    };
+
+    std::vector<std::thread> pool;
+    for (unsigned t = 1; t < threads; ++t) {
+        pool.emplace_back(worker);
+    }
+    worker();
+    for (auto& th : pool) {
+        th.join();
+    }
+}
+
+}
+
+// Значення елемента з лінійним індексом index.
+inline double matrix_gen_value(const MatrixGenOptions& opts, uint64_t index) {
+    using namespace matrix_gen_detail;
+
+    Philox4x32 r = philox4x32_10(index, 0, opts.seed);
+
+    if (opts.density < 1.0) {
+        Philox4x32 mask = philox4x32_10(index, 1, opts.seed);
+        if (to_unit(mask.v[0], mask.v[1]) >= opts.density) {
+            return 0.0;
+        }
+    }
+
+    switch (opts.distribution) {
+    case MatrixDistribution::Normal: {
+        // Бокс–Мюллер; u1 у (0, 1], щоб уникнути log(0)
+        double u1 = 1.0 - to_unit(r.v[0], r.v[1]);
+        double u2 = to_unit(r.v[2], r.v[3]);
+        return opts.a + opts.b * std::sqrt(-2.0 * std::log(u1)) * std::cos(2.0 * M_PI * u2);
+    }
+    case MatrixDistribution::IntRange: {
+        double lo = std::ceil(opts.a);
+        double span = std::floor(opts.b) - lo + 1.0;
+        if (span <= 0.0) {
+            return lo;
+        }
+        return lo + std::floor(to_unit(r.v[0], r.v[1]) * span);
+    }
+    case MatrixDistribution::Uniform:
+    default:
+        return opts.a + (opts.b - opts.a) * to_unit(r.v[0], r.v[1]);
+    }
+}
+
+// Заповнює матрицю з доступом m[i][j] паралельно, плитками по рядках.
+template <class M>
+void matrix_generate(M& m, size_t rows, size_t cols, const MatrixGenOptions& opts) {
+    using namespace matrix_gen_detail;
+
+    size_t tiles = (rows + TILE_ROWS - 1) / TILE_ROWS;
+    for_each_tile(tiles, resolve_threads(opts.threads), [&](size_t tile) {
+        size_t end = std::min(rows, (tile + 1) * TILE_ROWS);
+        for (size_t i = tile * TILE_ROWS; i < end; ++i) {
+            for (size_t j = 0; j < cols; ++j) {
+                m[i][j] = matrix_gen_value(opts, static_cast<uint64_t>(i) * cols + j);
+            }
+        }
+    });
+}
+
+namespace matrix_gen_detail {
+
+// Пише у файл матрицю, елемент (i, j) якої дає value(i, j).
+// Текст форматується плитками паралельно і пишеться у порядку рядків;
+// бінарний формат пишеться кожним потоком за власним зміщенням.
+template <class Value>
+void write_file(const std::string& filename, size_t rows, size_t cols, unsigned threads,
+                MatrixFileFormat format, Value value) {
+    int fd = open(filename.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        throw std::runtime_error("Неможливо створити файл: " + filename);
+    }
+
+    // Виключення з робочих потоків не кидаються: помилка лише запам'ятовується
+    std::atomic<bool> failed(false);
+    auto write_all = [&](const char* p, size_t n, off_t offset) {
+        while (n > 0 && !failed.load(std::memory_order_relaxed)) {
+            ssize_t w = pwrite(fd, p, n, offset);
+            if (w <= 0) {
+                failed = true;
+                return;
+            }
+            p += w;
+            n -= static_cast<size_t>(w);
+            offset += w;
+        }
+    };
+    auto finish = [&]() {
+        if (close(fd) != 0) {
+            failed = true;
+        }
+        if (failed) {
+            throw std::runtime_error("Помилка запису у файл: " + filename);
+        }
+    };
+
+    threads = resolve_threads(threads);
+    size_t tiles = (rows + TILE_ROWS - 1) / TILE_ROWS;
+
+    if (format == MatrixFileFormat::Binary) {
+        const size_t header_size = 4 + 4 + 8 + 8;
+        char header[header_size] = {'P', 'L', 'M', 'X'};
+        uint32_t version = 1;
+        uint64_t r64 = rows;
+        uint64_t c64 = cols;
+        std::copy_n(reinterpret_cast<const char*>(&version), 4, header + 4);
+        std::copy_n(reinterpret_cast<const char*>(&r64), 8, header + 8);
+        std::copy_n(reinterpret_cast<const char*>(&c64), 8, header + 16);
+        write_all(header, header_size, 0);
+
+        for_each_tile(tiles, threads, [&](size_t tile) {
+            size_t begin = tile * TILE_ROWS;
+            size_t end = std::min(rows, begin + TILE_ROWS);
+            std::vector<double> block((end - begin) * cols);
+            for (size_t i = begin; i < end; ++i) {
+                for (size_t j = 0; j < cols; ++j) {
+                    block[(i - begin) * cols + j] = value(i, j);
+                }
+            }
+            off_t offset = static_cast<off_t>(header_size + begin * cols * sizeof(double));
+            write_all(reinterpret_cast<const char*>(block.data()), block.size() * sizeof(double), offset);
+        });
+
+        finish();
+        return;
+    }
+
+    std::string header;
+    if (format == MatrixFileFormat::TextRowsCols) {
+        header = std::to_string(rows) + " " + std::to_string(cols) + "\n";
+    } else if (format == MatrixFileFormat::TextSquare) {
+        header = std::to_string(rows) + "\n";
+    }
+    off_t offset = 0;
+    write_all(header.data(), header.size(), offset);
+    offset += static_cast<off_t>(header.size());
+
+    // Хвилями по кілька плиток на потік: пам'ять обмежена, порядок збережено
+    size_t wave = static_cast<size_t>(threads) * 4;
+    std::vector<std::string> texts(wave);
+    for (size_t first = 0; first < tiles; first += wave) {
+        size_t count = std::min(wave, tiles - first);
+        for_each_tile(count, threads, [&](size_t t) {
+            std::string& out = texts[t];
+            out.clear();
+            char buf[32];
+            size_t begin = (first + t) * TILE_ROWS;
+            size_t end = std::min(rows, begin + TILE_ROWS);
+            for (size_t i = begin; i < end; ++i) {
+                for (size_t j = 0; j < cols; ++j) {
+                    double v = value(i, j);
+                    auto res = std::to_chars(buf, buf + sizeof(buf), v);
+                    out.append(buf, res.ptr);
+                    out.push_back(j + 1 < cols ? ' ' : '\n');
+                }
+            }
+        });
+        for (size_t t = 0; t < count; ++t) {
+            write_all(texts[t].data(), texts[t].size(), offset);
+            offset += static_cast<off_t>(texts[t].size());
+        }
+    }
+
+    finish();
+}
+
+}
+
+// Генерує матрицю одразу у файл, не тримаючи її в пам'яті.
+inline void matrix_generate_to_file(const std::string& filename, size_t rows, size_t cols,
+                                    const MatrixGenOptions& opts, MatrixFileFormat format) {
+    matrix_gen_detail::write_file(filename, rows, cols, opts.threads, format, [&](size_t i, size_t j) {
+        return matrix_gen_value(opts, static_cast<uint64_t>(i) * cols + j);
+    });
+}
+
+// Записує вже згенеровану матрицю з доступом m[i][j] у тому ж форматі, що
+// й matrix_generate_to_file(): файл збігається, а значення не рахуються вдруге.
+template <class M>
+void matrix_write_to_file(const std::string& filename, const M& m, size_t rows, size_t cols,
+                          MatrixFileFormat format, unsigned threads = 0) {
+    matrix_gen_detail::write_file(filename, rows, cols, threads, format, [&](size_t i, size_t j) {
+        return static_cast<double>(m[i][j]);
+    });
+}
@@ -0,0 +1,475 @@
+#ifndef NUMSCAN_H
+#define NUMSCAN_H
+
+/*
+ * Статистика числового файлу, що зливається зі шматків (моноїд для
+ * chunkscan.h).
+ *
+ * Шматок розбирає лише цілі токени між своїми роздільниками; уривок до
+ * першого роздільника (head) і після останнього (tail) зберігається як
+ * текст і склеюється з сусіднім шматком під час злиття. Накопичувач файлу
+ * починається з numscan_init_file(), а numscan_finish() розбирає останній
+ * токен.
+ *
+ * Два режими, як у лабораторних:
+ *   NUMSCAN_SKIP_INVALID — роздільники " \t\n", кожен токен через strtod,
+ *     нечислові токени пропускаються (strtok + sscanf("%lf") у lab1_1);
+ *   NUMSCAN_STOP_AT_INVALID — роздільники isspace, токен розбирається
+ *     послідовно за граматикою operator>>(double); перше ж невдале
+ *     число зупиняє розбір файлу (цикл while (file >> number) у lab2_1).
+ *
+ * Токени довші за NUMSCAN_MAX_TOKEN байтів вважаються нечисловими.
+ *
+ * Стан O(1): сума, мінімум, максимум, лічильники знаків і середнє з
+ * сумою квадратів відхилень за Велфордом (дисперсія), які зливаються між
+ * шматками формулою Чана, а також скетч квантилів і гістограма за
+ * порядком величини (sketch.h) фіксованого розміру. Значення нікуди не
+ * зберігаються.
+ *
+ * Токен спершу розбирається швидким шляхом, що вимагає споживання всього
+ * токена: std::from_chars у C++17, а в C — точний шлях Клінгера (до 19
+ * цифр мантиси, |степінь десяти| <= 22, одне округлення). Усе інше
+ * (шістнадцяткові числа, inf/nan, довгі мантиси, префікс числа)
+ * розбирає strtod, як і раніше, тож значення побітово ті самі.
+ */
+
+#include <errno.h>
+#include <float.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__cplusplus) && defined(__has_include)
+#if __has_include(<charconv>)
+#include <charconv>
+#endif
+#endif
+
+#include "chunkscan.h"
+#include "sketch.h"
+
+#if defined(__cplusplus) && defined(__cpp_lib_to_chars)
+#define NUMSCAN_FROM_CHARS 1
+#else
+#define NUMSCAN_FROM_CHARS 0
+#endif
+
+#define NUMSCAN_MAX_TOKEN 512
+
+typedef enum {
+    NUMSCAN_SKIP_INVALID,
+    NUMSCAN_STOP_AT_INVALID
+} NumScanMode;
+
+typedef struct {
+    double sum;
+    double min;
+    double max;
+    unsigned long long count;
+    unsigned long long positive;
+    unsigned long long negative;
+    unsigned long long zero;
+    double mean;        /* Велфорд: середнє */
+    double m2;          /* і сума квадратів відхилень від нього */
+    QuantileSketch quantiles;
+    LogHistogram histogram;
+} NumberAccum;
+
+typedef struct {
+    char text[NUMSCAN_MAX_TOKEN];
+    size_t len;
+    int overflow;
+} NumScanFragment;
+
+typedef struct {
+    NumScanMode mode;
+    unsigned long long size;
+    NumberAccum acc;
+    int has_separator;
+    int stopped;
+    NumScanFragment head;  /* до першого роздільника (або весь шматок) */
+    NumScanFragment tail;  /* після останнього роздільника */
+} NumberChunk;
+
+static inline int numscan_is_separator(NumScanMode mode, unsigned char c) {
+    if (mode == NUMSCAN_SKIP_INVALID) {
+        return c == ' ' || c == '\t' || c == '\n';
+    }
+    return c == ' ' || c == '\t' || c == '\n' || c == '\v' || c == '\f' || c == '\r';
+}
+
+static inline void numscan_accum_init(NumberAccum* a) {
+    a->sum = 0.0;
+    a->min = DBL_MAX;
+    a->max = -DBL_MAX;
+    a->count = 0;
+    a->positive = 0;
+    a->negative = 0;
+    a->zero = 0;
+    a->mean = 0.0;
+    a->m2 = 0.0;
+    qsketch_init(&a->quantiles);
+    loghist_init(&a->histogram);
+}
+
+static inline void numscan_accum_add(NumberAccum* a, double value) {
+    a->sum += value;
+    a->count++;
+    double delta = value - a->mean;
+    a->mean += delta / (double)a->count;
+    a->m2 += delta * (value - a->mean);
+    qsketch_add(&a->quantiles, value);
+    loghist_add(&a->histogram, value);
+    if (value > a->max) {
+        a->max = value;
+    }
+    if (value < a->min) {
+        a->min = value;
+    }
+    if (value > 0) {
+        a->positive++;
+    } else if (value < 0) {
+        a->negative++;
+    } else {
+        a->zero++;
+    }
+}
+
+static inline void numscan_accum_merge(NumberAccum* a, const NumberAccum* b) {
+    if (b->count > 0) {
+        double na = (double)a->count;
+        double nb = (double)b->count;
+        double n = na + nb;
+        double delta = b->mean - a->mean;
+        a->mean += delta * (nb / n);
+        a->m2 += b->m2 + delta * delta * (na * nb / n);
+    }
+    qsketch_merge(&a->quantiles, &b->quantiles);
+    loghist_merge(&a->histogram, &b->histogram);
+    a->sum += b->sum;
+    a->count += b->count;
+    a->positive += b->positive;
+    a->negative += b->negative;
+    a->zero += b->zero;
+    if (b->max > a->max) {
+        a->max = b->max;
+    }
+    if (b->min < a->min) {
+        a->min = b->min;
+    }
+}
+
+/* Вибіркова дисперсія (n - 1 у знаменнику); 0, якщо чисел менше двох */
+static inline double numscan_variance(const NumberAccum* a) {
+    return a->count > 1 ? a->m2 / (double)(a->count - 1) : 0.0;
+}
+
+static inline void numscan_fragment_append(NumScanFragment* f, const void* data, size_t len) {
+    if (f->overflow || f->len + len >= NUMSCAN_MAX_TOKEN) {
+        f->overflow = 1;
+        return;
+    }
+    memcpy(f->text + f->len, data, len);
+    f->len += len;
+}
+
+/* Довжина числа на початку s за граматикою operator>>(double):
+ * [+-] цифри [. цифри] [eE [+-] цифри]; 0, якщо в мантисі немає цифр */
+static inline size_t numscan_stream_span(const char* s, size_t len) {
+    size_t i = 0;
+    int digits = 0;
+    if (i < len && (s[i] == '+' || s[i] == '-')) {
+        i++;
+    }
+    while (i < len && s[i] >= '0' && s[i] <= '9') {
+        i++;
+        digits++;
+    }
+    if (i < len && s[i] == '.') {
+        i++;
+        while (i < len && s[i] >= '0' && s[i] <= '9') {
+            i++;
+            digits++;
+        }
+    }
+    if (digits == 0) {
+        return 0;
+    }
+    if (i < len && (s[i] == 'e' || s[i] == 'E')) {
+        i++;
+        if (i < len && (s[i] == '+' || s[i] == '-')) {
+            i++;
+        }
+        while (i < len && s[i] >= '0' && s[i] <= '9') {
+            i++;
+        }
+    }
+    return i;
+}
+
+/* Швидкий розбір s[0..len) цілком; 0 — треба звернутися до strtod */
+static inline int numscan_parse_exact(const char* s, size_t len, double* out) {
+    const char* p = s;
+    const char* end = s + len;
+    if (p < end && *p == '+') {
+        /* from_chars не приймає '+', а "+-1" не є числом для strtod */
+        p++;
+        if (p == end || !((*p >= '0' && *p <= '9') || *p == '.')) {
+            return 0;
+        }
+    }
+#if NUMSCAN_FROM_CHARS
+    std::from_chars_result r = std::from_chars(p, end, *out);
+    return r.ec == std::errc() && r.ptr == end;
+#else
+    static const double powers[] = {
+        1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+    };
+    int negative = 0;
+    if (p < end && *p == '-') {
+        negative = 1;
+        p++;
+    }
+    unsigned long long mantissa = 0;
+    int digits = 0;
+    int significant = 0;
+    int exponent = 0;
+    while (p < end && *p >= '0' && *p <= '9') {
+        if (significant > 0 || *p != '0') {
+            significant++;
+        }
+        mantissa = mantissa * 10 + (unsigned long long)(*p - '0');
+        digits++;
+        p++;
+        if (significant > 19) {
+            return 0;
+        }
+    }
+    if (p < end && *p == '.') {
+        p++;
+        while (p < end && *p >= '0' && *p <= '9') {
+            if (significant > 0 || *p != '0') {
+                significant++;
+            }
+            mantissa = mantissa * 10 + (unsigned long long)(*p - '0');
+            digits++;
+            exponent--;
+            p++;
+            if (significant > 19) {
+                return 0;
+            }
+        }
+    }
+    if (digits == 0) {
+        return 0;
+    }
+    if (p < end && (*p == 'e' || *p == 'E')) {
+        p++;
+        int exp_negative = 0;
+        if (p < end && (*p == '+' || *p == '-')) {
+            exp_negative = *p == '-';
+            p++;
+        }
+        if (p == end) {
+            return 0;
+        }
+        int e = 0;
+        while (p < end && *p >= '0' && *p <= '9') {
+            if (e < 10000) {
+                e = e * 10 + (*p - '0');
+            }
+            p++;
+        }
+        exponent += exp_negative ? -e : e;
+    }
+    if (p != end || mantissa > (1ULL << 53) || exponent < -22 || exponent > 22 || FLT_EVAL_METHOD != 0) {
+        return 0;
+    }
+    double value = (double)mantissa;
+    value = exponent < 0 ? value / powers[-exponent] : value * powers[exponent];
+    *out = negative ? -value : value;
+    return 1;
+#endif
+}
+
+/* Розбирає один повний токен; у режимі зупинки може виставити stopped */
+static inline void numscan_token(NumberChunk* c, const char* token, size_t len, int overflow) {
+    if (len == 0 || c->stopped) {
+        return;
+    }
+    if (overflow) {
+        if (c->mode == NUMSCAN_STOP_AT_INVALID) {
+            c->stopped = 1;
+        }
+        return;
+    }
+
+    double value;
+    if (c->mode == NUMSCAN_SKIP_INVALID && numscan_parse_exact(token, len, &value)) {
+        numscan_accum_add(&c->acc, value);
+        return;
+    }
+
+    char buffer[NUMSCAN_MAX_TOKEN];
+    memcpy(buffer, token, len);
+    buffer[len] = '\0';
+
+    if (c->mode == NUMSCAN_SKIP_INVALID) {
+        char* end;
+        value = strtod(buffer, &end);
+        if (end != buffer) {
+            numscan_accum_add(&c->acc, value);
+        }
+        return;
+    }
+
+    size_t pos = 0;
+    while (pos < len) {
+        size_t span = numscan_stream_span(buffer + pos, len - pos);
+        if (span > 0 && numscan_parse_exact(buffer + pos, span, &value) && !isinf(value)) {
+            numscan_accum_add(&c->acc, value);
+            pos += span;
+            continue;
+        }
+        char saved = buffer[pos + span];
+        buffer[pos + span] = '\0';
+        char* end;
+        errno = 0;
+        value = span > 0 ? strtod(buffer + pos, &end) : 0.0;
+        buffer[pos + span] = saved;
+        /* як і в libstdc++: число має займати весь розібраний відрізок,
+         * переповнення до нескінченності — помилка */
+        if (span == 0 || end != buffer + pos + span || isinf(value)) {
+            c->stopped = 1;
+            return;
+        }
+        numscan_accum_add(&c->acc, value);
+        pos += span;
+    }
+}
+
+static inline void numscan_init(NumberChunk* c, NumScanMode mode) {
+    /* без memset: скетчі всередині acc великі, їм достатньо лічильників */
+    c->mode = mode;
+    c->size = 0;
+    c->has_separator = 0;
+    c->stopped = 0;
+    c->head.len = 0;
+    c->head.overflow = 0;
+    c->tail.len = 0;
+    c->tail.overflow = 0;
+    numscan_accum_init(&c->acc);
+}
+
+/* Накопичувач для файлу: початок файлу діє як роздільник */
+static inline void numscan_init_file(NumberChunk* c, NumScanMode mode) {
+    numscan_init(c, mode);
+    c->has_separator = 1;
+}
+
+static inline void numscan_bytes(NumberChunk* c, const unsigned char* data, size_t len) {
+    size_t first = 0;
+    while (first < len && !numscan_is_separator(c->mode, data[first])) {
+        first++;
+    }
+    c->size += len;
+    if (first == len) {
+        numscan_fragment_append(&c->head, data, len);
+        return;
+    }
+    numscan_fragment_append(&c->head, data, first);
+    c->has_separator = 1;
+
+    size_t i = first;
+    while (i < len) {
+        while (i < len && numscan_is_separator(c->mode, data[i])) {
+            i++;
+        }
+        size_t start = i;
+        while (i < len && !numscan_is_separator(c->mode, data[i])) {
+            i++;
+        }
+        if (i == len) {
+            numscan_fragment_append(&c->tail, data + start, i - start);
+            break;
+        }
+        numscan_token(c, (const char*)data + start, i - start, i - start >= NUMSCAN_MAX_TOKEN);
+    }
+}
+
+/* acc = acc · next */
+static inline void numscan_merge(NumberChunk* acc, const NumberChunk* next) {
+    if (next->size == 0 && !next->has_separator) {
+        return;
+    }
+    if (acc->size == 0 && !acc->has_separator) {
+        *acc = *next;
+        return;
+    }
+    acc->size += next->size;
+    if (acc->stopped) {
+        return;
+    }
+
+    if (!acc->has_separator) {
+        /* acc — усе ще уривок першого токена: він продовжується в next */
+        NumScanFragment head = acc->head;
+        numscan_fragment_append(&head, next->head.text, next->head.len);
+        head.overflow |= next->head.overflow;
+        unsigned long long size = acc->size;
+        *acc = *next;
+        acc->head = head;
+        acc->size = size;
+        return;
+    }
+
+    NumScanFragment* target = &acc->tail;
+    numscan_fragment_append(target, next->head.text, next->head.len);
+    target->overflow |= next->head.overflow;
+    if (!next->has_separator) {
+        return;
+    }
+
+    numscan_token(acc, acc->tail.text, acc->tail.len, acc->tail.overflow);
+    if (acc->stopped) {
+        return;
+    }
+    numscan_accum_merge(&acc->acc, &next->acc);
+    acc->stopped = next->stopped;
+    acc->tail = next->tail;
+}
+
+/* Кінець файлу: останній уривок — повний токен */
+static inline void numscan_finish(NumberChunk* c) {
+    if (c->has_separator) {
+        numscan_token(c, c->tail.text, c->tail.len, c->tail.overflow);
+        c->tail.len = 0;
+    }
+}
+
+static inline void numscan_op_init_skip(void* state) {
+    numscan_init((NumberChunk*)state, NUMSCAN_SKIP_INVALID);
+}
+
+static inline void numscan_op_init_stop(void* state) {
+    numscan_init((NumberChunk*)state, NUMSCAN_STOP_AT_INVALID);
+}
+
+static inline void numscan_op_scan(void* state, const unsigned char* data, size_t len) {
+    numscan_bytes((NumberChunk*)state, data, len);
+}
+
+static inline void numscan_op_merge(void* acc, const void* next) {
+    numscan_merge((NumberChunk*)acc, (const NumberChunk*)next);
+}
+
+static const ChunkScanOps numscan_skip_ops = {
+    sizeof(NumberChunk), numscan_op_init_skip, numscan_op_scan, numscan_op_merge
+};
+
+static const ChunkScanOps numscan_stop_ops = {
+    sizeof(NumberChunk), numscan_op_init_stop, numscan_op_scan, numscan_op_merge
+};
+
+#endif
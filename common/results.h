@@ -0,0 +1,353 @@
+#ifndef RESULTS_H
+#define RESULTS_H
+
+/*
+ * Впорядкований вивід результатів робочих потоків.
+ *
+ * Робочі потоки не друкують самі: кожен запис результату отримує номер
+ * ще тоді, коли завдання ставиться в чергу (results_reserve(), один
+ * потік-постачальник), а готовий запис публікується у слот кільця
+ * атомарним записом вказівника (results_publish(), без блокувань). Єдиний
+ * потік-писач забирає записи строго за номерами і передає їх у emit, тож
+ * порядок виводу детермінований (порядок постановки в чергу), а потоки
+ * не чекають один одного на stdout.
+ *
+ * Кільце має capacity слотів. Номер резервується лише тоді, коли запис
+ * з номером на capacity менше вже виведено (семафор вільних слотів),
+ * тож слот ніколи не перезаписується, а пам'ять під відкладені записи
+ * обмежена навіть тоді, коли перед ними застряг великий файл.
+ *
+ * Для машинного виводу тут же — запис JSON Lines і CSV: ключі й значення
+ * без локалізації, дійсні числа — найкоротший запис, що відтворює
+ * значення (або null / порожнє поле для NaN і нескінченностей).
+ *
+ * Заголовок придатний і для C (lab1), і для C++ (lab2).
+ */
+
+#include <errno.h>
+#include <math.h>
+#include <pthread.h>
+#include <semaphore.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef enum {
+    RESULT_FORMAT_TEXT,
+    RESULT_FORMAT_JSONL,
+    RESULT_FORMAT_CSV
+} ResultFormat;
+
+typedef struct {
+    void** slots;
+    unsigned long long capacity;
+    unsigned long long reserved;  /* лише постачальник номерів */
+    unsigned long long written;   /* лише писач */
+    unsigned long long total;     /* ULLONG_MAX, доки не закрито */
+    sem_t published;              /* будить писача */
+    sem_t free_slots;
+    void (*emit)(void* record, void* context);  /* забирає запис */
+    void* context;
+    pthread_t writer;
+} ResultSlots;
+
+static inline void results_sem_wait(sem_t* sem) {
+    while (sem_wait(sem) != 0 && errno == EINTR) {
+    }
+}
+
+static inline void* results_writer_thread(void* arg) {
+    ResultSlots* r = (ResultSlots*)arg;
+    for (;;) {
+        void** slot = &r->slots[r->written % r->capacity];
+        void* record = __atomic_load_n(slot, __ATOMIC_ACQUIRE);
+        if (record != NULL) {
+            __atomic_store_n(slot, NULL, __ATOMIC_RELAXED);
+            r->emit(record, r->context);
+            r->written++;
+            sem_post(&r->free_slots);
+            continue;
+        }
+        if (r->written == __atomic_load_n(&r->total, __ATOMIC_ACQUIRE)) {
+            return NULL;
+        }
+        /* публікація (чи закриття) після перевірки все одно розбудить */
+        results_sem_wait(&r->published);
+    }
+}
+
+/* Запускає потік-писач; 0 — успіх, -1 — помилка з errno */
+static inline int results_init(ResultSlots* r, unsigned long long capacity,
+                               void (*emit)(void* record, void* context), void* context) {
+    memset(r, 0, sizeof(*r));
+    r->capacity = capacity > 0 ? capacity : 1;
+    r->total = ~0ULL;
+    r->emit = emit;
+    r->context = context;
+    r->slots = (void**)calloc((size_t)r->capacity, sizeof(void*));
+    if (r->slots == NULL) {
+        errno = ENOMEM;
+        return -1;
+    }
+    sem_init(&r->published, 0, 0);
+    sem_init(&r->free_slots, 0, r->capacity < 0x7fffffffULL ? (unsigned)r->capacity : 0x7fffffffU);
+    int rc = pthread_create(&r->writer, NULL, results_writer_thread, r);
+    if (rc != 0) {
+        sem_destroy(&r->published);
+        sem_destroy(&r->free_slots);
+        free(r->slots);
+        errno = rc;
+        return -1;
+    }
+    return 0;
+}
+
+/* Номер наступного запису; чекає, поки звільниться слот. Викликає лише
+ * один потік, і кожен номер має бути опублікований */
+static inline unsigned long long results_reserve(ResultSlots* r) {
+    results_sem_wait(&r->free_slots);
+    return r->reserved++;
+}
+
+/* Будь-який потік; record != NULL */
+static inline void results_publish(ResultSlots* r, unsigned long long seq, void* record) {
+    __atomic_store_n(&r->slots[seq % r->capacity], record, __ATOMIC_RELEASE);
+    sem_post(&r->published);
+}
+
+/* Нових номерів не буде: чекає, поки писач виведе всі зарезервовані
+ * записи, і зупиняє його */
+static inline void results_close(ResultSlots* r) {
+    __atomic_store_n(&r->total, r->reserved, __ATOMIC_RELEASE);
+    sem_post(&r->published);
+    pthread_join(r->writer, NULL);
+    sem_destroy(&r->published);
+    sem_destroy(&r->free_slots);
+    free(r->slots);
+    r->slots = NULL;
+}
+
+/* "text", "jsonl" або "csv"; 0 — успіх, -1 — невідомий формат */
+static inline int result_format_parse(const char* name, ResultFormat* format) {
+    if (strcmp(name, "text") == 0) {
+        *format = RESULT_FORMAT_TEXT;
+    } else if (strcmp(name, "jsonl") == 0 || strcmp(name, "json") == 0) {
+        *format = RESULT_FORMAT_JSONL;
+    } else if (strcmp(name, "csv") == 0) {
+        *format = RESULT_FORMAT_CSV;
+    } else {
+        return -1;
+    }
+    return 0;
+}
+
+/* Найкоротший з %.15g..%.17g, що читається назад тим самим числом */
+static inline void result_format_real(char* buffer, size_t size, double value) {
+    for (int precision = 15; precision <= 17; precision++) {
+        snprintf(buffer, size, "%.*g", precision, value);
+        if (strtod(buffer, NULL) == value) {
+            return;
+        }
+    }
+}
+
+/* Об'єкт або масив JSON, що пишеться в потік поле за полем */
+typedef struct {
+    FILE* out;
+    int count;
+} ResultJson;
+
+/* Довжина коректної послідовності UTF-8 з s[0] (байт >= 128), або 0 */
+static inline size_t result_utf8_valid(const unsigned char* s, size_t avail) {
+    size_t n = s[0] >= 0xC2 && s[0] <= 0xDF ? 2 : s[0] >= 0xE0 && s[0] <= 0xEF ? 3 :
+               s[0] >= 0xF0 && s[0] <= 0xF4 ? 4 : 0;
+    if (n == 0 || avail < n) {
+        return 0;
+    }
+    unsigned cp = s[0] & (0x7F >> n);
+    for (size_t k = 1; k < n; k++) {
+        if ((s[k] & 0xC0) != 0x80) {
+            return 0;
+        }
+        cp = (cp << 6) | (s[k] & 0x3F);
+    }
+    if ((n == 3 && (cp < 0x800 || (cp >= 0xD800 && cp <= 0xDFFF))) ||
+        (n == 4 && (cp < 0x10000 || cp > 0x10FFFF))) {
+        return 0;
+    }
+    return n;
+}
+
+/* Рядок JSON; некоректні байти UTF-8 (шляхи, слова) стають U+FFFD */
+static inline void result_json_string(FILE* out, const char* s, size_t len) {
+    fputc('"', out);
+    for (size_t i = 0; i < len; i++) {
+        unsigned char c = (unsigned char)s[i];
+        if (c >= 0x80) {
+            size_t n = result_utf8_valid((const unsigned char*)s + i, len - i);
+            if (n == 0) {
+                fputs("\\ufffd", out);
+            } else {
+                fwrite(s + i, 1, n, out);
+                i += n - 1;
+            }
+        } else if (c == '"' || c == '\\') {
+            fputc('\\', out);
+            fputc(c, out);
+        } else if (c == '\n') {
+            fputs("\\n", out);
+        } else if (c == '\t') {
+            fputs("\\t", out);
+        } else if (c < 0x20 || c == 0x7f) {
+            fprintf(out, "\\u%04x", c);
+        } else {
+            fputc(c, out);
+        }
+    }
+    fputc('"', out);
+}
+
+static inline void result_json_begin(ResultJson* j, FILE* out) {
+    j->out = out;
+    j->count = 0;
+    fputc('{', out);
+}
+
+static inline void result_json_end(ResultJson* j) {
+    fputc('}', j->out);
+}
+
+static inline void result_json_begin_array(ResultJson* j, FILE* out) {
+    j->out = out;
+    j->count = 0;
+    fputc('[', out);
+}
+
+static inline void result_json_end_array(ResultJson* j) {
+    fputc(']', j->out);
+}
+
+/* Наступний елемент масиву */
+static inline void result_json_item(ResultJson* j) {
+    if (j->count++ > 0) {
+        fputc(',', j->out);
+    }
+}
+
+/* Ключ наступного поля об'єкта; значення пише викликач */
+static inline void result_json_key(ResultJson* j, const char* key) {
+    result_json_item(j);
+    result_json_string(j->out, key, strlen(key));
+    fputc(':', j->out);
+}
+
+static inline void result_json_text(ResultJson* j, const char* key, const char* s, size_t len) {
+    result_json_key(j, key);
+    result_json_string(j->out, s, len);
+}
+
+static inline void result_json_cstr(ResultJson* j, const char* key, const char* s) {
+    result_json_text(j, key, s, strlen(s));
+}
+
+static inline void result_json_int(ResultJson* j, const char* key, long long value) {
+    result_json_key(j, key);
+    fprintf(j->out, "%lld", value);
+}
+
+static inline void result_json_uint(ResultJson* j, const char* key, unsigned long long value) {
+    result_json_key(j, key);
+    fprintf(j->out, "%llu", value);
+}
+
+static inline void result_json_bool(ResultJson* j, const char* key, int value) {
+    result_json_key(j, key);
+    fputs(value ? "true" : "false", j->out);
+}
+
+static inline void result_json_real(ResultJson* j, const char* key, double value) {
+    result_json_key(j, key);
+    if (isfinite(value)) {
+        char buffer[32];
+        result_format_real(buffer, sizeof(buffer), value);
+        fputs(buffer, j->out);
+    } else {
+        fputs("null", j->out);
+    }
+}
+
+/* Рядок CSV (RFC 4180), що пишеться поле за полем */
+typedef struct {
+    FILE* out;
+    int count;
+} ResultCsv;
+
+static inline void result_csv_begin(ResultCsv* c, FILE* out) {
+    c->out = out;
+    c->count = 0;
+}
+
+static inline void result_csv_end(ResultCsv* c) {
+    fputc('\n', c->out);
+}
+
+static inline void result_csv_empty(ResultCsv* c) {
+    if (c->count++ > 0) {
+        fputc(',', c->out);
+    }
+}
+
+static inline void result_csv_text(ResultCsv* c, const char* s, size_t len) {
+    result_csv_empty(c);
+    size_t plain = 0;
+    while (plain < len && s[plain] != ',' && s[plain] != '"' && s[plain] != '\r' && s[plain] != '\n') {
+        plain++;
+    }
+    if (plain == len) {
+        fwrite(s, 1, len, c->out);
+        return;
+    }
+    fputc('"', c->out);
+    for (size_t i = 0; i < len; i++) {
+        if (s[i] == '"') {
+            fputc('"', c->out);
+        }
+        fputc(s[i], c->out);
+    }
+    fputc('"', c->out);
+}
+
+static inline void result_csv_cstr(ResultCsv* c, const char* s) {
+    result_csv_text(c, s, strlen(s));
+}
+
+/* Рядок заголовка з назв через кому */
+static inline void result_csv_header(FILE* out, const char* const* names, int count) {
+    ResultCsv c;
+    result_csv_begin(&c, out);
+    for (int i = 0; i < count; i++) {
+        result_csv_cstr(&c, names[i]);
+    }
+    result_csv_end(&c);
+}
+
+static inline void result_csv_int(ResultCsv* c, long long value) {
+    result_csv_empty(c);
+    fprintf(c->out, "%lld", value);
+}
+
+static inline void result_csv_uint(ResultCsv* c, unsigned long long value) {
+    result_csv_empty(c);
+    fprintf(c->out, "%llu", value);
+}
+
+static inline void result_csv_real(ResultCsv* c, double value) {
+    result_csv_empty(c);
+    if (isfinite(value)) {
+        char buffer[32];
+        result_format_real(buffer, sizeof(buffer), value);
+        fputs(buffer, c->out);
+    }
+}
+
+#endif
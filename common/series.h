@@ -0,0 +1,151 @@
+#ifndef SERIES_H
+#define SERIES_H
+
+/*
+ * Відтворювана паралельна сума ряду 1/i², однакова до біта за будь-якої
+ * кількості потоків і будь-якого розбиття роботи.
+ *
+ * Доданки 1..n діляться на блоки фіксованого розміру SERIES_BLOCK. Сума
+ * блоку залежить лише від його меж (чотири смуги з компенсацією Кехена),
+ * тож байдуже, який потік і в якому порядку її обчислив. Суми блоків
+ * записуються у масив за номером блоку і зводяться попарним деревом,
+ * форма якого залежить лише від кількості блоків.
+ *
+ * Результат не змінюється, доки компілятор не переставляє операції з
+ * плаваючою комою (без -ffast-math / -Ofast).
+ *
+ * series_inv_square_tail() додає хвіст ряду за Ейлером–Маклореном, тож
+ * точність 1e-12 досягається вже на десятках доданків замість ~1e12.
+ *
+ * Варіанти *_dd та *_quad рахують ті самі блоки у double-double або
+ * __float128 — для довгих сум, де округлення double перевищує похибку
+ * обриву ряду.
+ *
+ * Заголовок придатний і для C (lab1), і для C++ (lab5).
+ */
+
+#include <float.h>
+#include <math.h>
+#include <stddef.h>
+
+#include "ddouble.h"
+
+#define SERIES_BLOCK 8192LL
+
+/* Кількість блоків для доданків 1..n */
+static inline long long series_block_count(long long n) {
+    return n > 0 ? (n + SERIES_BLOCK - 1) / SERIES_BLOCK : 0;
+}
+
+/* Межі [first, last] блоку з номером block */
+static inline void series_block_range(long long block, long long n,
+                                      long long* first, long long* last) {
+    *first = block * SERIES_BLOCK + 1;
+    *last = *first + SERIES_BLOCK - 1;
+    if (*last > n) {
+        *last = n;
+    }
+}
+
+/* Один крок підсумовування Кехена: *c накопичує втрачені молодші біти */
+static inline void series_kahan_add(double* s, double* c, double x) {
+    double y = x - *c;
+    double t = *s + y;
+    *c = (t - *s) - y;
+    *s = t;
+}
+
+/* Сума 1/i² для i з [first, last]. Чотири незалежні смуги прибирають
+ * залежність між ітераціями, компенсація — похибку всередині смуги */
+static inline double series_inv_square_block(long long first, long long last) {
+    double s0 = 0.0, s1 = 0.0, s2 = 0.0, s3 = 0.0;
+    double c0 = 0.0, c1 = 0.0, c2 = 0.0, c3 = 0.0;
+    long long i = first;
+
+    for (; i + 3 <= last; i += 4) {
+        double d = (double)i;
+        series_kahan_add(&s0, &c0, 1.0 / (d * d));
+        series_kahan_add(&s1, &c1, 1.0 / ((d + 1.0) * (d + 1.0)));
+        series_kahan_add(&s2, &c2, 1.0 / ((d + 2.0) * (d + 2.0)));
+        series_kahan_add(&s3, &c3, 1.0 / ((d + 3.0) * (d + 3.0)));
+    }
+    for (; i <= last; i++) {
+        double d = (double)i;
+        series_kahan_add(&s0, &c0, 1.0 / (d * d));
+    }
+
+    return ((s0 + s1) + (s2 + s3)) - ((c0 + c1) + (c2 + c3));
+}
+
+/* Попарна сума values[0..count): поділ навпіл до відрізків по 8 */
+static inline double series_pairwise_sum(const double* values, long long count) {
+    if (count <= 8) {
+        double sum = 0.0;
+        for (long long i = 0; i < count; i++) {
+            sum += values[i];
+        }
+        return sum;
+    }
+    long long half = count / 2;
+    return series_pairwise_sum(values, half) + series_pairwise_sum(values + half, count - half);
+}
+
+/* 1/i² у double-double: квадрат точно через TwoProd, обернення з кроком Ньютона */
+static inline ddouble series_inv_square_dd(long long i) {
+    double d = (double)i;
+    double sq_err;
+    double sq = dd_two_prod(d, d, &sq_err);
+    return dd_reciprocal(dd_make(sq, sq_err));
+}
+
+/* Як series_inv_square_block, але чотири смуги накопичуються у double-double */
+static inline ddouble series_inv_square_block_dd(long long first, long long last) {
+    ddouble s0 = dd_make(0.0, 0.0), s1 = s0, s2 = s0, s3 = s0;
+    long long i = first;
+
+    for (; i + 3 <= last; i += 4) {
+        s0 = dd_accumulate(s0, series_inv_square_dd(i));
+        s1 = dd_accumulate(s1, series_inv_square_dd(i + 1));
+        s2 = dd_accumulate(s2, series_inv_square_dd(i + 2));
+        s3 = dd_accumulate(s3, series_inv_square_dd(i + 3));
+    }
+    for (; i <= last; i++) {
+        s0 = dd_accumulate(s0, series_inv_square_dd(i));
+    }
+
+    return dd_add(dd_add(s0, s1), dd_add(s2, s3));
+}
+
+#ifdef DD_HAVE_FLOAT128
+/* Програмна четверна точність: точніше за double-double, але в рази повільніше */
+static inline ddouble series_inv_square_block_quad(long long first, long long last) {
+    __float128 sum = 0;
+    for (long long i = first; i <= last; i++) {
+        __float128 d = (__float128)i;
+        sum += 1 / (d * d);
+    }
+    double hi = (double)sum;
+    return dd_make(hi, (double)(sum - hi));
+}
+#endif
+
+/* Оцінка похибки округлення суми n доданків: по eps на компенсовану суму
+ * блоку і на кожен рівень попарного дерева */
+static inline double series_rounding_error(double sum, long long n) {
+    double levels = log2((double)series_block_count(n) + 1.0);
+    return (2.0 + levels) * DBL_EPSILON * fabs(sum);
+}
+
+/* Хвіст Σ 1/i² для i > n за формулою Ейлера–Маклорена:
+ * 1/n - 1/(2n²) + 1/(6n³) - 1/(30n⁵) + 1/(42n⁷). У *error_bound —
+ * модуль першого відкинутого члена 1/(30n⁹) */
+static inline double series_inv_square_tail(long long n, double* error_bound) {
+    double x = 1.0 / (double)n;
+    double x2 = x * x;
+    if (error_bound != NULL) {
+        *error_bound = x2 * x2 * x2 * x2 * x / 30.0;
+    }
+    return x * (1.0 - x * (0.5 - x * (1.0 / 6.0 - x2 * (1.0 / 30.0 - x2 / 42.0))));
+}
+
+#endif
@@ -0,0 +1,249 @@
+#pragma once
+
+// Узагальнене паралельне обчислення рядів Σ term(i), i = 1..n.
+// Доданок задається функтором із членами:
+//   static constexpr bool alternating — знак (-1)^(i-1) перед доданком;
+//   double magnitude(long long i) const — модуль доданка.
+// Показник степеня і знак відомі під час компіляції, тож ядро блоку
+// не містить розгалужень і векторизується.
+//
+// Розбиття на блоки, компенсація Кехена та попарне зведення — ті самі,
+// що й у series.h, тому сума не залежить від кількості потоків і
+// бекенда, а ZetaTerm<2> дає побітово той самий результат, що й
+// series_inv_square_block().
+//
+// Для оцінки хвоста (series_evaluate_to_tolerance) функтор додатково має
+//   double derivative(int m, double x) const — m-та похідна модуля
+//   як неперервної функції (m = 0 — саме значення);
+//   double integral_tail(double x) const — ∫_x^∞ модуля, лише для
+//   рядів без чергування знаків.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <thread>
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include "series.h"
+
+// d^S для цілого S > 0 піднесенням квадратом під час компіляції
+template <int S>
+constexpr double series_ipow(double d) {
+    static_assert(S > 0, "показник має бути додатним");
+    if constexpr (S == 1) {
+        return d;
+    } else if constexpr (S % 2 == 0) {
+        return series_ipow<S / 2>(d) * series_ipow<S / 2>(d);
+    } else {
+        return d * series_ipow<S - 1>(d);
+    }
+}
+
+// m-та похідна c/(x - shift)^S: (-1)^m · c · S(S+1)…(S+m-1) / (x - shift)^(S+m)
+inline double series_power_derivative(int S, int m, double c, double shift, double x) {
+    double factor = c;
+    for (int k = 0; k < m; k++) {
+        factor *= -(double)(S + k);
+    }
+    return factor * std::pow(x - shift, -(double)(S + m));
+}
+
+// ζ(S) = Σ 1/i^S
+template <int S>
+struct ZetaTerm {
+    static constexpr bool alternating = false;
+    double magnitude(long long i) const {
+        return 1.0 / series_ipow<S>((double)i);
+    }
+    double derivative(int m, double x) const {
+        return series_power_derivative(S, m, 1.0, 0.0, x);
+    }
+    double integral_tail(double x) const {
+        static_assert(S > 1, "ζ(1) розбіжний");
+        return std::pow(x, 1.0 - S) / (S - 1);
+    }
+};
+
+// η(S) = Σ (-1)^(i-1)/i^S; η(1) = ln 2
+template <int S>
+struct EtaTerm {
+    static constexpr bool alternating = true;
+    double magnitude(long long i) const {
+        return 1.0 / series_ipow<S>((double)i);
+    }
+    double derivative(int m, double x) const {
+        return series_power_derivative(S, m, 1.0, 0.0, x);
+    }
+};
+
+// Ряд Лейбніца: π = Σ (-1)^(i-1) · 4/(2i-1) = Σ (-1)^(i-1) · 2/(i - 1/2)
+struct LeibnizTerm {
+    static constexpr bool alternating = true;
+    double magnitude(long long i) const {
+        return 4.0 / (2.0 * (double)i - 1.0);
+    }
+    double derivative(int m, double x) const {
+        return series_power_derivative(1, m, 2.0, 0.5, x);
+    }
+};
+
+enum class SeriesBackend {
+    Threads,  // std::thread (pthreads), блоки зі спільного лічильника
+    OpenMP    // omp parallel for schedule(dynamic); без -fopenmp — як Threads
+};
+
+inline const char* series_backend_name(SeriesBackend backend) {
+    return backend == SeriesBackend::OpenMP ? "openmp" : "threads";
+}
+
+struct SeriesResult {
+    double sum = 0.0;
+    long long terms = 0;
+    double timeMs = 0.0;
+    double termsPerSec = 0.0;
+};
+
+// Сума доданків [first, last]. first — початок блоку, тобто непарне, тож
+// смуги 0 і 2 завжди додатні, а 1 і 3 для знакозмінних рядів — від'ємні.
+template <class Term>
+double series_block_sum(const Term& term, long long first, long long last) {
+    constexpr double odd = Term::alternating ? -1.0 : 1.0;
+    double s0 = 0.0, s1 = 0.0, s2 = 0.0, s3 = 0.0;
+    double c0 = 0.0, c1 = 0.0, c2 = 0.0, c3 = 0.0;
+    long long i = first;
+
+    for (; i + 3 <= last; i += 4) {
+        series_kahan_add(&s0, &c0, term.magnitude(i));
+        series_kahan_add(&s1, &c1, odd * term.magnitude(i + 1));
+        series_kahan_add(&s2, &c2, term.magnitude(i + 2));
+        series_kahan_add(&s3, &c3, odd * term.magnitude(i + 3));
+    }
+    for (; i <= last; i++) {
+        series_kahan_add(&s0, &c0, ((i - first) % 2 == 0 ? 1.0 : odd) * term.magnitude(i));
+    }
+
+    return ((s0 + s1) + (s2 + s3)) - ((c0 + c1) + (c2 + c3));
+}
+
+template <class Term>
+SeriesResult series_evaluate(const Term& term, long long n, int threads,
+                             SeriesBackend backend = SeriesBackend::Threads) {
+    SeriesResult result;
+    result.terms = n;
+    const long long blocks = series_block_count(n);
+    std::vector<double> blockSums(blocks);
+    threads = std::max(1, threads);
+#ifndef _OPENMP
+    (void)backend;
+#endif
+
+    auto sumBlock = [&](long long b) {
+        long long first, last;
+        series_block_range(b, n, &first, &last);
+        blockSums[b] = series_block_sum(term, first, last);
+    };
+
+    auto start = std::chrono::steady_clock::now();
+
+#ifdef _OPENMP
+    if (backend == SeriesBackend::OpenMP) {
+        #pragma omp parallel for num_threads(threads) schedule(dynamic, 4)
+        for (long long b = 0; b < blocks; b++) {
+            sumBlock(b);
+        }
+    } else
+#endif
+    {
+        std::atomic<long long> nextBlock(0);
+        auto worker = [&]() {
+            for (long long b = nextBlock.fetch_add(1, std::memory_order_relaxed); b < blocks;
+                 b = nextBlock.fetch_add(1, std::memory_order_relaxed)) {
+                sumBlock(b);
+            }
+        };
+        std::vector<std::thread> pool;
+        for (int t = 1; t < threads; t++) {
+            pool.emplace_back(worker);
+        }
+        worker();
+        for (std::thread& th : pool) {
+            th.join();
+        }
+    }
+
+    result.sum = series_pairwise_sum(blockSums.data(), blocks);
+
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    result.timeMs = elapsed.count();
+    result.termsPerSec = result.timeMs > 0.0 ? n / (result.timeMs / 1000.0) : 0.0;
+    return result;
+}
+
+// Хвіст Σ_{i>n}. Без чергування знаків — формула Ейлера–Маклорена
+// (∫ - g/2 - g'/12 + g'''/720 - g⁽⁵⁾/30240), зі чергуванням — Ейлера–Буля
+// для a = n+1: (-1)^n (g/2 - g'/4 + g'''/48 - g⁽⁵⁾/480). У errorBound —
+// модуль першого відкинутого члена.
+template <class Term>
+double series_tail(const Term& term, long long n, double& errorBound) {
+    if constexpr (Term::alternating) {
+        const double a = (double)n + 1.0;
+        const double sign = (n % 2 == 0) ? 1.0 : -1.0;
+        errorBound = std::fabs(17.0 / 80640.0 * term.derivative(7, a));
+        return sign * (term.derivative(0, a) / 2.0 - term.derivative(1, a) / 4.0 +
+                       term.derivative(3, a) / 48.0 - term.derivative(5, a) / 480.0);
+    } else {
+        const double x = (double)n;
+        errorBound = std::fabs(term.derivative(7, x) / 1209600.0);
+        return term.integral_tail(x) - term.derivative(0, x) / 2.0 - term.derivative(1, x) / 12.0 +
+               term.derivative(3, x) / 720.0 - term.derivative(5, x) / 30240.0;
+    }
+}
+
+struct SeriesEstimate {
+    double value = 0.0;          // часткова сума + хвіст
+    double partialSum = 0.0;
+    double tail = 0.0;
+    double errorEstimate = 0.0;  // залишок формули хвоста + округлення
+    long long terms = 0;
+    int rounds = 0;
+    bool converged = false;
+    double timeMs = 0.0;
+};
+
+// Подвоює кількість доданків, починаючи з 16, доки залишок формули
+// хвоста не стане меншим за tolerance (або не досягнуто maxTerms).
+// converged — чи вклалась у tolerance і похибка округлення.
+template <class Term>
+SeriesEstimate series_evaluate_to_tolerance(const Term& term, double tolerance, int threads,
+                                            SeriesBackend backend = SeriesBackend::Threads,
+                                            long long maxTerms = 1LL << 40) {
+    SeriesEstimate est;
+    auto start = std::chrono::steady_clock::now();
+
+    for (long long n = 16;; n *= 2) {
+        n = std::min(n, maxTerms);
+        double tailError = 0.0;
+        est.partialSum = series_evaluate(term, n, threads, backend).sum;
+        est.tail = series_tail(term, n, tailError);
+        est.value = est.partialSum + est.tail;
+        est.errorEstimate = tailError + series_rounding_error(est.value, n);
+        est.terms = n;
+        est.rounds++;
+        if (tailError <= tolerance) {
+            est.converged = est.errorEstimate <= tolerance;
+            break;
+        }
+        if (n >= maxTerms) {
+            break;
+        }
+    }
+
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    est.timeMs = elapsed.count();
+    return est;
+}
@@ -0,0 +1,334 @@
+#ifndef SKETCH_H
+#define SKETCH_H
+
+/*
+ * Скетчі розподілу з обмеженою пам'яттю, що зливаються між потоками.
+ *
+ * QuantileSketch — варіант KLL з однаковою місткістю рівнів: рівень h
+ * зберігає до QSKETCH_K значень вагою 2^h. З заповненого відсортованого
+ * рівня кожне друге значення (парні чи непарні позиції — псевдовипадково)
+ * переходить на рівень вище з подвоєною вагою, тож загальна вага завжди
+ * дорівнює кількості значень. Сортується лише рівень 0 (порозрядно),
+ * вищі рівні отримують уже відсортовані серії і зливають їх. Пам'ять —
+ * QSKETCH_LEVELS · QSKETCH_K значень незалежно від розміру файлу
+ * (ємність — QSKETCH_K · 2^LEVELS значень), похибка рангу — порядку
+ * sqrt(рівнів) / QSKETCH_K. Більше QSKETCH_K — точніше і більше пам'яті;
+ * обидва параметри можна перевизначити під час компіляції
+ * (-DQSKETCH_K=...).
+ *
+ * LogHistogram — гістограма за порядком величини: окремо від'ємні й
+ * додатні значення по декадах [10^d, 10^(d+1)) для d у
+ * [LOGHIST_MIN_DECADE, LOGHIST_MAX_DECADE], плюс кошики «менше» і
+ * «більше» діапазону, нуль і NaN. Злиття — сума лічильників.
+ *
+ * Обидві структури без вказівників: стани шматків копіюються як байти
+ * (chunkscan.h). Заголовок придатний і для C (lab1), і для C++ (lab2).
+ */
+
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef QSKETCH_K
+#define QSKETCH_K 256
+#endif
+#ifndef QSKETCH_LEVELS
+#define QSKETCH_LEVELS 40
+#endif
+
+#ifndef LOGHIST_MIN_DECADE
+#define LOGHIST_MIN_DECADE (-9)
+#endif
+#ifndef LOGHIST_MAX_DECADE
+#define LOGHIST_MAX_DECADE 15
+#endif
+#define LOGHIST_DECADES (LOGHIST_MAX_DECADE - LOGHIST_MIN_DECADE + 1)
+/* Кошики одного знака: 0 — менше 10^MIN, 1..DECADES — декади, останній — більше */
+#define LOGHIST_SIDE (LOGHIST_DECADES + 2)
+
+typedef struct {
+    unsigned long long n;
+    uint64_t random;                      /* xorshift, детермінований */
+    int levels;                           /* задіяних рівнів */
+    int size[QSKETCH_LEVELS];
+    double items[QSKETCH_LEVELS][QSKETCH_K];
+} QuantileSketch;
+
+typedef struct {
+    unsigned long long negative[LOGHIST_SIDE];  /* за |x| */
+    unsigned long long positive[LOGHIST_SIDE];
+    unsigned long long zero;
+    unsigned long long nan;
+    double bounds[LOGHIST_DECADES + 1];         /* 10^d, d = MIN..MAX+1 */
+} LogHistogram;
+
+static inline void qsketch_init(QuantileSketch* s) {
+    s->n = 0;
+    s->random = 0x9e3779b97f4a7c15ULL;
+    s->levels = 1;
+    memset(s->size, 0, sizeof(s->size));
+}
+
+static inline int qsketch_coin(QuantileSketch* s) {
+    s->random ^= s->random << 13;
+    s->random ^= s->random >> 7;
+    s->random ^= s->random << 17;
+    return (int)(s->random >> 63);
+}
+
+/* Ключ, що впорядковується як беззнакове ціле так само, як double (без NaN) */
+static inline uint64_t qsketch_key(double value) {
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return (bits >> 63) ? ~bits : bits | 0x8000000000000000ULL;
+}
+
+static inline double qsketch_value(uint64_t key) {
+    uint64_t bits = (key >> 63) ? key & 0x7fffffffffffffffULL : ~key;
+    double value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+/* Порозрядне сортування (LSD, байтами) n <= QSKETCH_K значень; байти,
+ * однакові в усіх ключах (знак, порядок), пропускаються */
+static inline void qsketch_sort(double* a, int n) {
+    uint64_t first[QSKETCH_K], second[QSKETCH_K];
+    uint64_t* keys = first;
+    uint64_t* spare = second;
+    for (int i = 0; i < n; i++) {
+        keys[i] = qsketch_key(a[i]);
+    }
+    for (int shift = 0; shift < 64; shift += 8) {
+        int count[256];
+        memset(count, 0, sizeof(count));
+        for (int i = 0; i < n; i++) {
+            count[(keys[i] >> shift) & 255]++;
+        }
+        if (count[(keys[0] >> shift) & 255] == n) {
+            continue;
+        }
+        int offset = 0;
+        for (int d = 0; d < 256; d++) {
+            int c = count[d];
+            count[d] = offset;
+            offset += c;
+        }
+        for (int i = 0; i < n; i++) {
+            spare[count[(keys[i] >> shift) & 255]++] = keys[i];
+        }
+        uint64_t* t = keys;
+        keys = spare;
+        spare = t;
+    }
+    for (int i = 0; i < n; i++) {
+        a[i] = qsketch_value(keys[i]);
+    }
+}
+
+static inline void qsketch_push_run(QuantileSketch* s, int level, const double* run, int count);
+
+/* Рівень 0 заповнюється як прийдеться і сортується перед ущільненням,
+ * вищі рівні завжди відсортовані (отримують відсортовані серії). Половина
+ * значень переходить вище; непарне (найбільше) лишається на місці. */
+static inline void qsketch_compact(QuantileSketch* s, int level) {
+    if (level + 1 >= QSKETCH_LEVELS) {
+        return; /* недосяжно: ємність QSKETCH_K · 2^LEVELS */
+    }
+    double* items = s->items[level];
+    int count = s->size[level];
+    if (level == 0) {
+        qsketch_sort(items, count);
+    }
+    int pairs = count / 2;
+    int offset = qsketch_coin(s);
+    double run[QSKETCH_K / 2 + 1];
+    for (int i = 0; i < pairs; i++) {
+        run[i] = items[2 * i + offset];
+    }
+    if (count % 2 != 0) {
+        items[0] = items[count - 1];
+        s->size[level] = 1;
+    } else {
+        s->size[level] = 0;
+    }
+    if (level + 1 >= s->levels) {
+        s->levels = level + 2;
+    }
+    qsketch_push_run(s, level + 1, run, pairs);
+}
+
+/* Зливає відсортовану серію у відсортований рівень level >= 1 */
+static inline void qsketch_push_run(QuantileSketch* s, int level, const double* run, int count) {
+    while (count > 0) {
+        if (s->size[level] == QSKETCH_K) {
+            qsketch_compact(s, level);
+        }
+        int take = QSKETCH_K - s->size[level];
+        if (take > count) {
+            take = count;
+        }
+        /* злиття з кінця, на місці */
+        double* items = s->items[level];
+        int i = s->size[level] - 1;
+        int j = take - 1;
+        int k = s->size[level] + take - 1;
+        while (j >= 0) {
+            if (i >= 0 && items[i] > run[j]) {
+                items[k--] = items[i--];
+            } else {
+                items[k--] = run[j--];
+            }
+        }
+        s->size[level] += take;
+        run += take;
+        count -= take;
+    }
+}
+
+static inline void qsketch_add(QuantileSketch* s, double value) {
+    if (value != value) {
+        return;
+    }
+    s->n++;
+    if (s->size[0] == QSKETCH_K) {
+        qsketch_compact(s, 0);
+    }
+    s->items[0][s->size[0]++] = value;
+}
+
+/* a = a ∪ b */
+static inline void qsketch_merge(QuantileSketch* a, const QuantileSketch* b) {
+    for (int i = 0; i < b->size[0]; i++) {
+        if (a->size[0] == QSKETCH_K) {
+            qsketch_compact(a, 0);
+        }
+        a->items[0][a->size[0]++] = b->items[0][i];
+    }
+    for (int h = 1; h < b->levels; h++) {
+        if (h >= a->levels) {
+            a->levels = h + 1;
+        }
+        qsketch_push_run(a, h, b->items[h], b->size[h]);
+    }
+    a->n += b->n;
+}
+
+typedef struct {
+    double value;
+    unsigned long long weight;
+} QuantileItem;
+
+static inline int qsketch_item_compare(const void* x, const void* y) {
+    double a = ((const QuantileItem*)x)->value;
+    double b = ((const QuantileItem*)y)->value;
+    return (a > b) - (a < b);
+}
+
+/* Значення рангу q·n (q у [0, 1]); NAN, якщо скетч порожній */
+static inline double qsketch_quantile(const QuantileSketch* s, double q) {
+    size_t total = 0;
+    for (int h = 0; h < s->levels; h++) {
+        total += (size_t)s->size[h];
+    }
+    if (total == 0) {
+        return NAN;
+    }
+    QuantileItem* all = (QuantileItem*)malloc(total * sizeof(QuantileItem));
+    if (all == NULL) {
+        return NAN;
+    }
+    size_t k = 0;
+    unsigned long long weight_sum = 0;
+    for (int h = 0; h < s->levels; h++) {
+        for (int i = 0; i < s->size[h]; i++) {
+            all[k].value = s->items[h][i];
+            all[k].weight = 1ULL << h;
+            weight_sum += all[k].weight;
+            k++;
+        }
+    }
+    qsort(all, total, sizeof(QuantileItem), qsketch_item_compare);
+
+    double target = q * (double)weight_sum;
+    unsigned long long seen = 0;
+    double result = all[total - 1].value;
+    for (size_t i = 0; i < total; i++) {
+        seen += all[i].weight;
+        if ((double)seen >= target) {
+            result = all[i].value;
+            break;
+        }
+    }
+    free(all);
+    return result;
+}
+
+static inline void loghist_init(LogHistogram* h) {
+    memset(h, 0, sizeof(*h));
+    for (int d = 0; d <= LOGHIST_DECADES; d++) {
+        h->bounds[d] = pow(10.0, LOGHIST_MIN_DECADE + d);
+    }
+}
+
+/* Кошик для |x| > 0: десятковий порядок оцінюється за двійковим
+ * (floor(e2 · lg 2) дає d або d - 1) і уточнюється одним порівнянням */
+static inline int loghist_bucket(const LogHistogram* h, double magnitude) {
+    if (magnitude < h->bounds[0]) {
+        return 0;
+    }
+    if (!(magnitude < h->bounds[LOGHIST_DECADES])) {
+        return LOGHIST_SIDE - 1;
+    }
+    uint64_t bits;
+    memcpy(&bits, &magnitude, sizeof(bits));
+    int e2 = (int)((bits >> 52) & 0x7ff) - 1023;
+    int scaled = e2 * 1233;                     /* 1233 / 4096 ≈ lg 2 */
+    int decade = (scaled >= 0 ? scaled : scaled - 4095) / 4096;
+    int index = decade - LOGHIST_MIN_DECADE;
+    if (index < 0) {
+        index = 0;
+    }
+    if (index + 1 < LOGHIST_DECADES && magnitude >= h->bounds[index + 1]) {
+        index++;
+    }
+    return index + 1;
+}
+
+static inline void loghist_add(LogHistogram* h, double value) {
+    if (value > 0) {
+        h->positive[loghist_bucket(h, value)]++;
+    } else if (value < 0) {
+        h->negative[loghist_bucket(h, -value)]++;
+    } else if (value == 0) {
+        h->zero++;
+    } else {
+        h->nan++;
+    }
+}
+
+static inline void loghist_merge(LogHistogram* a, const LogHistogram* b) {
+    for (int i = 0; i < LOGHIST_SIDE; i++) {
+        a->negative[i] += b->negative[i];
+        a->positive[i] += b->positive[i];
+    }
+    a->zero += b->zero;
+    a->nan += b->nan;
+}
+
+/* Підпис кошика, наприклад "[1e+02, 1e+03)" чи "(-1e+03, -1e+02]" */
+static inline void loghist_label(const LogHistogram* h, int negative, int bucket, char* buffer, size_t size) {
+    double lower = bucket == 0 ? 0.0 : h->bounds[bucket - 1];
+    double upper = bucket == LOGHIST_SIDE - 1 ? INFINITY : h->bounds[bucket];
+    if (bucket == 0) {
+        snprintf(buffer, size, negative ? "(%g, 0)" : "(0, %g)", negative ? -upper : upper);
+    } else if (negative) {
+        snprintf(buffer, size, "(%g, %g]", -upper, -lower);
+    } else {
+        snprintf(buffer, size, "[%g, %g)", lower, upper);
+    }
+}
+
+#endif
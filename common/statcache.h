@@ -0,0 +1,546 @@
+#ifndef STATCACHE_H
+#define STATCACHE_H
+
+/*
+ * Кеш статистики між запусками.
+ *
+ * Для кожного звичайного файлу зберігається стан його накопичувача
+ * (TextChunk чи NumberChunk) таким, яким він був до textscan_finish() /
+ * numscan_finish(), разом із ключем (пристрій, inode, розмір, mtime у
+ * наносекундах) і хешами двох зразків вмісту: перших і останніх
+ * STATCACHE_SAMPLE байтів. Статистика обчислюється з відновленого стану
+ * тим самим кодом, що й після сканування.
+ *
+ *   ключ збігся повністю     — файл не відкривається взагалі (з
+ *                              --cache-verify спершу звіряються зразки);
+ *   той самий inode, файл    — якщо зразки на старих місцях збігаються,
+ *   став довшим                дописано лише хвіст: сканується тільки
+ *                              [старий розмір, новий), і результат
+ *                              зливається у збережений стан (моноїд, як
+ *                              і між потоками, див. chunkscan.h);
+ *   інакше                   — повне сканування.
+ *
+ * Кеш — один файл, що цілком читається на старті й далі лише читається
+ * (відсортований масив, пошук без блокувань). Нові записи збирає один
+ * потік (писач результатів, results.h), а наприкінці файл кешу
+ * переписується атомарно (тимчасовий файл і rename). Старі записи,
+ * шлях яких більше не веде на той самий inode, відкидаються.
+ *
+ * Формат — двійковий, у порядку байтів машини; заголовок містить
+ * версію, розміри станів і мітку програми, і за будь-якої розбіжності
+ * кеш просто вважається порожнім.
+ *
+ * Заголовок придатний і для C (lab1), і для C++ (lab2).
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "numscan.h"
+#include "textscan.h"
+
+#define STATCACHE_MAGIC "STATCACH"
+#define STATCACHE_VERSION 1
+#define STATCACHE_SAMPLE 4096
+
+typedef enum {
+    STATCACHE_TEXT = 1,
+    STATCACHE_NUMBERS = 2
+} StatCacheKind;
+
+typedef struct {
+    unsigned long long dev;
+    unsigned long long ino;
+    unsigned long long size;          /* скільки байтів описує стан */
+    unsigned long long mtime_ns;
+    unsigned long long head_hash;     /* [0, STATCACHE_SAMPLE) */
+    unsigned long long tail_hash;     /* [size - STATCACHE_SAMPLE, size) */
+    int kind;
+    double confidence;
+    char* path;
+    unsigned char* state;             /* серіалізований накопичувач */
+    size_t state_len;
+} StatCacheEntry;
+
+typedef struct {
+    StatCacheEntry* entries;          /* за (dev, ino) */
+    size_t count;
+} StatCache;
+
+/* Нові записи одного запуску */
+typedef struct {
+    StatCacheEntry** items;
+    size_t count;
+    size_t cap;
+} StatCacheList;
+
+/* Буфер серіалізації; failed — бракувало пам'яті або даних */
+typedef struct {
+    unsigned char* data;
+    size_t len;
+    size_t cap;
+    size_t pos;                       /* позиція читання */
+    int failed;
+} StatBuf;
+
+static inline void statbuf_init(StatBuf* b) {
+    memset(b, 0, sizeof(*b));
+}
+
+static inline void statbuf_put(StatBuf* b, const void* data, size_t len) {
+    if (b->failed) {
+        return;
+    }
+    if (b->len + len > b->cap) {
+        size_t cap = b->cap > 0 ? b->cap * 2 : 256;
+        while (cap < b->len + len) {
+            cap *= 2;
+        }
+        unsigned char* grown = (unsigned char*)realloc(b->data, cap);
+        if (grown == NULL) {
+            b->failed = 1;
+            return;
+        }
+        b->data = grown;
+        b->cap = cap;
+    }
+    memcpy(b->data + b->len, data, len);
+    b->len += len;
+}
+
+static inline void statbuf_get(StatBuf* b, void* data, size_t len) {
+    if (b->failed || b->len - b->pos < len) {
+        b->failed = 1;
+        memset(data, 0, len);
+        return;
+    }
+    memcpy(data, b->data + b->pos, len);
+    b->pos += len;
+}
+
+/* Буфер для читання чужих байтів (нічого не звільняє) */
+static inline StatBuf statbuf_reader(const unsigned char* data, size_t len) {
+    StatBuf b;
+    statbuf_init(&b);
+    b.data = (unsigned char*)data;
+    b.len = len;
+    return b;
+}
+
+static inline unsigned long long statcache_hash(const unsigned char* data, size_t len) {
+    unsigned long long h = 0xcbf29ce484222325ULL;  /* FNV-1a */
+    for (size_t i = 0; i < len; i++) {
+        h = (h ^ data[i]) * 0x100000001b3ULL;
+    }
+    return h;
+}
+
+/* Хеші зразків на початку і в кінці перших size байтів; 0 — успіх */
+static inline int statcache_sample(int fd, unsigned long long size,
+                                   unsigned long long* head, unsigned long long* tail) {
+    unsigned char buffer[STATCACHE_SAMPLE];
+    size_t len = size < STATCACHE_SAMPLE ? (size_t)size : STATCACHE_SAMPLE;
+    unsigned long long offsets[2] = { 0, size - len };
+    unsigned long long* hashes[2] = { head, tail };
+    for (int k = 0; k < 2; k++) {
+        size_t got = 0;
+        while (got < len) {
+            ssize_t n = pread(fd, buffer + got, len - got, (off_t)(offsets[k] + got));
+            if (n < 0 && errno == EINTR) {
+                continue;
+            }
+            if (n <= 0) {
+                return -1;
+            }
+            got += (size_t)n;
+        }
+        *hashes[k] = statcache_hash(buffer, len);
+    }
+    return 0;
+}
+
+/* Чи той самий вміст лежить у перших e->size байтах файлу */
+static inline int statcache_verify_fd(int fd, const StatCacheEntry* e) {
+    unsigned long long head;
+    unsigned long long tail;
+    return statcache_sample(fd, e->size, &head, &tail) == 0 && head == e->head_hash && tail == e->tail_hash;
+}
+
+static inline int statcache_verify_path(const char* path, const StatCacheEntry* e) {
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        return 0;
+    }
+    int same = statcache_verify_fd(fd, e);
+    close(fd);
+    return same;
+}
+
+static inline unsigned long long statcache_mtime_ns(const struct stat* st) {
+    return (unsigned long long)st->st_mtim.tv_sec * 1000000000ULL + (unsigned long long)st->st_mtim.tv_nsec;
+}
+
+/* Ключ із stat(): розмір — увесь файл */
+static inline void statcache_key(StatCacheEntry* e, const struct stat* st) {
+    e->dev = (unsigned long long)st->st_dev;
+    e->ino = (unsigned long long)st->st_ino;
+    e->size = (unsigned long long)st->st_size;
+    e->mtime_ns = statcache_mtime_ns(st);
+}
+
+static inline int statcache_compare(const void* x, const void* y) {
+    const StatCacheEntry* a = (const StatCacheEntry*)x;
+    const StatCacheEntry* b = (const StatCacheEntry*)y;
+    if (a->dev != b->dev) {
+        return a->dev < b->dev ? -1 : 1;
+    }
+    return (a->ino > b->ino) - (a->ino < b->ino);
+}
+
+static inline int statcache_compare_ptr(const void* x, const void* y) {
+    return statcache_compare(*(const StatCacheEntry* const*)x, *(const StatCacheEntry* const*)y);
+}
+
+static inline const StatCacheEntry* statcache_find(const StatCache* c, const struct stat* st) {
+    StatCacheEntry key;
+    statcache_key(&key, st);
+    return (const StatCacheEntry*)bsearch(&key, c->entries, c->count, sizeof(StatCacheEntry), statcache_compare);
+}
+
+/* Незмінений файл: ключ збігається повністю */
+static inline int statcache_unchanged(const StatCacheEntry* e, const struct stat* st) {
+    return e->size == (unsigned long long)st->st_size && e->mtime_ns == statcache_mtime_ns(st);
+}
+
+/* Файл, до якого, можливо, лише дописали (зразки ще треба звірити) */
+static inline int statcache_grown(const StatCacheEntry* e, const struct stat* st) {
+    return e->size > 0 && e->size < (unsigned long long)st->st_size;
+}
+
+static inline void statcache_entry_free(StatCacheEntry* e) {
+    free(e->path);
+    free(e->state);
+    e->path = NULL;
+    e->state = NULL;
+}
+
+/* Стан TextChunk — проста структура без вказівників */
+static inline void statcache_put_text(StatBuf* b, const TextChunk* c) {
+    statbuf_put(b, c, sizeof(*c));
+}
+
+static inline int statcache_get_text(const StatCacheEntry* e, TextChunk* c) {
+    StatBuf b = statbuf_reader(e->state, e->state_len);
+    statbuf_get(&b, c, sizeof(*c));
+    return b.failed || b.pos != b.len ? -1 : 0;
+}
+
+/* NumberChunk без порожніх комірок скетча (інакше понад 80 КБ на файл) */
+static inline void statcache_put_numbers(StatBuf* b, const NumberChunk* c) {
+    const NumberAccum* a = &c->acc;
+    statbuf_put(b, &c->mode, sizeof(c->mode));
+    statbuf_put(b, &c->size, sizeof(c->size));
+    statbuf_put(b, &c->has_separator, sizeof(c->has_separator));
+    statbuf_put(b, &c->stopped, sizeof(c->stopped));
+    const NumScanFragment* fragments[2] = { &c->head, &c->tail };
+    for (int k = 0; k < 2; k++) {
+        statbuf_put(b, &fragments[k]->len, sizeof(fragments[k]->len));
+        statbuf_put(b, &fragments[k]->overflow, sizeof(fragments[k]->overflow));
+        statbuf_put(b, fragments[k]->text, fragments[k]->len);
+    }
+    statbuf_put(b, &a->sum, sizeof(a->sum));
+    statbuf_put(b, &a->min, sizeof(a->min));
+    statbuf_put(b, &a->max, sizeof(a->max));
+    statbuf_put(b, &a->count, sizeof(a->count));
+    statbuf_put(b, &a->positive, sizeof(a->positive));
+    statbuf_put(b, &a->negative, sizeof(a->negative));
+    statbuf_put(b, &a->zero, sizeof(a->zero));
+    statbuf_put(b, &a->mean, sizeof(a->mean));
+    statbuf_put(b, &a->m2, sizeof(a->m2));
+    statbuf_put(b, a->histogram.negative, sizeof(a->histogram.negative));
+    statbuf_put(b, a->histogram.positive, sizeof(a->histogram.positive));
+    statbuf_put(b, &a->histogram.zero, sizeof(a->histogram.zero));
+    statbuf_put(b, &a->histogram.nan, sizeof(a->histogram.nan));
+    const QuantileSketch* s = &a->quantiles;
+    statbuf_put(b, &s->n, sizeof(s->n));
+    statbuf_put(b, &s->random, sizeof(s->random));
+    statbuf_put(b, &s->levels, sizeof(s->levels));
+    for (int h = 0; h < s->levels; h++) {
+        statbuf_put(b, &s->size[h], sizeof(s->size[h]));
+        statbuf_put(b, s->items[h], (size_t)s->size[h] * sizeof(double));
+    }
+}
+
+static inline int statcache_get_numbers(const StatCacheEntry* e, NumberChunk* c) {
+    StatBuf b = statbuf_reader(e->state, e->state_len);
+    NumScanMode mode;
+    statbuf_get(&b, &mode, sizeof(mode));
+    numscan_init(c, mode);
+    NumberAccum* a = &c->acc;
+    statbuf_get(&b, &c->size, sizeof(c->size));
+    statbuf_get(&b, &c->has_separator, sizeof(c->has_separator));
+    statbuf_get(&b, &c->stopped, sizeof(c->stopped));
+    NumScanFragment* fragments[2] = { &c->head, &c->tail };
+    for (int k = 0; k < 2 && !b.failed; k++) {
+        statbuf_get(&b, &fragments[k]->len, sizeof(fragments[k]->len));
+        statbuf_get(&b, &fragments[k]->overflow, sizeof(fragments[k]->overflow));
+        if (fragments[k]->len >= NUMSCAN_MAX_TOKEN) {
+            return -1;
+        }
+        statbuf_get(&b, fragments[k]->text, fragments[k]->len);
+    }
+    statbuf_get(&b, &a->sum, sizeof(a->sum));
+    statbuf_get(&b, &a->min, sizeof(a->min));
+    statbuf_get(&b, &a->max, sizeof(a->max));
+    statbuf_get(&b, &a->count, sizeof(a->count));
+    statbuf_get(&b, &a->positive, sizeof(a->positive));
+    statbuf_get(&b, &a->negative, sizeof(a->negative));
+    statbuf_get(&b, &a->zero, sizeof(a->zero));
+    statbuf_get(&b, &a->mean, sizeof(a->mean));
+    statbuf_get(&b, &a->m2, sizeof(a->m2));
+    statbuf_get(&b, a->histogram.negative, sizeof(a->histogram.negative));
+    statbuf_get(&b, a->histogram.positive, sizeof(a->histogram.positive));
+    statbuf_get(&b, &a->histogram.zero, sizeof(a->histogram.zero));
+    statbuf_get(&b, &a->histogram.nan, sizeof(a->histogram.nan));
+    QuantileSketch* s = &a->quantiles;
+    statbuf_get(&b, &s->n, sizeof(s->n));
+    statbuf_get(&b, &s->random, sizeof(s->random));
+    statbuf_get(&b, &s->levels, sizeof(s->levels));
+    if (s->levels < 0 || s->levels > QSKETCH_LEVELS) {
+        return -1;
+    }
+    for (int h = 0; h < s->levels && !b.failed; h++) {
+        statbuf_get(&b, &s->size[h], sizeof(s->size[h]));
+        if (s->size[h] < 0 || s->size[h] > QSKETCH_K) {
+            return -1;
+        }
+        statbuf_get(&b, s->items[h], (size_t)s->size[h] * sizeof(double));
+    }
+    return b.failed || b.pos != b.len ? -1 : 0;
+}
+
+/* Новий запис: ключ із fstat на момент відкриття, size — скільки байтів
+ * просканував стан; зразки читаються з fd. Забирає state. NULL —
+ * бракує пам'яті чи не вдалося прочитати зразки */
+static inline StatCacheEntry* statcache_entry_new(const struct stat* st, unsigned long long size, int fd,
+                                                  int kind, double confidence, const char* path, StatBuf* state) {
+    StatCacheEntry* e = (StatCacheEntry*)calloc(1, sizeof(StatCacheEntry));
+    if (e == NULL || state->failed || statcache_sample(fd, size, &e->head_hash, &e->tail_hash) != 0 ||
+        (e->path = strdup(path)) == NULL) {
+        free(e);
+        free(state->data);
+        return NULL;
+    }
+    statcache_key(e, st);
+    e->size = size;
+    e->kind = kind;
+    e->confidence = confidence;
+    e->state = state->data;
+    e->state_len = state->len;
+    return e;
+}
+
+/* Забирає e; 0 — успіх */
+static inline int statcache_list_push(StatCacheList* list, StatCacheEntry* e) {
+    if (list->count == list->cap) {
+        size_t cap = list->cap > 0 ? list->cap * 2 : 64;
+        StatCacheEntry** grown = (StatCacheEntry**)realloc(list->items, cap * sizeof(*grown));
+        if (grown == NULL) {
+            statcache_entry_free(e);
+            free(e);
+            return -1;
+        }
+        list->items = grown;
+        list->cap = cap;
+    }
+    list->items[list->count++] = e;
+    return 0;
+}
+
+static inline void statcache_list_free(StatCacheList* list) {
+    for (size_t i = 0; i < list->count; i++) {
+        statcache_entry_free(list->items[i]);
+        free(list->items[i]);
+    }
+    free(list->items);
+    memset(list, 0, sizeof(*list));
+}
+
+static inline void statcache_free(StatCache* c) {
+    for (size_t i = 0; i < c->count; i++) {
+        statcache_entry_free(&c->entries[i]);
+    }
+    free(c->entries);
+    c->entries = NULL;
+    c->count = 0;
+}
+
+/* Заголовок: магія, версія, розміри станів, мітка програми */
+static inline void statcache_put_header(StatBuf* b, const char* tag) {
+    uint32_t fields[3] = { STATCACHE_VERSION, (uint32_t)sizeof(TextChunk), (uint32_t)QSKETCH_K };
+    uint32_t tag_len = (uint32_t)strlen(tag);
+    statbuf_put(b, STATCACHE_MAGIC, 8);
+    statbuf_put(b, fields, sizeof(fields));
+    statbuf_put(b, &tag_len, sizeof(tag_len));
+    statbuf_put(b, tag, tag_len);
+}
+
+static inline void statcache_put_entry(StatBuf* b, const StatCacheEntry* e) {
+    uint32_t path_len = (uint32_t)strlen(e->path);
+    uint64_t state_len = e->state_len;
+    statbuf_put(b, &e->dev, 6 * sizeof(unsigned long long));
+    statbuf_put(b, &e->kind, sizeof(e->kind));
+    statbuf_put(b, &e->confidence, sizeof(e->confidence));
+    statbuf_put(b, &path_len, sizeof(path_len));
+    statbuf_put(b, e->path, path_len);
+    statbuf_put(b, &state_len, sizeof(state_len));
+    statbuf_put(b, e->state, e->state_len);
+}
+
+/* Читає кеш; відсутній, чужий чи пошкоджений файл дає порожній кеш.
+ * -1 з errno — лише помилка читання наявного файлу */
+static inline int statcache_load(StatCache* c, const char* path, const char* tag) {
+    memset(c, 0, sizeof(*c));
+    FILE* f = fopen(path, "rb");
+    if (f == NULL) {
+        return errno == ENOENT ? 0 : -1;
+    }
+    StatBuf b;
+    statbuf_init(&b);
+    unsigned char chunk[1 << 16];
+    size_t got;
+    while ((got = fread(chunk, 1, sizeof(chunk), f)) > 0) {
+        statbuf_put(&b, chunk, got);
+    }
+    int error = ferror(f) ? EIO : b.failed ? ENOMEM : 0;
+    fclose(f);
+    if (error != 0) {
+        free(b.data);
+        errno = error;
+        return -1;
+    }
+
+    StatBuf expected;
+    statbuf_init(&expected);
+    statcache_put_header(&expected, tag);
+    int same = !expected.failed && b.len >= expected.len && memcmp(b.data, expected.data, expected.len) == 0;
+    b.pos = expected.len;
+    free(expected.data);
+
+    size_t cap = 0;
+    while (same && b.pos < b.len) {
+        StatCacheEntry e;
+        memset(&e, 0, sizeof(e));
+        uint32_t path_len = 0;
+        uint64_t state_len = 0;
+        statbuf_get(&b, &e.dev, 6 * sizeof(unsigned long long));
+        statbuf_get(&b, &e.kind, sizeof(e.kind));
+        statbuf_get(&b, &e.confidence, sizeof(e.confidence));
+        statbuf_get(&b, &path_len, sizeof(path_len));
+        if (b.failed || path_len > b.len - b.pos) {
+            break;
+        }
+        e.path = (char*)malloc(path_len + 1);
+        if (e.path == NULL) {
+            break;
+        }
+        statbuf_get(&b, e.path, path_len);
+        e.path[path_len] = '\0';
+        statbuf_get(&b, &state_len, sizeof(state_len));
+        if (b.failed || state_len > b.len - b.pos) {
+            free(e.path);
+            break;
+        }
+        e.state_len = (size_t)state_len;
+        e.state = (unsigned char*)malloc(e.state_len > 0 ? e.state_len : 1);
+        if (e.state == NULL) {
+            free(e.path);
+            break;
+        }
+        statbuf_get(&b, e.state, e.state_len);
+        if (c->count == cap) {
+            cap = cap > 0 ? cap * 2 : 64;
+            StatCacheEntry* grown = (StatCacheEntry*)realloc(c->entries, cap * sizeof(StatCacheEntry));
+            if (grown == NULL) {
+                statcache_entry_free(&e);
+                break;
+            }
+            c->entries = grown;
+        }
+        c->entries[c->count++] = e;
+    }
+    free(b.data);
+    if (c->count > 1) {
+        qsort(c->entries, c->count, sizeof(StatCacheEntry), statcache_compare);
+    }
+    return 0;
+}
+
+/* Записує нові записи і ті старі, чий шлях досі веде на той самий
+ * inode. Тимчасовий файл і rename: обірваний запис не псує кеш.
+ * 0 — успіх, -1 — помилка з errno */
+static inline int statcache_save(const StatCache* old, StatCacheList* fresh, const char* path, const char* tag) {
+    if (fresh->count > 1) {
+        qsort(fresh->items, fresh->count, sizeof(StatCacheEntry*), statcache_compare_ptr);
+    }
+    StatBuf b;
+    statbuf_init(&b);
+    statcache_put_header(&b, tag);
+    for (size_t i = 0; i < old->count; i++) {
+        const StatCacheEntry* e = &old->entries[i];
+        const StatCacheEntry* key = e;
+        struct stat st;
+        if ((fresh->count == 0 ||
+             bsearch(&key, fresh->items, fresh->count, sizeof(StatCacheEntry*), statcache_compare_ptr) == NULL) &&
+            stat(e->path, &st) == 0 && (unsigned long long)st.st_dev == e->dev &&
+            (unsigned long long)st.st_ino == e->ino) {
+            statcache_put_entry(&b, e);
+        }
+    }
+    for (size_t i = 0; i < fresh->count; i++) {
+        /* той самий файл кілька разів (повтор у аргументах, жорсткі
+         * посилання) — досить одного запису */
+        if (i == 0 || statcache_compare_ptr(&fresh->items[i - 1], &fresh->items[i]) != 0) {
+            statcache_put_entry(&b, fresh->items[i]);
+        }
+    }
+    if (b.failed) {
+        free(b.data);
+        errno = ENOMEM;
+        return -1;
+    }
+
+    size_t path_len = strlen(path);
+    char* temp = (char*)malloc(path_len + 5);
+    if (temp == NULL) {
+        free(b.data);
+        errno = ENOMEM;
+        return -1;
+    }
+    memcpy(temp, path, path_len);
+    memcpy(temp + path_len, ".tmp", 5);
+    FILE* f = fopen(temp, "wb");
+    int rc = -1;
+    if (f != NULL) {
+        size_t written = fwrite(b.data, 1, b.len, f);
+        int closed = fclose(f);
+        if (written == b.len && closed == 0 && rename(temp, path) == 0) {
+            rc = 0;
+        } else {
+            int saved = errno;
+            unlink(temp);
+            errno = saved;
+        }
+    }
+    free(temp);
+    free(b.data);
+    return rc;
+}
+
+#endif
@@ -0,0 +1,337 @@
+#ifndef TEXTCLASS_H
+#define TEXTCLASS_H
+
+/*
+ * Векторна класифікація байтів тексту.
+ *
+ * Кожен байт належить до кількох класів (TextClass). Ядро обробляє текст
+ * блоками по 64 байти: рахує байти кожного класу, а початки слів і
+ * абзаців знаходить popcount-ом зсунутих 64-бітних масок пробілів та '\n'
+ * з переносом між блоками. Належність байта до класу визначається двома
+ * таблицями по 16 байтів (pshufb): за молодшим напівбайтом — множина
+ * старших напівбайтів класу, за старшим — його біт. Байти >= 128 не
+ * належать жодному класу: символи UTF-8 поза ASCII класифікує
+ * utf8class.h.
+ *
+ * Варіанти AVX2, SSE4.1 і скалярний дають однакові лічильники; потрібний
+ * обирається під час виконання за CPUID. Змінна середовища
+ * TEXTCLASS_KERNEL=avx2|sse4|scalar примусово задає варіант (для
+ * порівняння).
+ *
+ * Заголовок придатний і для C (lab1), і для C++ (lab2).
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define TEXTCLASS_X86 1
+#endif
+
+typedef enum {
+    TEXTCLASS_ALPHA,    /* isalpha у локалі C */
+    TEXTCLASS_DIGIT,    /* isdigit */
+    TEXTCLASS_SPACE,    /* isspace, разом із '\n' */
+    TEXTCLASS_PUNCT,    /* ispunct */
+    TEXTCLASS_NEWLINE,  /* '\n' */
+    TEXTCLASS_MARK,     /* розділові знаки в розумінні lab1_1 */
+    TEXTCLASS_COUNT
+} TextClass;
+
+typedef enum {
+    TEXTCLASS_KERNEL_SCALAR,
+    TEXTCLASS_KERNEL_SSE4,
+    TEXTCLASS_KERNEL_AVX2
+} TextClassKernel;
+
+typedef struct {
+    unsigned long long counts[TEXTCLASS_COUNT];
+    unsigned long long word_starts;       /* !S[i] && S[i-1] */
+    unsigned long long paragraph_starts;  /* N[i-2] && N[i-1] && !N[i] */
+} TextClassCounts;
+
+typedef struct {
+    unsigned char table[256];                  /* біти класів кожного байта */
+    unsigned char low[TEXTCLASS_COUNT][16];    /* старші напівбайти класу */
+} TextClassTables;
+
+/* Стан між блоками: класи попередніх байтів */
+typedef struct {
+    uint64_t space1;     /* S[i-1] */
+    uint64_t newline1;   /* N[i-1] */
+    uint64_t newline2;   /* N[i-2] */
+} TextClassCarry;
+
+static inline unsigned textclass_of(unsigned char b) {
+    unsigned bits = 0;
+    if ((b >= 'A' && b <= 'Z') || (b >= 'a' && b <= 'z')) {
+        bits |= 1u << TEXTCLASS_ALPHA;
+    }
+    if (b >= '0' && b <= '9') {
+        bits |= 1u << TEXTCLASS_DIGIT;
+    }
+    if (b == ' ' || (b >= '\t' && b <= '\r')) {
+        bits |= 1u << TEXTCLASS_SPACE;
+    }
+    if ((b >= '!' && b <= '/') || (b >= ':' && b <= '@') || (b >= '[' && b <= '`') ||
+        (b >= '{' && b <= '~')) {
+        bits |= 1u << TEXTCLASS_PUNCT;
+    }
+    if (b == '\n') {
+        bits |= 1u << TEXTCLASS_NEWLINE;
+    }
+    if (b == '.' || b == ',' || b == ';' || b == ':' || b == '!' || b == '?' || b == '-' ||
+        b == '(' || b == ')' || b == '[' || b == ']' || b == '"' || b == '\'' || b == '/' ||
+        b == '_') {
+        bits |= 1u << TEXTCLASS_MARK;
+    }
+    return bits;
+}
+
+static inline void textclass_tables(TextClassTables* t) {
+    memset(t, 0, sizeof(*t));
+    for (int b = 0; b < 256; b++) {
+        t->table[b] = (unsigned char)textclass_of((unsigned char)b);
+        if (b < 128) {
+            for (int c = 0; c < TEXTCLASS_COUNT; c++) {
+                if (t->table[b] & (1u << c)) {
+                    t->low[c][b & 15] |= (unsigned char)(1u << (b >> 4));
+                }
+            }
+        }
+    }
+}
+
+static inline int textclass_popcount(uint64_t x) {
+    return __builtin_popcountll(x);
+}
+
+/* Шаблони для блоку з n (1..64) байтів за масками пробілів і '\n' */
+static inline void textclass_add_patterns(TextClassCounts* out, TextClassCarry* carry,
+                                          uint64_t s, uint64_t nl, int n) {
+    uint64_t valid = n == 64 ? ~0ULL : (1ULL << n) - 1;
+    uint64_t prev_s = (s << 1) | carry->space1;
+    uint64_t prev_n1 = (nl << 1) | carry->newline1;
+    uint64_t prev_n2 = (nl << 2) | (carry->newline1 << 1) | carry->newline2;
+    out->word_starts += (unsigned long long)textclass_popcount(~s & prev_s & valid);
+    out->paragraph_starts += (unsigned long long)textclass_popcount(~nl & prev_n1 & prev_n2 & valid);
+
+    carry->space1 = (s >> (n - 1)) & 1;
+    carry->newline2 = n >= 2 ? (nl >> (n - 2)) & 1 : carry->newline1;
+    carry->newline1 = (nl >> (n - 1)) & 1;
+}
+
+/* Скалярний прохід: також дочищає хвіст після векторного циклу */
+static inline void textclass_scan_scalar(const TextClassTables* t, const unsigned char* data, size_t len,
+                                         TextClassCounts* out, TextClassCarry* carry) {
+    for (size_t i = 0; i < len; i += 64) {
+        int n = len - i < 64 ? (int)(len - i) : 64;
+        uint64_t s = 0, nl = 0;
+        for (int k = 0; k < n; k++) {
+            unsigned bits = t->table[data[i + k]];
+            for (int c = 0; c < TEXTCLASS_COUNT; c++) {
+                out->counts[c] += (bits >> c) & 1;
+            }
+            s |= (uint64_t)((bits >> TEXTCLASS_SPACE) & 1) << k;
+            nl |= (uint64_t)((bits >> TEXTCLASS_NEWLINE) & 1) << k;
+        }
+        textclass_add_patterns(out, carry, s, nl, n);
+    }
+}
+
+#ifdef TEXTCLASS_X86
+
+/* Векторні варіанти рахують класи байтовими лічильниками (0/1 на байт),
+ * які скидаються у 64-бітні суми кожні TEXTCLASS_FLUSH блоків, доки
+ * жоден байт лічильника не переповнився; маски потрібні лише для
+ * пробілів і '\n' */
+#define TEXTCLASS_FLUSH 127
+
+__attribute__((target("avx2,popcnt")))
+static inline void textclass_scan_avx2(const TextClassTables* t, const unsigned char* data, size_t len,
+                                       TextClassCounts* out, TextClassCarry* carry) {
+    const __m256i nibble = _mm256_set1_epi8(0x0f);
+    const __m256i one = _mm256_set1_epi8(1);
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i high_bit = _mm256_setr_epi8(1, 2, 4, 8, 16, 32, 64, (char)128, 0, 0, 0, 0, 0, 0, 0, 0,
+                                              1, 2, 4, 8, 16, 32, 64, (char)128, 0, 0, 0, 0, 0, 0, 0, 0);
+    __m256i low[TEXTCLASS_COUNT];
+    __m256i total[TEXTCLASS_COUNT];
+    for (int c = 0; c < TEXTCLASS_COUNT; c++) {
+        low[c] = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)t->low[c]));
+        total[c] = zero;
+    }
+
+    TextClassCounts local;
+    TextClassCarry cy = *carry;
+    memset(&local, 0, sizeof(local));
+    size_t i = 0;
+    while (i + 64 <= len) {
+        __m256i bytes[TEXTCLASS_COUNT];
+        for (int c = 0; c < TEXTCLASS_COUNT; c++) {
+            bytes[c] = zero;
+        }
+        for (int block = 0; block < TEXTCLASS_FLUSH && i + 64 <= len; block++, i += 64) {
+            uint64_t s = 0, nl = 0;
+#pragma GCC unroll 2
+            for (int k = 0; k < 2; k++) {
+                __m256i v = _mm256_loadu_si256((const __m256i*)(data + i + 32 * k));
+                __m256i lo = _mm256_and_si256(v, nibble);
+                __m256i hi = _mm256_shuffle_epi8(high_bit, _mm256_and_si256(_mm256_srli_epi16(v, 4), nibble));
+#pragma GCC unroll 8
+                for (int c = 0; c < TEXTCLASS_COUNT; c++) {
+                    __m256i hit = _mm256_min_epu8(_mm256_and_si256(_mm256_shuffle_epi8(low[c], lo), hi), one);
+                    bytes[c] = _mm256_add_epi8(bytes[c], hit);
+                    if (c == TEXTCLASS_SPACE) {
+                        s |= (uint64_t)(uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(hit, one)) << (32 * k);
+                    } else if (c == TEXTCLASS_NEWLINE) {
+                        nl |= (uint64_t)(uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(hit, one)) << (32 * k);
+                    }
+                }
+            }
+            textclass_add_patterns(&local, &cy, s, nl, 64);
+        }
+        for (int c = 0; c < TEXTCLASS_COUNT; c++) {
+            total[c] = _mm256_add_epi64(total[c], _mm256_sad_epu8(bytes[c], zero));
+        }
+    }
+    for (int c = 0; c < TEXTCLASS_COUNT; c++) {
+        uint64_t lanes[4];
+        _mm256_storeu_si256((__m256i*)lanes, total[c]);
+        out->counts[c] += lanes[0] + lanes[1] + lanes[2] + lanes[3];
+    }
+    out->word_starts += local.word_starts;
+    out->paragraph_starts += local.paragraph_starts;
+    *carry = cy;
+    textclass_scan_scalar(t, data + i, len - i, out, carry);
+}
+
+__attribute__((target("sse4.1,popcnt")))
+static inline void textclass_scan_sse4(const TextClassTables* t, const unsigned char* data, size_t len,
+                                       TextClassCounts* out, TextClassCarry* carry) {
+    const __m128i nibble = _mm_set1_epi8(0x0f);
+    const __m128i one = _mm_set1_epi8(1);
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i high_bit = _mm_setr_epi8(1, 2, 4, 8, 16, 32, 64, (char)128, 0, 0, 0, 0, 0, 0, 0, 0);
+    __m128i low[TEXTCLASS_COUNT];
+    __m128i total[TEXTCLASS_COUNT];
+    for (int c = 0; c < TEXTCLASS_COUNT; c++) {
+        low[c] = _mm_loadu_si128((const __m128i*)t->low[c]);
+        total[c] = zero;
+    }
+
+    TextClassCounts local;
+    TextClassCarry cy = *carry;
+    memset(&local, 0, sizeof(local));
+    size_t i = 0;
+    while (i + 64 <= len) {
+        __m128i bytes[TEXTCLASS_COUNT];
+        for (int c = 0; c < TEXTCLASS_COUNT; c++) {
+            bytes[c] = zero;
+        }
+        for (int block = 0; block < TEXTCLASS_FLUSH / 2 && i + 64 <= len; block++, i += 64) {
+            uint64_t s = 0, nl = 0;
+#pragma GCC unroll 4
+            for (int k = 0; k < 4; k++) {
+                __m128i v = _mm_loadu_si128((const __m128i*)(data + i + 16 * k));
+                __m128i lo = _mm_and_si128(v, nibble);
+                __m128i hi = _mm_shuffle_epi8(high_bit, _mm_and_si128(_mm_srli_epi16(v, 4), nibble));
+#pragma GCC unroll 8
+                for (int c = 0; c < TEXTCLASS_COUNT; c++) {
+                    __m128i hit = _mm_min_epu8(_mm_and_si128(_mm_shuffle_epi8(low[c], lo), hi), one);
+                    bytes[c] = _mm_add_epi8(bytes[c], hit);
+                    if (c == TEXTCLASS_SPACE) {
+                        s |= (uint64_t)(uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(hit, one)) << (16 * k);
+                    } else if (c == TEXTCLASS_NEWLINE) {
+                        nl |= (uint64_t)(uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(hit, one)) << (16 * k);
+                    }
+                }
+            }
+            textclass_add_patterns(&local, &cy, s, nl, 64);
+        }
+        for (int c = 0; c < TEXTCLASS_COUNT; c++) {
+            total[c] = _mm_add_epi64(total[c], _mm_sad_epu8(bytes[c], zero));
+        }
+    }
+    for (int c = 0; c < TEXTCLASS_COUNT; c++) {
+        uint64_t lanes[2];
+        _mm_storeu_si128((__m128i*)lanes, total[c]);
+        out->counts[c] += lanes[0] + lanes[1];
+    }
+    out->word_starts += local.word_starts;
+    out->paragraph_starts += local.paragraph_starts;
+    *carry = cy;
+    textclass_scan_scalar(t, data + i, len - i, out, carry);
+}
+
+#endif
+
+static inline TextClassKernel textclass_detect_kernel(void) {
+    TextClassKernel best = TEXTCLASS_KERNEL_SCALAR;
+#ifdef TEXTCLASS_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("popcnt")) {
+        best = TEXTCLASS_KERNEL_AVX2;
+    } else if (__builtin_cpu_supports("sse4.1") && __builtin_cpu_supports("popcnt")) {
+        best = TEXTCLASS_KERNEL_SSE4;
+    }
+#endif
+    const char* forced = getenv("TEXTCLASS_KERNEL");
+    if (forced != NULL) {
+        if (strcmp(forced, "scalar") == 0) {
+            return TEXTCLASS_KERNEL_SCALAR;
+        }
+        if (strcmp(forced, "sse4") == 0 && best >= TEXTCLASS_KERNEL_SSE4) {
+            return TEXTCLASS_KERNEL_SSE4;
+        }
+    }
+    return best;
+}
+
+/* Обраний варіант; визначається при першому виклику */
+static inline TextClassKernel textclass_kernel(void) {
+    static int cached = -1;
+    int kernel = __atomic_load_n(&cached, __ATOMIC_RELAXED);
+    if (kernel < 0) {
+        kernel = (int)textclass_detect_kernel();
+        __atomic_store_n(&cached, kernel, __ATOMIC_RELAXED);
+    }
+    return (TextClassKernel)kernel;
+}
+
+static inline const char* textclass_kernel_name(TextClassKernel kernel) {
+    switch (kernel) {
+    case TEXTCLASS_KERNEL_AVX2: return "avx2";
+    case TEXTCLASS_KERNEL_SSE4: return "sse4";
+    case TEXTCLASS_KERNEL_SCALAR:
+    default: return "scalar";
+    }
+}
+
+/* Лічильники для окремого шматка без лівого контексту: шаблони рахуються
+ * лише там, де попередні байти лежать у самому шматку */
+static inline void textclass_scan(const unsigned char* data, size_t len, TextClassCounts* out) {
+    TextClassTables tables;
+    TextClassCarry carry = {0, 0, 0};
+    memset(out, 0, sizeof(*out));
+    textclass_tables(&tables);
+
+    switch (textclass_kernel()) {
+#ifdef TEXTCLASS_X86
+    case TEXTCLASS_KERNEL_AVX2:
+        textclass_scan_avx2(&tables, data, len, out, &carry);
+        break;
+    case TEXTCLASS_KERNEL_SSE4:
+        textclass_scan_sse4(&tables, data, len, out, &carry);
+        break;
+#endif
+    default:
+        textclass_scan_scalar(&tables, data, len, out, &carry);
+        break;
+    }
+}
+
+#endif
@@ -0,0 +1,255 @@
+#ifndef TEXTSCAN_H
+#define TEXTSCAN_H
+
+/*
+ * Статистика тексту, що зливається зі шматків (моноїд для chunkscan.h).
+ *
+ * Текст — UTF-8. Шматок зберігає кількість символів (кодових точок) і
+ * символів кожного класу (textclass.h: літери, цифри, пробіли,
+ * пунктуація...; поза ASCII — за Unicode, utf8class.h), з яких програма
+ * складає свої лічильники, і два шаблони на межах рядків:
+ *   початок слова   — !S[i] && S[i-1], де S — пробільний символ (isspace
+ *                     для ASCII, пробільні символи Unicode);
+ *   початок абзацу  — N[i-2] && N[i-1] && !N[i], де N — байт '\n', тобто
+ *                     непорожній рядок після порожнього.
+ * Шаблон, якому бракує попередніх символів, лишається відкритим, доки
+ * шматок не отримає лівий контекст під час злиття. Тому шматок пам'ятає
+ * перші 2 і останні 3 байти, чи пробільні його перший і останній
+ * символи, а також байти символу, розрізаного межею шматків (prefix і
+ * suffix, див. utf8class.h).
+ *
+ * Накопичувач усього файлу починається з textscan_init_prefix(): віртуальні
+ * байти перед файлом задають стан на його початку (наприклад "\n\n" —
+ * файл починається з нового абзацу), а textscan_finish() наприкінці
+ * рахує обрізану послідовність в останніх байтах файлу.
+ */
+
+#include <string.h>
+
+#include "chunkscan.h"
+#include "textclass.h"
+#include "utf8class.h"
+
+#define TEXTSCAN_HEAD 2
+#define TEXTSCAN_TAIL 3
+
+typedef struct {
+    unsigned long long size;
+    unsigned long long chars;         /* кодові точки */
+    unsigned long long classes[TEXTCLASS_COUNT];
+    unsigned long long word_starts;
+    unsigned long long paragraph_starts;
+    unsigned char head[TEXTSCAN_HEAD];
+    unsigned char tail[TEXTSCAN_TAIL];
+    int tail_len;                     /* разом із віртуальним префіксом */
+    int anchored;                     /* лівий контекст відомий */
+    unsigned char prefix[UTF8CLASS_MAX_SEQUENCE - 1];  /* продовження символу зліва */
+    int prefix_len;
+    unsigned char suffix[UTF8CLASS_MAX_SEQUENCE - 1];  /* незавершений символ у кінці */
+    int suffix_len;
+    int first_space;                  /* -1 — цілих символів ще немає */
+    int last_space;
+} TextChunk;
+
+static inline int textscan_is_space(unsigned char c) {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\v' || c == '\f' || c == '\r';
+}
+
+static inline void textscan_init(TextChunk* c) {
+    memset(c, 0, sizeof(*c));
+    c->first_space = -1;
+    c->last_space = -1;
+}
+
+/* Накопичувач для файлу: prefix — щонайменше 2 віртуальні байти перед початком */
+static inline void textscan_init_prefix(TextChunk* c, const char* prefix, int prefix_len) {
+    textscan_init(c);
+    c->anchored = 1;
+    int start = prefix_len > TEXTSCAN_TAIL ? prefix_len - TEXTSCAN_TAIL : 0;
+    for (int i = start; i < prefix_len; i++) {
+        c->tail[c->tail_len++] = (unsigned char)prefix[i];
+    }
+    c->first_space = textscan_is_space((unsigned char)prefix[prefix_len - 1]);
+    c->last_space = c->first_space;
+}
+
+/* Окремий шматок без лівого контексту: шаблони рахуються лише там, де
+ * попередні байти лежать у самому шматку */
+static inline void textscan_bytes(TextChunk* c, const unsigned char* data, size_t len) {
+    TextClassCounts counts;
+    Utf8ClassCounts wide;
+    textclass_scan(data, len, &counts);
+    utf8class_scan(data, len, &wide);
+    for (int k = 0; k < TEXTCLASS_COUNT; k++) {
+        c->classes[k] += counts.counts[k] + wide.counts[k];
+    }
+    c->chars += wide.chars;
+    c->word_starts += (unsigned long long)((long long)counts.word_starts + wide.word_starts);
+    c->paragraph_starts += counts.paragraph_starts;
+    memcpy(c->prefix, data, (size_t)wide.prefix_len);
+    c->prefix_len = wide.prefix_len;
+    memcpy(c->suffix, data + len - wide.suffix_len, (size_t)wide.suffix_len);
+    c->suffix_len = wide.suffix_len;
+    c->first_space = wide.first_space;
+    c->last_space = wide.last_space;
+
+    c->size += len;
+    for (size_t i = 0; i < len && i < TEXTSCAN_HEAD; i++) {
+        c->head[i] = data[i];
+    }
+    size_t tail = len < TEXTSCAN_TAIL ? len : TEXTSCAN_TAIL;
+    memcpy(c->tail, data + len - tail, tail);
+    c->tail_len = (int)tail;
+}
+
+/* Символи з байтів на межі шматків, дописані в кінець acc */
+static inline void textscan_cut_chars(TextChunk* acc, const unsigned char* cut, int n) {
+    for (int i = 0; i < n;) {
+        unsigned bits;
+        int len = utf8class_decode(cut + i, (size_t)(n - i), &bits);
+        int space = (bits >> TEXTCLASS_SPACE) & 1;
+        for (int k = 0; k < TEXTCLASS_COUNT; k++) {
+            acc->classes[k] += (bits >> k) & 1;
+        }
+        acc->chars++;
+        if (acc->last_space >= 0) {
+            acc->word_starts += !space && acc->last_space;
+        } else {
+            acc->first_space = space;
+        }
+        acc->last_space = space;
+        i += len;
+    }
+}
+
+/* Символ, розрізаний межею: suffix acc разом із prefix next. Решта
+ * символів next уже порахована, лишається початок слова на першому. */
+static inline void textscan_merge_cut(TextChunk* acc, const TextChunk* next) {
+    int from = 0;
+    if (!acc->anchored && acc->first_space < 0 && acc->suffix_len == 0) {
+        /* acc — лише байти продовження: prefix next подовжує його prefix */
+        while (acc->prefix_len < UTF8CLASS_MAX_SEQUENCE - 1 && from < next->prefix_len) {
+            acc->prefix[acc->prefix_len++] = next->prefix[from++];
+        }
+    }
+    unsigned char cut[2 * (UTF8CLASS_MAX_SEQUENCE - 1)];
+    int n = acc->suffix_len;
+    memcpy(cut, acc->suffix, (size_t)n);
+    memcpy(cut + n, next->prefix + from, (size_t)(next->prefix_len - from));
+    n += next->prefix_len - from;
+
+    /* next — лише продовження, і послідовності ще бракує байтів */
+    if (next->first_space < 0 && next->suffix_len == 0 && acc->suffix_len > 0 &&
+        n < utf8class_length(cut[0])) {
+        memcpy(acc->suffix, cut, (size_t)n);
+        acc->suffix_len = n;
+        return;
+    }
+    textscan_cut_chars(acc, cut, n);
+    if (next->first_space >= 0) {
+        if (acc->last_space >= 0) {
+            acc->word_starts += !next->first_space && acc->last_space;
+        } else {
+            acc->first_space = next->first_space;
+        }
+        acc->last_space = next->last_space;
+    }
+    memcpy(acc->suffix, next->suffix, (size_t)next->suffix_len);
+    acc->suffix_len = next->suffix_len;
+}
+
+/* acc = acc · next */
+static inline void textscan_merge(TextChunk* acc, const TextChunk* next) {
+    if (next->size == 0) {
+        return;
+    }
+    if (acc->size == 0 && !acc->anchored) {
+        *acc = *next;
+        return;
+    }
+
+    /* Вікно: останні байти acc, далі перші байти next */
+    unsigned char window[TEXTSCAN_TAIL + TEXTSCAN_HEAD];
+    int tl = acc->tail_len;
+    int hl = next->size < TEXTSCAN_HEAD ? (int)next->size : TEXTSCAN_HEAD;
+    memcpy(window, acc->tail, (size_t)tl);
+    memcpy(window + tl, next->head, (size_t)hl);
+
+    for (int j = 0; j < hl; j++) {
+        int p = tl + j;
+        unsigned long long at = acc->size + (unsigned long long)j;
+        /* next лишив відкритими абзац у позиціях 0 і 1 (початок слова — на
+         * першому цілому символі, див. textscan_merge_cut) */
+        if (acc->anchored || at >= 2) {
+            acc->paragraph_starts += window[p - 2] == '\n' && window[p - 1] == '\n' && window[p] != '\n';
+        }
+    }
+
+    textscan_merge_cut(acc, next);
+    for (int k = 0; k < TEXTCLASS_COUNT; k++) {
+        acc->classes[k] += next->classes[k];
+    }
+    acc->chars += next->chars;
+    acc->word_starts += next->word_starts;
+    acc->paragraph_starts += next->paragraph_starts;
+
+    if (acc->size < TEXTSCAN_HEAD) {
+        for (int j = (int)acc->size, k = 0; j < TEXTSCAN_HEAD && k < hl; j++, k++) {
+            acc->head[j] = next->head[k];
+        }
+    }
+
+    if (next->tail_len == TEXTSCAN_TAIL) {
+        memcpy(acc->tail, next->tail, TEXTSCAN_TAIL);
+        acc->tail_len = TEXTSCAN_TAIL;
+    } else {
+        unsigned char joined[2 * TEXTSCAN_TAIL];
+        memcpy(joined, acc->tail, (size_t)acc->tail_len);
+        memcpy(joined + acc->tail_len, next->tail, (size_t)next->tail_len);
+        int total = acc->tail_len + next->tail_len;
+        int keep = total < TEXTSCAN_TAIL ? total : TEXTSCAN_TAIL;
+        memcpy(acc->tail, joined + total - keep, (size_t)keep);
+        acc->tail_len = keep;
+    }
+
+    acc->size += next->size;
+}
+
+/* Кінець файлу: обрізана послідовність — окремі некоректні байти */
+static inline void textscan_finish(TextChunk* c) {
+    textscan_cut_chars(c, c->suffix, c->suffix_len);
+    c->suffix_len = 0;
+}
+
+/* Останній байт файлу (з урахуванням префікса), або -1 */
+static inline int textscan_tail_byte(const TextChunk* c, int from_end) {
+    return from_end <= c->tail_len ? c->tail[c->tail_len - from_end] : -1;
+}
+
+/* Кількість рядків так, як їх бачать fgets/getline: останній рядок без
+ * '\n' теж рахується */
+static inline unsigned long long textscan_lines(const TextChunk* c) {
+    unsigned long long lines = c->classes[TEXTCLASS_NEWLINE];
+    if (c->size > 0 && textscan_tail_byte(c, 1) != '\n') {
+        lines++;
+    }
+    return lines;
+}
+
+static inline void textscan_op_init(void* state) {
+    textscan_init((TextChunk*)state);
+}
+
+static inline void textscan_op_scan(void* state, const unsigned char* data, size_t len) {
+    textscan_bytes((TextChunk*)state, data, len);
+}
+
+static inline void textscan_op_merge(void* acc, const void* next) {
+    textscan_merge((TextChunk*)acc, (const TextChunk*)next);
+}
+
+static const ChunkScanOps textscan_ops = {
+    sizeof(TextChunk), textscan_op_init, textscan_op_scan, textscan_op_merge
+};
+
+#endif
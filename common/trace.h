@@ -0,0 +1,287 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+/*
+ * Трасування виконання у форматі Chrome trace JSON (відкривається у Perfetto
+ * або chrome://tracing). Вмикається змінною середовища TRACE_FILE=шлях.json,
+ * без неї кожен виклик зводиться до однієї перевірки.
+ *
+ * Кожен потік пише лише у власний кільцевий буфер (без блокувань); буфери
+ * реєструються у глобальному списку атомарною вставкою і записуються у файл
+ * при завершенні програми. При переповненні найстаріші події перезаписуються.
+ * Буфер завершеного потоку (зі своїми подіями) переходить до наступного
+ * нового потоку, тож пул, що запускає потоки знову й знову, не множить
+ * буфери; після запису файлу всі вони звільняються.
+ *
+ * Заголовок придатний і для C (lab1), і для C++.
+ */
+
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#define TRACE_RING_SIZE 4096
+#define TRACE_DETAIL_LEN 48
+#define TRACE_NO_ARG (-1LL)
+
+typedef struct {
+    const char* name;
+    uint64_t start_ns;
+    uint64_t dur_ns;
+    long long arg;
+    char detail[TRACE_DETAIL_LEN];
+} TraceEvent;
+
+typedef struct TraceBuffer {
+    struct TraceBuffer* next;
+    int tid;
+    int in_use;        /* 0 — потік завершився, буфер вільний */
+    uint64_t head;
+    TraceEvent events[TRACE_RING_SIZE];
+} TraceBuffer;
+
+static int trace_enabled_flag = 0;
+static const char* trace_path = NULL;
+static uint64_t trace_origin_ns = 0;
+static TraceBuffer* trace_buffers = NULL;
+static int trace_next_tid = 1;
+static __thread TraceBuffer* trace_local = NULL;
+static pthread_key_t trace_key;
+static int trace_key_ready = 0;
+
+static inline uint64_t trace_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static inline int trace_enabled(void) {
+    return __atomic_load_n(&trace_enabled_flag, __ATOMIC_RELAXED);
+}
+
+/* Деструктор ключа потоку: буфер лишається у списку з подіями, але його
+ * може взяти інший потік */
+static inline void trace_release_buffer(void* arg) {
+    __atomic_store_n(&((TraceBuffer*)arg)->in_use, 0, __ATOMIC_RELEASE);
+}
+
+static inline TraceBuffer* trace_thread_buffer(void) {
+    if (trace_local != NULL) {
+        return trace_local;
+    }
+
+    TraceBuffer* buf;
+    for (buf = __atomic_load_n(&trace_buffers, __ATOMIC_ACQUIRE); buf != NULL; buf = buf->next) {
+        int expected = 0;
+        if (__atomic_compare_exchange_n(&buf->in_use, &expected, 1, 0,
+                                        __ATOMIC_ACQUIRE, __ATOMIC_RELAXED)) {
+            break;
+        }
+    }
+    if (buf == NULL) {
+        buf = (TraceBuffer*)calloc(1, sizeof(TraceBuffer));
+        if (buf == NULL) {
+            return NULL;
+        }
+        buf->tid = __atomic_fetch_add(&trace_next_tid, 1, __ATOMIC_RELAXED);
+        buf->in_use = 1;
+
+        TraceBuffer* head = __atomic_load_n(&trace_buffers, __ATOMIC_ACQUIRE);
+        do {
+            buf->next = head;
+        } while (!__atomic_compare_exchange_n(&trace_buffers, &head, buf, 1,
+                                              __ATOMIC_RELEASE, __ATOMIC_ACQUIRE));
+    }
+    if (trace_key_ready) {
+        pthread_setspecific(trace_key, buf);
+    }
+    trace_local = buf;
+    return buf;
+}
+
+/* Мітка початку інтервалу; 0, якщо трасування вимкнене. */
+static inline uint64_t trace_begin(void) {
+    return trace_enabled() ? trace_now_ns() : 0;
+}
+
+/* Закриває інтервал, розпочатий trace_begin(). detail може бути NULL. */
+static inline void trace_end_detail(const char* name, uint64_t start_ns,
+                                    const char* detail, long long arg) {
+    if (!trace_enabled()) {
+        return;
+    }
+
+    uint64_t end_ns = trace_now_ns();
+    TraceBuffer* buf = trace_thread_buffer();
+    if (buf == NULL) {
+        return;
+    }
+
+    uint64_t index = buf->head;
+    TraceEvent* ev = &buf->events[index & (TRACE_RING_SIZE - 1)];
+    ev->name = name;
+    ev->start_ns = start_ns;
+    ev->dur_ns = end_ns - start_ns;
+    ev->arg = arg;
+    if (detail != NULL) {
+        strncpy(ev->detail, detail, TRACE_DETAIL_LEN - 1);
+        ev->detail[TRACE_DETAIL_LEN - 1] = '\0';
+        if (strlen(detail) >= TRACE_DETAIL_LEN) {
+            /* не лишати обрізаної послідовності UTF-8 */
+            size_t len = TRACE_DETAIL_LEN - 1;
+            size_t cut = len;
+            while (cut > 0 && ((unsigned char)ev->detail[cut - 1] & 0xC0) == 0x80) {
+                cut--;
+            }
+            if (cut > 0 && ((unsigned char)ev->detail[cut - 1] & 0x80) != 0) {
+                unsigned char lead = (unsigned char)ev->detail[cut - 1];
+                size_t need = lead >= 0xF0 ? 4 : lead >= 0xE0 ? 3 : 2;
+                if (len - (cut - 1) < need) {
+                    ev->detail[cut - 1] = '\0';
+                }
+            }
+        }
+    } else {
+        ev->detail[0] = '\0';
+    }
+    __atomic_store_n(&buf->head, index + 1, __ATOMIC_RELEASE);
+}
+
+static inline void trace_end(const char* name, uint64_t start_ns) {
+    trace_end_detail(name, start_ns, NULL, TRACE_NO_ARG);
+}
+
+static inline void trace_write_json_string(FILE* out, const char* s) {
+    fputc('"', out);
+    for (; *s != '\0'; s++) {
+        unsigned char c = (unsigned char)*s;
+        if (c == '"' || c == '\\') {
+            fputc('\\', out);
+            fputc(c, out);
+        } else if (c < 0x20) {
+            fprintf(out, "\\u%04x", c);
+        } else {
+            fputc(c, out);
+        }
+    }
+    fputc('"', out);
+}
+
+/* Звільняє буфери; трасування на цей час уже вимкнене. */
+static inline void trace_free_buffers(void) {
+    TraceBuffer* buf = __atomic_exchange_n(&trace_buffers, NULL, __ATOMIC_ACQ_REL);
+    while (buf != NULL) {
+        TraceBuffer* next = buf->next;
+        free(buf);
+        buf = next;
+    }
+    trace_local = NULL;
+    if (trace_key_ready) {
+        pthread_setspecific(trace_key, NULL);
+        pthread_key_delete(trace_key);
+        trace_key_ready = 0;
+    }
+}
+
+/* Записує всі зібрані події; викликається автоматично через atexit. */
+static inline void trace_flush(void) {
+    if (!trace_enabled() || trace_path == NULL) {
+        return;
+    }
+    __atomic_store_n(&trace_enabled_flag, 0, __ATOMIC_RELAXED);
+
+    FILE* out = fopen(trace_path, "w");
+    if (out == NULL) {
+        fprintf(stderr, "Не вдається створити файл трасування: %s\n", trace_path);
+        trace_free_buffers();
+        return;
+    }
+
+    int pid = (int)getpid();
+    int first = 1;
+    fprintf(out, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+
+    for (TraceBuffer* buf = __atomic_load_n(&trace_buffers, __ATOMIC_ACQUIRE);
+         buf != NULL; buf = buf->next) {
+        uint64_t head = __atomic_load_n(&buf->head, __ATOMIC_ACQUIRE);
+        uint64_t begin = head > TRACE_RING_SIZE ? head - TRACE_RING_SIZE : 0;
+
+        fprintf(out, "%s{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":%d,\"tid\":%d,"
+                "\"args\":{\"name\":\"потік %d\"}}", first ? "" : ",\n", pid, buf->tid, buf->tid);
+        first = 0;
+        if (begin > 0) {
+            fprintf(out, ",\n{\"ph\":\"i\",\"s\":\"t\",\"name\":\"втрачено подій: %llu\","
+                    "\"pid\":%d,\"tid\":%d,\"ts\":0}", (unsigned long long)begin, pid, buf->tid);
+        }
+
+        for (uint64_t i = begin; i < head; i++) {
+            const TraceEvent* ev = &buf->events[i & (TRACE_RING_SIZE - 1)];
+            fprintf(out, ",\n{\"ph\":\"X\",\"name\":");
+            trace_write_json_string(out, ev->name);
+            fprintf(out, ",\"pid\":%d,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f",
+                    pid, buf->tid,
+                    (double)(ev->start_ns - trace_origin_ns) / 1000.0,
+                    (double)ev->dur_ns / 1000.0);
+            if (ev->detail[0] != '\0' || ev->arg != TRACE_NO_ARG) {
+                fprintf(out, ",\"args\":{");
+                if (ev->detail[0] != '\0') {
+                    fprintf(out, "\"detail\":");
+                    trace_write_json_string(out, ev->detail);
+                }
+                if (ev->arg != TRACE_NO_ARG) {
+                    fprintf(out, "%s\"value\":%lld", ev->detail[0] != '\0' ? "," : "", ev->arg);
+                }
+                fputc('}', out);
+            }
+            fputc('}', out);
+        }
+    }
+
+    fprintf(out, "\n]}\n");
+    fclose(out);
+    fprintf(stderr, "Трасу записано у файл: %s\n", trace_path);
+    trace_free_buffers();
+}
+
+/* Викликається на початку main(), поки працює лише один потік. */
+static inline void trace_init(void) {
+    const char* path = getenv("TRACE_FILE");
+    if (path == NULL || path[0] == '\0' || trace_path != NULL) {
+        return;
+    }
+    trace_path = path;
+    trace_origin_ns = trace_now_ns();
+    trace_key_ready = pthread_key_create(&trace_key, trace_release_buffer) == 0;
+    __atomic_store_n(&trace_enabled_flag, 1, __ATOMIC_RELAXED);
+    atexit(trace_flush);
+}
+
+#ifdef __cplusplus
+/* Інтервал на час життя об'єкта. */
+class TraceScope {
+public:
+    explicit TraceScope(const char* name, const char* detail = NULL, long long arg = TRACE_NO_ARG)
+        : name_(name), detail_(detail), arg_(arg), start_(trace_begin()) {}
+
+    ~TraceScope() {
+        if (start_ != 0) {
+            trace_end_detail(name_, start_, detail_, arg_);
+        }
+    }
+
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+
+private:
+    const char* name_;
+    const char* detail_;
+    long long arg_;
+    uint64_t start_;
+};
+#endif
+
+#endif
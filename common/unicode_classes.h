@@ -0,0 +1,404 @@
+#ifndef UNICODE_CLASSES_H
+#define UNICODE_CLASSES_H
+
+/*
+ * Класи символів Unicode 14.0.0 поза ASCII (біти TextClass).
+ * Згенеровано gen_unicode_classes.py, вручну не редагувати.
+ */
+
+#include <stdint.h>
+
+typedef struct {
+    uint32_t first;
+    uint32_t last;
+    unsigned char bits;
+} UnicodeClassRange;
+
+/* U+0080..U+07FF (двобайтові послідовності): напряму за кодом */
+static const unsigned char unicode_class_2byte[0x800 - 0x80] = {
+    0, 0, 0, 0, 0, 4, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    4, 40, 8, 8, 8, 8, 8, 40, 8, 8, 1, 40, 8, 0, 8, 8,
+    8, 8, 0, 0, 8, 1, 40, 40, 8, 0, 1, 40, 0, 0, 0, 40,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 8, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 8, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 8, 8, 8, 8, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8,
+    1, 1, 1, 1, 1, 8, 8, 8, 8, 8, 8, 8, 1, 8, 1, 8,
+    8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    1, 1, 1, 1, 1, 8, 1, 1, 0, 0, 1, 1, 1, 1, 40, 1,
+    0, 0, 0, 0, 8, 8, 1, 40, 1, 1, 1, 0, 1, 0, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 0, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 8, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 8, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    0, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 0, 0, 1, 40, 40, 40, 40, 40, 40,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 40, 40, 0, 0, 8, 8, 8,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 40, 0,
+    40, 0, 0, 40, 0, 0, 40, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 0, 0, 0, 0, 1,
+    1, 1, 1, 40, 40, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 8, 8, 8, 40, 40, 8, 40, 40, 8, 8,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 40, 0, 40, 40, 40,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 40, 40, 40, 40, 1, 1,
+    0, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 40, 1, 0, 0, 0, 0, 0, 0, 0, 0, 8, 0,
+    0, 0, 0, 0, 0, 1, 1, 0, 0, 8, 0, 0, 0, 0, 1, 1,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 1, 1, 1, 8, 8, 1,
+    40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 0, 0,
+    1, 0, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 1, 1, 8, 40, 40, 40, 1, 0, 0, 0, 8, 8,
+};
+
+/* Від U+0800: відсортовані непорожні діапазони, решта — без класу */
+static const UnicodeClassRange unicode_class_ranges[] = {
+    {0x0800, 0x0815, 1}, {0x081A, 0x081A, 1}, {0x0824, 0x0824, 1}, {0x0828, 0x0828, 1},
+    {0x0830, 0x083E, 40}, {0x0840, 0x0858, 1}, {0x085E, 0x085E, 40}, {0x0860, 0x086A, 1},
+    {0x0870, 0x0887, 1}, {0x0888, 0x0888, 8}, {0x0889, 0x088E, 1}, {0x08A0, 0x08C9, 1},
+    {0x0904, 0x0939, 1}, {0x093D, 0x093D, 1}, {0x0950, 0x0950, 1}, {0x0958, 0x0961, 1},
+    {0x0964, 0x0965, 40}, {0x0966, 0x096F, 2}, {0x0970, 0x0970, 40}, {0x0971, 0x0980, 1},
+    {0x0985, 0x098C, 1}, {0x098F, 0x0990, 1}, {0x0993, 0x09A8, 1}, {0x09AA, 0x09B0, 1},
+    {0x09B2, 0x09B2, 1}, {0x09B6, 0x09B9, 1}, {0x09BD, 0x09BD, 1}, {0x09CE, 0x09CE, 1},
+    {0x09DC, 0x09DD, 1}, {0x09DF, 0x09E1, 1}, {0x09E6, 0x09EF, 2}, {0x09F0, 0x09F1, 1},
+    {0x09F2, 0x09F3, 8}, {0x09FA, 0x09FB, 8}, {0x09FC, 0x09FC, 1}, {0x09FD, 0x09FD, 40},
+    {0x0A05, 0x0A0A, 1}, {0x0A0F, 0x0A10, 1}, {0x0A13, 0x0A28, 1}, {0x0A2A, 0x0A30, 1},
+    {0x0A32, 0x0A33, 1}, {0x0A35, 0x0A36, 1}, {0x0A38, 0x0A39, 1}, {0x0A59, 0x0A5C, 1},
+    {0x0A5E, 0x0A5E, 1}, {0x0A66, 0x0A6F, 2}, {0x0A72, 0x0A74, 1}, {0x0A76, 0x0A76, 40},
+    {0x0A85, 0x0A8D, 1}, {0x0A8F, 0x0A91, 1}, {0x0A93, 0x0AA8, 1}, {0x0AAA, 0x0AB0, 1},
+    {0x0AB2, 0x0AB3, 1}, {0x0AB5, 0x0AB9, 1}, {0x0ABD, 0x0ABD, 1}, {0x0AD0, 0x0AD0, 1},
+    {0x0AE0, 0x0AE1, 1}, {0x0AE6, 0x0AEF, 2}, {0x0AF0, 0x0AF0, 40}, {0x0AF1, 0x0AF1, 8},
+    {0x0AF9, 0x0AF9, 1}, {0x0B05, 0x0B0C, 1}, {0x0B0F, 0x0B10, 1}, {0x0B13, 0x0B28, 1},
+    {0x0B2A, 0x0B30, 1}, {0x0B32, 0x0B33, 1}, {0x0B35, 0x0B39, 1}, {0x0B3D, 0x0B3D, 1},
+    {0x0B5C, 0x0B5D, 1}, {0x0B5F, 0x0B61, 1}, {0x0B66, 0x0B6F, 2}, {0x0B70, 0x0B70, 8},
+    {0x0B71, 0x0B71, 1}, {0x0B83, 0x0B83, 1}, {0x0B85, 0x0B8A, 1}, {0x0B8E, 0x0B90, 1},
+    {0x0B92, 0x0B95, 1}, {0x0B99, 0x0B9A, 1}, {0x0B9C, 0x0B9C, 1}, {0x0B9E, 0x0B9F, 1},
+    {0x0BA3, 0x0BA4, 1}, {0x0BA8, 0x0BAA, 1}, {0x0BAE, 0x0BB9, 1}, {0x0BD0, 0x0BD0, 1},
+    {0x0BE6, 0x0BEF, 2}, {0x0BF3, 0x0BFA, 8}, {0x0C05, 0x0C0C, 1}, {0x0C0E, 0x0C10, 1},
+    {0x0C12, 0x0C28, 1}, {0x0C2A, 0x0C39, 1}, {0x0C3D, 0x0C3D, 1}, {0x0C58, 0x0C5A, 1},
+    {0x0C5D, 0x0C5D, 1}, {0x0C60, 0x0C61, 1}, {0x0C66, 0x0C6F, 2}, {0x0C77, 0x0C77, 40},
+    {0x0C7F, 0x0C7F, 8}, {0x0C80, 0x0C80, 1}, {0x0C84, 0x0C84, 40}, {0x0C85, 0x0C8C, 1},
+    {0x0C8E, 0x0C90, 1}, {0x0C92, 0x0CA8, 1}, {0x0CAA, 0x0CB3, 1}, {0x0CB5, 0x0CB9, 1},
+    {0x0CBD, 0x0CBD, 1}, {0x0CDD, 0x0CDE, 1}, {0x0CE0, 0x0CE1, 1}, {0x0CE6, 0x0CEF, 2},
+    {0x0CF1, 0x0CF2, 1}, {0x0D04, 0x0D0C, 1}, {0x0D0E, 0x0D10, 1}, {0x0D12, 0x0D3A, 1},
+    {0x0D3D, 0x0D3D, 1}, {0x0D4E, 0x0D4E, 1}, {0x0D4F, 0x0D4F, 8}, {0x0D54, 0x0D56, 1},
+    {0x0D5F, 0x0D61, 1}, {0x0D66, 0x0D6F, 2}, {0x0D79, 0x0D79, 8}, {0x0D7A, 0x0D7F, 1},
+    {0x0D85, 0x0D96, 1}, {0x0D9A, 0x0DB1, 1}, {0x0DB3, 0x0DBB, 1}, {0x0DBD, 0x0DBD, 1},
+    {0x0DC0, 0x0DC6, 1}, {0x0DE6, 0x0DEF, 2}, {0x0DF4, 0x0DF4, 40}, {0x0E01, 0x0E30, 1},
+    {0x0E32, 0x0E33, 1}, {0x0E3F, 0x0E3F, 8}, {0x0E40, 0x0E46, 1}, {0x0E4F, 0x0E4F, 40},
+    {0x0E50, 0x0E59, 2}, {0x0E5A, 0x0E5B, 40}, {0x0E81, 0x0E82, 1}, {0x0E84, 0x0E84, 1},
+    {0x0E86, 0x0E8A, 1}, {0x0E8C, 0x0EA3, 1}, {0x0EA5, 0x0EA5, 1}, {0x0EA7, 0x0EB0, 1},
+    {0x0EB2, 0x0EB3, 1}, {0x0EBD, 0x0EBD, 1}, {0x0EC0, 0x0EC4, 1}, {0x0EC6, 0x0EC6, 1},
+    {0x0ED0, 0x0ED9, 2}, {0x0EDC, 0x0EDF, 1}, {0x0F00, 0x0F00, 1}, {0x0F01, 0x0F03, 8},
+    {0x0F04, 0x0F12, 40}, {0x0F13, 0x0F13, 8}, {0x0F14, 0x0F14, 40}, {0x0F15, 0x0F17, 8},
+    {0x0F1A, 0x0F1F, 8}, {0x0F20, 0x0F29, 2}, {0x0F34, 0x0F34, 8}, {0x0F36, 0x0F36, 8},
+    {0x0F38, 0x0F38, 8}, {0x0F3A, 0x0F3D, 40}, {0x0F40, 0x0F47, 1}, {0x0F49, 0x0F6C, 1},
+    {0x0F85, 0x0F85, 40}, {0x0F88, 0x0F8C, 1}, {0x0FBE, 0x0FC5, 8}, {0x0FC7, 0x0FCC, 8},
+    {0x0FCE, 0x0FCF, 8}, {0x0FD0, 0x0FD4, 40}, {0x0FD5, 0x0FD8, 8}, {0x0FD9, 0x0FDA, 40},
+    {0x1000, 0x102A, 1}, {0x103F, 0x103F, 1}, {0x1040, 0x1049, 2}, {0x104A, 0x104F, 40},
+    {0x1050, 0x1055, 1}, {0x105A, 0x105D, 1}, {0x1061, 0x1061, 1}, {0x1065, 0x1066, 1},
+    {0x106E, 0x1070, 1}, {0x1075, 0x1081, 1}, {0x108E, 0x108E, 1}, {0x1090, 0x1099, 2},
+    {0x109E, 0x109F, 8}, {0x10A0, 0x10C5, 1}, {0x10C7, 0x10C7, 1}, {0x10CD, 0x10CD, 1},
+    {0x10D0, 0x10FA, 1}, {0x10FB, 0x10FB, 40}, {0x10FC, 0x1248, 1}, {0x124A, 0x124D, 1},
+    {0x1250, 0x1256, 1}, {0x1258, 0x1258, 1}, {0x125A, 0x125D, 1}, {0x1260, 0x1288, 1},
+    {0x128A, 0x128D, 1}, {0x1290, 0x12B0, 1}, {0x12B2, 0x12B5, 1}, {0x12B8, 0x12BE, 1},
+    {0x12C0, 0x12C0, 1}, {0x12C2, 0x12C5, 1}, {0x12C8, 0x12D6, 1}, {0x12D8, 0x1310, 1},
+    {0x1312, 0x1315, 1}, {0x1318, 0x135A, 1}, {0x1360, 0x1368, 40}, {0x1380, 0x138F, 1},
+    {0x1390, 0x1399, 8}, {0x13A0, 0x13F5, 1}, {0x13F8, 0x13FD, 1}, {0x1400, 0x1400, 40},
+    {0x1401, 0x166C, 1}, {0x166D, 0x166D, 8}, {0x166E, 0x166E, 40}, {0x166F, 0x167F, 1},
+    {0x1680, 0x1680, 4}, {0x1681, 0x169A, 1}, {0x169B, 0x169C, 40}, {0x16A0, 0x16EA, 1},
+    {0x16EB, 0x16ED, 40}, {0x16F1, 0x16F8, 1}, {0x1700, 0x1711, 1}, {0x171F, 0x1731, 1},
+    {0x1735, 0x1736, 40}, {0x1740, 0x1751, 1}, {0x1760, 0x176C, 1}, {0x176E, 0x1770, 1},
+    {0x1780, 0x17B3, 1}, {0x17D4, 0x17D6, 40}, {0x17D7, 0x17D7, 1}, {0x17D8, 0x17DA, 40},
+    {0x17DB, 0x17DB, 8}, {0x17DC, 0x17DC, 1}, {0x17E0, 0x17E9, 2}, {0x1800, 0x180A, 40},
+    {0x1810, 0x1819, 2}, {0x1820, 0x1878, 1}, {0x1880, 0x1884, 1}, {0x1887, 0x18A8, 1},
+    {0x18AA, 0x18AA, 1}, {0x18B0, 0x18F5, 1}, {0x1900, 0x191E, 1}, {0x1940, 0x1940, 8},
+    {0x1944, 0x1945, 40}, {0x1946, 0x194F, 2}, {0x1950, 0x196D, 1}, {0x1970, 0x1974, 1},
+    {0x1980, 0x19AB, 1}, {0x19B0, 0x19C9, 1}, {0x19D0, 0x19D9, 2}, {0x19DE, 0x19FF, 8},
+    {0x1A00, 0x1A16, 1}, {0x1A1E, 0x1A1F, 40}, {0x1A20, 0x1A54, 1}, {0x1A80, 0x1A89, 2},
+    {0x1A90, 0x1A99, 2}, {0x1AA0, 0x1AA6, 40}, {0x1AA7, 0x1AA7, 1}, {0x1AA8, 0x1AAD, 40},
+    {0x1B05, 0x1B33, 1}, {0x1B45, 0x1B4C, 1}, {0x1B50, 0x1B59, 2}, {0x1B5A, 0x1B60, 40},
+    {0x1B61, 0x1B6A, 8}, {0x1B74, 0x1B7C, 8}, {0x1B7D, 0x1B7E, 40}, {0x1B83, 0x1BA0, 1},
+    {0x1BAE, 0x1BAF, 1}, {0x1BB0, 0x1BB9, 2}, {0x1BBA, 0x1BE5, 1}, {0x1BFC, 0x1BFF, 40},
+    {0x1C00, 0x1C23, 1}, {0x1C3B, 0x1C3F, 40}, {0x1C40, 0x1C49, 2}, {0x1C4D, 0x1C4F, 1},
+    {0x1C50, 0x1C59, 2}, {0x1C5A, 0x1C7D, 1}, {0x1C7E, 0x1C7F, 40}, {0x1C80, 0x1C88, 1},
+    {0x1C90, 0x1CBA, 1}, {0x1CBD, 0x1CBF, 1}, {0x1CC0, 0x1CC7, 40}, {0x1CD3, 0x1CD3, 40},
+    {0x1CE9, 0x1CEC, 1}, {0x1CEE, 0x1CF3, 1}, {0x1CF5, 0x1CF6, 1}, {0x1CFA, 0x1CFA, 1},
+    {0x1D00, 0x1DBF, 1}, {0x1E00, 0x1F15, 1}, {0x1F18, 0x1F1D, 1}, {0x1F20, 0x1F45, 1},
+    {0x1F48, 0x1F4D, 1}, {0x1F50, 0x1F57, 1}, {0x1F59, 0x1F59, 1}, {0x1F5B, 0x1F5B, 1},
+    {0x1F5D, 0x1F5D, 1}, {0x1F5F, 0x1F7D, 1}, {0x1F80, 0x1FB4, 1}, {0x1FB6, 0x1FBC, 1},
+    {0x1FBD, 0x1FBD, 8}, {0x1FBE, 0x1FBE, 1}, {0x1FBF, 0x1FC1, 8}, {0x1FC2, 0x1FC4, 1},
+    {0x1FC6, 0x1FCC, 1}, {0x1FCD, 0x1FCF, 8}, {0x1FD0, 0x1FD3, 1}, {0x1FD6, 0x1FDB, 1},
+    {0x1FDD, 0x1FDF, 8}, {0x1FE0, 0x1FEC, 1}, {0x1FED, 0x1FEF, 8}, {0x1FF2, 0x1FF4, 1},
+    {0x1FF6, 0x1FFC, 1}, {0x1FFD, 0x1FFE, 8}, {0x2000, 0x200A, 4}, {0x2010, 0x2027, 40},
+    {0x2028, 0x2029, 4}, {0x202F, 0x202F, 4}, {0x2030, 0x2043, 40}, {0x2044, 0x2044, 8},
+    {0x2045, 0x2051, 40}, {0x2052, 0x2052, 8}, {0x2053, 0x205E, 40}, {0x205F, 0x205F, 4},
+    {0x2071, 0x2071, 1}, {0x207A, 0x207C, 8}, {0x207D, 0x207E, 40}, {0x207F, 0x207F, 1},
+    {0x208A, 0x208C, 8}, {0x208D, 0x208E, 40}, {0x2090, 0x209C, 1}, {0x20A0, 0x20C0, 8},
+    {0x2100, 0x2101, 8}, {0x2102, 0x2102, 1}, {0x2103, 0x2106, 8}, {0x2107, 0x2107, 1},
+    {0x2108, 0x2109, 8}, {0x210A, 0x2113, 1}, {0x2114, 0x2114, 8}, {0x2115, 0x2115, 1},
+    {0x2116, 0x2118, 8}, {0x2119, 0x211D, 1}, {0x211E, 0x2123, 8}, {0x2124, 0x2124, 1},
+    {0x2125, 0x2125, 8}, {0x2126, 0x2126, 1}, {0x2127, 0x2127, 8}, {0x2128, 0x2128, 1},
+    {0x2129, 0x2129, 8}, {0x212A, 0x212D, 1}, {0x212E, 0x212E, 8}, {0x212F, 0x2139, 1},
+    {0x213A, 0x213B, 8}, {0x213C, 0x213F, 1}, {0x2140, 0x2144, 8}, {0x2145, 0x2149, 1},
+    {0x214A, 0x214D, 8}, {0x214E, 0x214E, 1}, {0x214F, 0x214F, 8}, {0x2183, 0x2184, 1},
+    {0x218A, 0x218B, 8}, {0x2190, 0x2307, 8}, {0x2308, 0x230B, 40}, {0x230C, 0x2328, 8},
+    {0x2329, 0x232A, 40}, {0x232B, 0x2426, 8}, {0x2440, 0x244A, 8}, {0x249C, 0x24E9, 8},
+    {0x2500, 0x2767, 8}, {0x2768, 0x2775, 40}, {0x2794, 0x27C4, 8}, {0x27C5, 0x27C6, 40},
+    {0x27C7, 0x27E5, 8}, {0x27E6, 0x27EF, 40}, {0x27F0, 0x2982, 8}, {0x2983, 0x2998, 40},
+    {0x2999, 0x29D7, 8}, {0x29D8, 0x29DB, 40}, {0x29DC, 0x29FB, 8}, {0x29FC, 0x29FD, 40},
+    {0x29FE, 0x2B73, 8}, {0x2B76, 0x2B95, 8}, {0x2B97, 0x2BFF, 8}, {0x2C00, 0x2CE4, 1},
+    {0x2CE5, 0x2CEA, 8}, {0x2CEB, 0x2CEE, 1}, {0x2CF2, 0x2CF3, 1}, {0x2CF9, 0x2CFC, 40},
+    {0x2CFE, 0x2CFF, 40}, {0x2D00, 0x2D25, 1}, {0x2D27, 0x2D27, 1}, {0x2D2D, 0x2D2D, 1},
+    {0x2D30, 0x2D67, 1}, {0x2D6F, 0x2D6F, 1}, {0x2D70, 0x2D70, 40}, {0x2D80, 0x2D96, 1},
+    {0x2DA0, 0x2DA6, 1}, {0x2DA8, 0x2DAE, 1}, {0x2DB0, 0x2DB6, 1}, {0x2DB8, 0x2DBE, 1},
+    {0x2DC0, 0x2DC6, 1}, {0x2DC8, 0x2DCE, 1}, {0x2DD0, 0x2DD6, 1}, {0x2DD8, 0x2DDE, 1},
+    {0x2E00, 0x2E2E, 40}, {0x2E2F, 0x2E2F, 1}, {0x2E30, 0x2E4F, 40}, {0x2E50, 0x2E51, 8},
+    {0x2E52, 0x2E5D, 40}, {0x2E80, 0x2E99, 8}, {0x2E9B, 0x2EF3, 8}, {0x2F00, 0x2FD5, 8},
+    {0x2FF0, 0x2FFB, 8}, {0x3000, 0x3000, 4}, {0x3001, 0x3003, 40}, {0x3004, 0x3004, 8},
+    {0x3005, 0x3006, 1}, {0x3008, 0x3011, 40}, {0x3012, 0x3013, 8}, {0x3014, 0x301F, 40},
+    {0x3020, 0x3020, 8}, {0x3030, 0x3030, 40}, {0x3031, 0x3035, 1}, {0x3036, 0x3037, 8},
+    {0x303B, 0x303C, 1}, {0x303D, 0x303D, 40}, {0x303E, 0x303F, 8}, {0x3041, 0x3096, 1},
+    {0x309B, 0x309C, 8}, {0x309D, 0x309F, 1}, {0x30A0, 0x30A0, 40}, {0x30A1, 0x30FA, 1},
+    {0x30FB, 0x30FB, 40}, {0x30FC, 0x30FF, 1}, {0x3105, 0x312F, 1}, {0x3131, 0x318E, 1},
+    {0x3190, 0x3191, 8}, {0x3196, 0x319F, 8}, {0x31A0, 0x31BF, 1}, {0x31C0, 0x31E3, 8},
+    {0x31F0, 0x31FF, 1}, {0x3200, 0x321E, 8}, {0x322A, 0x3247, 8}, {0x3250, 0x3250, 8},
+    {0x3260, 0x327F, 8}, {0x328A, 0x32B0, 8}, {0x32C0, 0x33FF, 8}, {0x3400, 0x4DBF, 1},
+    {0x4DC0, 0x4DFF, 8}, {0x4E00, 0xA48C, 1}, {0xA490, 0xA4C6, 8}, {0xA4D0, 0xA4FD, 1},
+    {0xA4FE, 0xA4FF, 40}, {0xA500, 0xA60C, 1}, {0xA60D, 0xA60F, 40}, {0xA610, 0xA61F, 1},
+    {0xA620, 0xA629, 2}, {0xA62A, 0xA62B, 1}, {0xA640, 0xA66E, 1}, {0xA673, 0xA673, 40},
+    {0xA67E, 0xA67E, 40}, {0xA67F, 0xA69D, 1}, {0xA6A0, 0xA6E5, 1}, {0xA6F2, 0xA6F7, 40},
+    {0xA700, 0xA716, 8}, {0xA717, 0xA71F, 1}, {0xA720, 0xA721, 8}, {0xA722, 0xA788, 1},
+    {0xA789, 0xA78A, 8}, {0xA78B, 0xA7CA, 1}, {0xA7D0, 0xA7D1, 1}, {0xA7D3, 0xA7D3, 1},
+    {0xA7D5, 0xA7D9, 1}, {0xA7F2, 0xA801, 1}, {0xA803, 0xA805, 1}, {0xA807, 0xA80A, 1},
+    {0xA80C, 0xA822, 1}, {0xA828, 0xA82B, 8}, {0xA836, 0xA839, 8}, {0xA840, 0xA873, 1},
+    {0xA874, 0xA877, 40}, {0xA882, 0xA8B3, 1}, {0xA8CE, 0xA8CF, 40}, {0xA8D0, 0xA8D9, 2},
+    {0xA8F2, 0xA8F7, 1}, {0xA8F8, 0xA8FA, 40}, {0xA8FB, 0xA8FB, 1}, {0xA8FC, 0xA8FC, 40},
+    {0xA8FD, 0xA8FE, 1}, {0xA900, 0xA909, 2}, {0xA90A, 0xA925, 1}, {0xA92E, 0xA92F, 40},
+    {0xA930, 0xA946, 1}, {0xA95F, 0xA95F, 40}, {0xA960, 0xA97C, 1}, {0xA984, 0xA9B2, 1},
+    {0xA9C1, 0xA9CD, 40}, {0xA9CF, 0xA9CF, 1}, {0xA9D0, 0xA9D9, 2}, {0xA9DE, 0xA9DF, 40},
+    {0xA9E0, 0xA9E4, 1}, {0xA9E6, 0xA9EF, 1}, {0xA9F0, 0xA9F9, 2}, {0xA9FA, 0xA9FE, 1},
+    {0xAA00, 0xAA28, 1}, {0xAA40, 0xAA42, 1}, {0xAA44, 0xAA4B, 1}, {0xAA50, 0xAA59, 2},
+    {0xAA5C, 0xAA5F, 40}, {0xAA60, 0xAA76, 1}, {0xAA77, 0xAA79, 8}, {0xAA7A, 0xAA7A, 1},
+    {0xAA7E, 0xAAAF, 1}, {0xAAB1, 0xAAB1, 1}, {0xAAB5, 0xAAB6, 1}, {0xAAB9, 0xAABD, 1},
+    {0xAAC0, 0xAAC0, 1}, {0xAAC2, 0xAAC2, 1}, {0xAADB, 0xAADD, 1}, {0xAADE, 0xAADF, 40},
+    {0xAAE0, 0xAAEA, 1}, {0xAAF0, 0xAAF1, 40}, {0xAAF2, 0xAAF4, 1}, {0xAB01, 0xAB06, 1},
+    {0xAB09, 0xAB0E, 1}, {0xAB11, 0xAB16, 1}, {0xAB20, 0xAB26, 1}, {0xAB28, 0xAB2E, 1},
+    {0xAB30, 0xAB5A, 1}, {0xAB5B, 0xAB5B, 8}, {0xAB5C, 0xAB69, 1}, {0xAB6A, 0xAB6B, 8},
+    {0xAB70, 0xABE2, 1}, {0xABEB, 0xABEB, 40}, {0xABF0, 0xABF9, 2}, {0xAC00, 0xD7A3, 1},
+    {0xD7B0, 0xD7C6, 1}, {0xD7CB, 0xD7FB, 1}, {0xF900, 0xFA6D, 1}, {0xFA70, 0xFAD9, 1},
+    {0xFB00, 0xFB06, 1}, {0xFB13, 0xFB17, 1}, {0xFB1D, 0xFB1D, 1}, {0xFB1F, 0xFB28, 1},
+    {0xFB29, 0xFB29, 8}, {0xFB2A, 0xFB36, 1}, {0xFB38, 0xFB3C, 1}, {0xFB3E, 0xFB3E, 1},
+    {0xFB40, 0xFB41, 1}, {0xFB43, 0xFB44, 1}, {0xFB46, 0xFBB1, 1}, {0xFBB2, 0xFBC2, 8},
+    {0xFBD3, 0xFD3D, 1}, {0xFD3E, 0xFD3F, 40}, {0xFD40, 0xFD4F, 8}, {0xFD50, 0xFD8F, 1},
+    {0xFD92, 0xFDC7, 1}, {0xFDCF, 0xFDCF, 8}, {0xFDF0, 0xFDFB, 1}, {0xFDFC, 0xFDFF, 8},
+    {0xFE10, 0xFE19, 40}, {0xFE30, 0xFE52, 40}, {0xFE54, 0xFE61, 40}, {0xFE62, 0xFE62, 8},
+    {0xFE63, 0xFE63, 40}, {0xFE64, 0xFE66, 8}, {0xFE68, 0xFE68, 40}, {0xFE69, 0xFE69, 8},
+    {0xFE6A, 0xFE6B, 40}, {0xFE70, 0xFE74, 1}, {0xFE76, 0xFEFC, 1}, {0xFF01, 0xFF03, 40},
+    {0xFF04, 0xFF04, 8}, {0xFF05, 0xFF0A, 40}, {0xFF0B, 0xFF0B, 8}, {0xFF0C, 0xFF0F, 40},
+    {0xFF10, 0xFF19, 2}, {0xFF1A, 0xFF1B, 40}, {0xFF1C, 0xFF1E, 8}, {0xFF1F, 0xFF20, 40},
+    {0xFF21, 0xFF3A, 1}, {0xFF3B, 0xFF3D, 40}, {0xFF3E, 0xFF3E, 8}, {0xFF3F, 0xFF3F, 40},
+    {0xFF40, 0xFF40, 8}, {0xFF41, 0xFF5A, 1}, {0xFF5B, 0xFF5B, 40}, {0xFF5C, 0xFF5C, 8},
+    {0xFF5D, 0xFF5D, 40}, {0xFF5E, 0xFF5E, 8}, {0xFF5F, 0xFF65, 40}, {0xFF66, 0xFFBE, 1},
+    {0xFFC2, 0xFFC7, 1}, {0xFFCA, 0xFFCF, 1}, {0xFFD2, 0xFFD7, 1}, {0xFFDA, 0xFFDC, 1},
+    {0xFFE0, 0xFFE6, 8}, {0xFFE8, 0xFFEE, 8}, {0xFFFC, 0xFFFD, 8}, {0x10000, 0x1000B, 1},
+    {0x1000D, 0x10026, 1}, {0x10028, 0x1003A, 1}, {0x1003C, 0x1003D, 1}, {0x1003F, 0x1004D, 1},
+    {0x10050, 0x1005D, 1}, {0x10080, 0x100FA, 1}, {0x10100, 0x10102, 40}, {0x10137, 0x1013F, 8},
+    {0x10179, 0x10189, 8}, {0x1018C, 0x1018E, 8}, {0x10190, 0x1019C, 8}, {0x101A0, 0x101A0, 8},
+    {0x101D0, 0x101FC, 8}, {0x10280, 0x1029C, 1}, {0x102A0, 0x102D0, 1}, {0x10300, 0x1031F, 1},
+    {0x1032D, 0x10340, 1}, {0x10342, 0x10349, 1}, {0x10350, 0x10375, 1}, {0x10380, 0x1039D, 1},
+    {0x1039F, 0x1039F, 40}, {0x103A0, 0x103C3, 1}, {0x103C8, 0x103CF, 1}, {0x103D0, 0x103D0, 40},
+    {0x10400, 0x1049D, 1}, {0x104A0, 0x104A9, 2}, {0x104B0, 0x104D3, 1}, {0x104D8, 0x104FB, 1},
+    {0x10500, 0x10527, 1}, {0x10530, 0x10563, 1}, {0x1056F, 0x1056F, 40}, {0x10570, 0x1057A, 1},
+    {0x1057C, 0x1058A, 1}, {0x1058C, 0x10592, 1}, {0x10594, 0x10595, 1}, {0x10597, 0x105A1, 1},
+    {0x105A3, 0x105B1, 1}, {0x105B3, 0x105B9, 1}, {0x105BB, 0x105BC, 1}, {0x10600, 0x10736, 1},
+    {0x10740, 0x10755, 1}, {0x10760, 0x10767, 1}, {0x10780, 0x10785, 1}, {0x10787, 0x107B0, 1},
+    {0x107B2, 0x107BA, 1}, {0x10800, 0x10805, 1}, {0x10808, 0x10808, 1}, {0x1080A, 0x10835, 1},
+    {0x10837, 0x10838, 1}, {0x1083C, 0x1083C, 1}, {0x1083F, 0x10855, 1}, {0x10857, 0x10857, 40},
+    {0x10860, 0x10876, 1}, {0x10877, 0x10878, 8}, {0x10880, 0x1089E, 1}, {0x108E0, 0x108F2, 1},
+    {0x108F4, 0x108F5, 1}, {0x10900, 0x10915, 1}, {0x1091F, 0x1091F, 40}, {0x10920, 0x10939, 1},
+    {0x1093F, 0x1093F, 40}, {0x10980, 0x109B7, 1}, {0x109BE, 0x109BF, 1}, {0x10A00, 0x10A00, 1},
+    {0x10A10, 0x10A13, 1}, {0x10A15, 0x10A17, 1}, {0x10A19, 0x10A35, 1}, {0x10A50, 0x10A58, 40},
+    {0x10A60, 0x10A7C, 1}, {0x10A7F, 0x10A7F, 40}, {0x10A80, 0x10A9C, 1}, {0x10AC0, 0x10AC7, 1},
+    {0x10AC8, 0x10AC8, 8}, {0x10AC9, 0x10AE4, 1}, {0x10AF0, 0x10AF6, 40}, {0x10B00, 0x10B35, 1},
+    {0x10B39, 0x10B3F, 40}, {0x10B40, 0x10B55, 1}, {0x10B60, 0x10B72, 1}, {0x10B80, 0x10B91, 1},
+    {0x10B99, 0x10B9C, 40}, {0x10C00, 0x10C48, 1}, {0x10C80, 0x10CB2, 1}, {0x10CC0, 0x10CF2, 1},
+    {0x10D00, 0x10D23, 1}, {0x10D30, 0x10D39, 2}, {0x10E80, 0x10EA9, 1}, {0x10EAD, 0x10EAD, 40},
+    {0x10EB0, 0x10EB1, 1}, {0x10F00, 0x10F1C, 1}, {0x10F27, 0x10F27, 1}, {0x10F30, 0x10F45, 1},
+    {0x10F55, 0x10F59, 40}, {0x10F70, 0x10F81, 1}, {0x10F86, 0x10F89, 40}, {0x10FB0, 0x10FC4, 1},
+    {0x10FE0, 0x10FF6, 1}, {0x11003, 0x11037, 1}, {0x11047, 0x1104D, 40}, {0x11066, 0x1106F, 2},
+    {0x11071, 0x11072, 1}, {0x11075, 0x11075, 1}, {0x11083, 0x110AF, 1}, {0x110BB, 0x110BC, 40},
+    {0x110BE, 0x110C1, 40}, {0x110D0, 0x110E8, 1}, {0x110F0, 0x110F9, 2}, {0x11103, 0x11126, 1},
+    {0x11136, 0x1113F, 2}, {0x11140, 0x11143, 40}, {0x11144, 0x11144, 1}, {0x11147, 0x11147, 1},
+    {0x11150, 0x11172, 1}, {0x11174, 0x11175, 40}, {0x11176, 0x11176, 1}, {0x11183, 0x111B2, 1},
+    {0x111C1, 0x111C4, 1}, {0x111C5, 0x111C8, 40}, {0x111CD, 0x111CD, 40}, {0x111D0, 0x111D9, 2},
+    {0x111DA, 0x111DA, 1}, {0x111DB, 0x111DB, 40}, {0x111DC, 0x111DC, 1}, {0x111DD, 0x111DF, 40},
+    {0x11200, 0x11211, 1}, {0x11213, 0x1122B, 1}, {0x11238, 0x1123D, 40}, {0x11280, 0x11286, 1},
+    {0x11288, 0x11288, 1}, {0x1128A, 0x1128D, 1}, {0x1128F, 0x1129D, 1}, {0x1129F, 0x112A8, 1},
+    {0x112A9, 0x112A9, 40}, {0x112B0, 0x112DE, 1}, {0x112F0, 0x112F9, 2}, {0x11305, 0x1130C, 1},
+    {0x1130F, 0x11310, 1}, {0x11313, 0x11328, 1}, {0x1132A, 0x11330, 1}, {0x11332, 0x11333, 1},
+    {0x11335, 0x11339, 1}, {0x1133D, 0x1133D, 1}, {0x11350, 0x11350, 1}, {0x1135D, 0x11361, 1},
+    {0x11400, 0x11434, 1}, {0x11447, 0x1144A, 1}, {0x1144B, 0x1144F, 40}, {0x11450, 0x11459, 2},
+    {0x1145A, 0x1145B, 40}, {0x1145D, 0x1145D, 40}, {0x1145F, 0x11461, 1}, {0x11480, 0x114AF, 1},
+    {0x114C4, 0x114C5, 1}, {0x114C6, 0x114C6, 40}, {0x114C7, 0x114C7, 1}, {0x114D0, 0x114D9, 2},
+    {0x11580, 0x115AE, 1}, {0x115C1, 0x115D7, 40}, {0x115D8, 0x115DB, 1}, {0x11600, 0x1162F, 1},
+    {0x11641, 0x11643, 40}, {0x11644, 0x11644, 1}, {0x11650, 0x11659, 2}, {0x11660, 0x1166C, 40},
+    {0x11680, 0x116AA, 1}, {0x116B8, 0x116B8, 1}, {0x116B9, 0x116B9, 40}, {0x116C0, 0x116C9, 2},
+    {0x11700, 0x1171A, 1}, {0x11730, 0x11739, 2}, {0x1173C, 0x1173E, 40}, {0x1173F, 0x1173F, 8},
+    {0x11740, 0x11746, 1}, {0x11800, 0x1182B, 1}, {0x1183B, 0x1183B, 40}, {0x118A0, 0x118DF, 1},
+    {0x118E0, 0x118E9, 2}, {0x118FF, 0x11906, 1}, {0x11909, 0x11909, 1}, {0x1190C, 0x11913, 1},
+    {0x11915, 0x11916, 1}, {0x11918, 0x1192F, 1}, {0x1193F, 0x1193F, 1}, {0x11941, 0x11941, 1},
+    {0x11944, 0x11946, 40}, {0x11950, 0x11959, 2}, {0x119A0, 0x119A7, 1}, {0x119AA, 0x119D0, 1},
+    {0x119E1, 0x119E1, 1}, {0x119E2, 0x119E2, 40}, {0x119E3, 0x119E3, 1}, {0x11A00, 0x11A00, 1},
+    {0x11A0B, 0x11A32, 1}, {0x11A3A, 0x11A3A, 1}, {0x11A3F, 0x11A46, 40}, {0x11A50, 0x11A50, 1},
+    {0x11A5C, 0x11A89, 1}, {0x11A9A, 0x11A9C, 40}, {0x11A9D, 0x11A9D, 1}, {0x11A9E, 0x11AA2, 40},
+    {0x11AB0, 0x11AF8, 1}, {0x11C00, 0x11C08, 1}, {0x11C0A, 0x11C2E, 1}, {0x11C40, 0x11C40, 1},
+    {0x11C41, 0x11C45, 40}, {0x11C50, 0x11C59, 2}, {0x11C70, 0x11C71, 40}, {0x11C72, 0x11C8F, 1},
+    {0x11D00, 0x11D06, 1}, {0x11D08, 0x11D09, 1}, {0x11D0B, 0x11D30, 1}, {0x11D46, 0x11D46, 1},
+    {0x11D50, 0x11D59, 2}, {0x11D60, 0x11D65, 1}, {0x11D67, 0x11D68, 1}, {0x11D6A, 0x11D89, 1},
+    {0x11D98, 0x11D98, 1}, {0x11DA0, 0x11DA9, 2}, {0x11EE0, 0x11EF2, 1}, {0x11EF7, 0x11EF8, 40},
+    {0x11FB0, 0x11FB0, 1}, {0x11FD5, 0x11FF1, 8}, {0x11FFF, 0x11FFF, 40}, {0x12000, 0x12399, 1},
+    {0x12470, 0x12474, 40}, {0x12480, 0x12543, 1}, {0x12F90, 0x12FF0, 1}, {0x12FF1, 0x12FF2, 40},
+    {0x13000, 0x1342E, 1}, {0x14400, 0x14646, 1}, {0x16800, 0x16A38, 1}, {0x16A40, 0x16A5E, 1},
+    {0x16A60, 0x16A69, 2}, {0x16A6E, 0x16A6F, 40}, {0x16A70, 0x16ABE, 1}, {0x16AC0, 0x16AC9, 2},
+    {0x16AD0, 0x16AED, 1}, {0x16AF5, 0x16AF5, 40}, {0x16B00, 0x16B2F, 1}, {0x16B37, 0x16B3B, 40},
+    {0x16B3C, 0x16B3F, 8}, {0x16B40, 0x16B43, 1}, {0x16B44, 0x16B44, 40}, {0x16B45, 0x16B45, 8},
+    {0x16B50, 0x16B59, 2}, {0x16B63, 0x16B77, 1}, {0x16B7D, 0x16B8F, 1}, {0x16E40, 0x16E7F, 1},
+    {0x16E97, 0x16E9A, 40}, {0x16F00, 0x16F4A, 1}, {0x16F50, 0x16F50, 1}, {0x16F93, 0x16F9F, 1},
+    {0x16FE0, 0x16FE1, 1}, {0x16FE2, 0x16FE2, 40}, {0x16FE3, 0x16FE3, 1}, {0x17000, 0x187F7, 1},
+    {0x18800, 0x18CD5, 1}, {0x18D00, 0x18D08, 1}, {0x1AFF0, 0x1AFF3, 1}, {0x1AFF5, 0x1AFFB, 1},
+    {0x1AFFD, 0x1AFFE, 1}, {0x1B000, 0x1B122, 1}, {0x1B150, 0x1B152, 1}, {0x1B164, 0x1B167, 1},
+    {0x1B170, 0x1B2FB, 1}, {0x1BC00, 0x1BC6A, 1}, {0x1BC70, 0x1BC7C, 1}, {0x1BC80, 0x1BC88, 1},
+    {0x1BC90, 0x1BC99, 1}, {0x1BC9C, 0x1BC9C, 8}, {0x1BC9F, 0x1BC9F, 40}, {0x1CF50, 0x1CFC3, 8},
+    {0x1D000, 0x1D0F5, 8}, {0x1D100, 0x1D126, 8}, {0x1D129, 0x1D164, 8}, {0x1D16A, 0x1D16C, 8},
+    {0x1D183, 0x1D184, 8}, {0x1D18C, 0x1D1A9, 8}, {0x1D1AE, 0x1D1EA, 8}, {0x1D200, 0x1D241, 8},
+    {0x1D245, 0x1D245, 8}, {0x1D300, 0x1D356, 8}, {0x1D400, 0x1D454, 1}, {0x1D456, 0x1D49C, 1},
+    {0x1D49E, 0x1D49F, 1}, {0x1D4A2, 0x1D4A2, 1}, {0x1D4A5, 0x1D4A6, 1}, {0x1D4A9, 0x1D4AC, 1},
+    {0x1D4AE, 0x1D4B9, 1}, {0x1D4BB, 0x1D4BB, 1}, {0x1D4BD, 0x1D4C3, 1}, {0x1D4C5, 0x1D505, 1},
+    {0x1D507, 0x1D50A, 1}, {0x1D50D, 0x1D514, 1}, {0x1D516, 0x1D51C, 1}, {0x1D51E, 0x1D539, 1},
+    {0x1D53B, 0x1D53E, 1}, {0x1D540, 0x1D544, 1}, {0x1D546, 0x1D546, 1}, {0x1D54A, 0x1D550, 1},
+    {0x1D552, 0x1D6A5, 1}, {0x1D6A8, 0x1D6C0, 1}, {0x1D6C1, 0x1D6C1, 8}, {0x1D6C2, 0x1D6DA, 1},
+    {0x1D6DB, 0x1D6DB, 8}, {0x1D6DC, 0x1D6FA, 1}, {0x1D6FB, 0x1D6FB, 8}, {0x1D6FC, 0x1D714, 1},
+    {0x1D715, 0x1D715, 8}, {0x1D716, 0x1D734, 1}, {0x1D735, 0x1D735, 8}, {0x1D736, 0x1D74E, 1},
+    {0x1D74F, 0x1D74F, 8}, {0x1D750, 0x1D76E, 1}, {0x1D76F, 0x1D76F, 8}, {0x1D770, 0x1D788, 1},
+    {0x1D789, 0x1D789, 8}, {0x1D78A, 0x1D7A8, 1}, {0x1D7A9, 0x1D7A9, 8}, {0x1D7AA, 0x1D7C2, 1},
+    {0x1D7C3, 0x1D7C3, 8}, {0x1D7C4, 0x1D7CB, 1}, {0x1D7CE, 0x1D7FF, 2}, {0x1D800, 0x1D9FF, 8},
+    {0x1DA37, 0x1DA3A, 8}, {0x1DA6D, 0x1DA74, 8}, {0x1DA76, 0x1DA83, 8}, {0x1DA85, 0x1DA86, 8},
+    {0x1DA87, 0x1DA8B, 40}, {0x1DF00, 0x1DF1E, 1}, {0x1E100, 0x1E12C, 1}, {0x1E137, 0x1E13D, 1},
+    {0x1E140, 0x1E149, 2}, {0x1E14E, 0x1E14E, 1}, {0x1E14F, 0x1E14F, 8}, {0x1E290, 0x1E2AD, 1},
+    {0x1E2C0, 0x1E2EB, 1}, {0x1E2F0, 0x1E2F9, 2}, {0x1E2FF, 0x1E2FF, 8}, {0x1E7E0, 0x1E7E6, 1},
+    {0x1E7E8, 0x1E7EB, 1}, {0x1E7ED, 0x1E7EE, 1}, {0x1E7F0, 0x1E7FE, 1}, {0x1E800, 0x1E8C4, 1},
+    {0x1E900, 0x1E943, 1}, {0x1E94B, 0x1E94B, 1}, {0x1E950, 0x1E959, 2}, {0x1E95E, 0x1E95F, 40},
+    {0x1ECAC, 0x1ECAC, 8}, {0x1ECB0, 0x1ECB0, 8}, {0x1ED2E, 0x1ED2E, 8}, {0x1EE00, 0x1EE03, 1},
+    {0x1EE05, 0x1EE1F, 1}, {0x1EE21, 0x1EE22, 1}, {0x1EE24, 0x1EE24, 1}, {0x1EE27, 0x1EE27, 1},
+    {0x1EE29, 0x1EE32, 1}, {0x1EE34, 0x1EE37, 1}, {0x1EE39, 0x1EE39, 1}, {0x1EE3B, 0x1EE3B, 1},
+    {0x1EE42, 0x1EE42, 1}, {0x1EE47, 0x1EE47, 1}, {0x1EE49, 0x1EE49, 1}, {0x1EE4B, 0x1EE4B, 1},
+    {0x1EE4D, 0x1EE4F, 1}, {0x1EE51, 0x1EE52, 1}, {0x1EE54, 0x1EE54, 1}, {0x1EE57, 0x1EE57, 1},
+    {0x1EE59, 0x1EE59, 1}, {0x1EE5B, 0x1EE5B, 1}, {0x1EE5D, 0x1EE5D, 1}, {0x1EE5F, 0x1EE5F, 1},
+    {0x1EE61, 0x1EE62, 1}, {0x1EE64, 0x1EE64, 1}, {0x1EE67, 0x1EE6A, 1}, {0x1EE6C, 0x1EE72, 1},
+    {0x1EE74, 0x1EE77, 1}, {0x1EE79, 0x1EE7C, 1}, {0x1EE7E, 0x1EE7E, 1}, {0x1EE80, 0x1EE89, 1},
+    {0x1EE8B, 0x1EE9B, 1}, {0x1EEA1, 0x1EEA3, 1}, {0x1EEA5, 0x1EEA9, 1}, {0x1EEAB, 0x1EEBB, 1},
+    {0x1EEF0, 0x1EEF1, 8}, {0x1F000, 0x1F02B, 8}, {0x1F030, 0x1F093, 8}, {0x1F0A0, 0x1F0AE, 8},
+    {0x1F0B1, 0x1F0BF, 8}, {0x1F0C1, 0x1F0CF, 8}, {0x1F0D1, 0x1F0F5, 8}, {0x1F10D, 0x1F1AD, 8},
+    {0x1F1E6, 0x1F202, 8}, {0x1F210, 0x1F23B, 8}, {0x1F240, 0x1F248, 8}, {0x1F250, 0x1F251, 8},
+    {0x1F260, 0x1F265, 8}, {0x1F300, 0x1F6D7, 8}, {0x1F6DD, 0x1F6EC, 8}, {0x1F6F0, 0x1F6FC, 8},
+    {0x1F700, 0x1F773, 8}, {0x1F780, 0x1F7D8, 8}, {0x1F7E0, 0x1F7EB, 8}, {0x1F7F0, 0x1F7F0, 8},
+    {0x1F800, 0x1F80B, 8}, {0x1F810, 0x1F847, 8}, {0x1F850, 0x1F859, 8}, {0x1F860, 0x1F887, 8},
+    {0x1F890, 0x1F8AD, 8}, {0x1F8B0, 0x1F8B1, 8}, {0x1F900, 0x1FA53, 8}, {0x1FA60, 0x1FA6D, 8},
+    {0x1FA70, 0x1FA74, 8}, {0x1FA78, 0x1FA7C, 8}, {0x1FA80, 0x1FA86, 8}, {0x1FA90, 0x1FAAC, 8},
+    {0x1FAB0, 0x1FABA, 8}, {0x1FAC0, 0x1FAC5, 8}, {0x1FAD0, 0x1FAD9, 8}, {0x1FAE0, 0x1FAE7, 8},
+    {0x1FAF0, 0x1FAF6, 8}, {0x1FB00, 0x1FB92, 8}, {0x1FB94, 0x1FBCA, 8}, {0x1FBF0, 0x1FBF9, 2},
+    {0x20000, 0x2A6DF, 1}, {0x2A700, 0x2B738, 1}, {0x2B740, 0x2B81D, 1}, {0x2B820, 0x2CEA1, 1},
+    {0x2CEB0, 0x2EBE0, 1}, {0x2F800, 0x2FA1D, 1}, {0x30000, 0x3134A, 1},
+};
+
+#define UNICODE_CLASS_RANGES (sizeof(unicode_class_ranges) / sizeof(unicode_class_ranges[0]))
+
+#endif
@@ -0,0 +1,240 @@
+#ifndef UTF8CLASS_H
+#define UTF8CLASS_H
+
+/*
+ * Символи UTF-8 поза ASCII для статистики тексту.
+ *
+ * Ядро textclass.h класифікує окремі байти, тож байти >= 128 для нього
+ * безкласові, а пробільні символи Unicode (нерозривний пробіл тощо) не
+ * розділяють слова. Цей прохід доповнює його: ASCII пропускається
+ * векторно (SSE2 — 64 байти за крок), і лише навколо байтів >= 128
+ * послідовності декодуються та класифікуються за unicode_classes.h.
+ * Результат — кількість символів (кодових точок), класи символів поза
+ * ASCII і поправка до початків слів ядра: у ядра всі байти пробільного
+ * символу Unicode непробільні.
+ *
+ * Некоректні послідовності (зайві байти продовження, обрізані,
+ * надлишкові, сурогати) рахуються як окремі безкласові символи по одному
+ * байту, як U+FFFD у декодерах; решта файлу від цього не зсувається.
+ *
+ * Шматок без лівого контексту не знає, чи його перші байти продовження
+ * (до трьох, prefix) завершують символ попереднього шматка, а незавершена
+ * послідовність у кінці (suffix) — чим продовжиться. Обидві лишаються
+ * відкритими, а символи між ними («середина») рахуються повністю. Склеює
+ * їх textscan_merge(), тож результат не залежить від меж шматків.
+ *
+ * Заголовок придатний і для C (lab1), і для C++ (lab2).
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "textclass.h"
+#include "unicode_classes.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#define UTF8CLASS_MAX_SEQUENCE 4
+
+typedef struct {
+    unsigned long long counts[TEXTCLASS_COUNT];  /* символи поза ASCII */
+    unsigned long long chars;                    /* усі символи середини */
+    long long word_starts;                       /* поправка до ядра */
+    int prefix_len;
+    int suffix_len;
+    int first_space;                             /* -1 — середина порожня */
+    int last_space;
+} Utf8ClassCounts;
+
+static inline int utf8class_is_continuation(unsigned char b) {
+    return (b & 0xC0) == 0x80;
+}
+
+/* Довжина послідовності за першим байтом; 1 — ASCII або некоректний байт */
+static inline int utf8class_length(unsigned char b) {
+    if (b >= 0xC2 && b <= 0xDF) {
+        return 2;
+    }
+    if (b >= 0xE0 && b <= 0xEF) {
+        return 3;
+    }
+    if (b >= 0xF0 && b <= 0xF4) {
+        return 4;
+    }
+    return 1;
+}
+
+/* Біти TextClass символу cp >= 0x80 */
+static inline unsigned utf8class_lookup(uint32_t cp) {
+    if (cp < 0x800) {
+        return unicode_class_2byte[cp - 0x80];
+    }
+    size_t lo = 0;
+    size_t hi = UNICODE_CLASS_RANGES;
+    while (lo < hi) {
+        size_t mid = (lo + hi) / 2;
+        if (unicode_class_ranges[mid].last < cp) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    if (lo < UNICODE_CLASS_RANGES && unicode_class_ranges[lo].first <= cp) {
+        return unicode_class_ranges[lo].bits;
+    }
+    return 0;
+}
+
+/* Символ у s[0..avail): повертає кількість байтів (1 для некоректної
+ * послідовності чи ASCII), у *bits — його класи */
+static inline int utf8class_decode(const unsigned char* s, size_t avail, unsigned* bits) {
+    unsigned char b = s[0];
+    if (b < 0x80) {
+        *bits = textclass_of(b);
+        return 1;
+    }
+    /* найчастіше: двобайтові (кирилиця, латиниця з діакритикою) */
+    if (b >= 0xC2 && b <= 0xDF && avail >= 2 && utf8class_is_continuation(s[1])) {
+        *bits = unicode_class_2byte[(((uint32_t)(b & 0x1F) << 6) | (s[1] & 0x3F)) - 0x80];
+        return 2;
+    }
+    *bits = 0;
+    int n = utf8class_length(b);
+    if (n == 1 || avail < (size_t)n) {
+        return 1;
+    }
+    uint32_t cp = b & (0x7F >> n);
+    for (int k = 1; k < n; k++) {
+        if (!utf8class_is_continuation(s[k])) {
+            return 1;
+        }
+        cp = (cp << 6) | (s[k] & 0x3F);
+    }
+    if ((n == 3 && (cp < 0x800 || (cp >= 0xD800 && cp <= 0xDFFF))) ||
+        (n == 4 && (cp < 0x10000 || cp > 0x10FFFF))) {
+        return 1;
+    }
+    *bits = utf8class_lookup(cp);
+    return n;
+}
+
+/* Перший байт >= 128 у data[i..end), або end */
+static inline size_t utf8class_skip_ascii(const unsigned char* data, size_t i, size_t end) {
+    /* короткі проміжки між символами поза ASCII — без векторів */
+    for (int k = 0; k < 8 && i < end; k++, i++) {
+        if (data[i] >= 0x80) {
+            return i;
+        }
+    }
+#if defined(__SSE2__)
+    while (i + 64 <= end) {
+        __m128i a = _mm_loadu_si128((const __m128i*)(data + i));
+        __m128i b = _mm_loadu_si128((const __m128i*)(data + i + 16));
+        __m128i c = _mm_loadu_si128((const __m128i*)(data + i + 32));
+        __m128i d = _mm_loadu_si128((const __m128i*)(data + i + 48));
+        if (_mm_movemask_epi8(_mm_or_si128(_mm_or_si128(a, b), _mm_or_si128(c, d))) != 0) {
+            break;
+        }
+        i += 64;
+    }
+    while (i + 16 <= end) {
+        int mask = _mm_movemask_epi8(_mm_loadu_si128((const __m128i*)(data + i)));
+        if (mask != 0) {
+            return i + (size_t)__builtin_ctz((unsigned)mask);
+        }
+        i += 16;
+    }
+#endif
+    while (i < end && data[i] < 0x80) {
+        i++;
+    }
+    return i;
+}
+
+static inline int utf8class_ascii_space(unsigned char b) {
+    return b == ' ' || (b >= '\t' && b <= '\r');
+}
+
+static inline void utf8class_scan(const unsigned char* data, size_t len, Utf8ClassCounts* out) {
+    memset(out, 0, sizeof(*out));
+    out->first_space = -1;
+    out->last_space = -1;
+
+    size_t begin = 0;
+    while (begin < len && begin < UTF8CLASS_MAX_SEQUENCE - 1 && utf8class_is_continuation(data[begin])) {
+        begin++;
+    }
+    out->prefix_len = (int)begin;
+
+    /* Незавершена послідовність у кінці: перший байт і лише продовження */
+    size_t end = len;
+    size_t k = len;
+    while (k > begin && len - k < UTF8CLASS_MAX_SEQUENCE - 1 && utf8class_is_continuation(data[k - 1])) {
+        k--;
+    }
+    if (k > begin && (size_t)utf8class_length(data[k - 1]) > len - (k - 1)) {
+        end = k - 1;
+    }
+    out->suffix_len = (int)(len - end);
+    if (begin >= end) {
+        return;
+    }
+
+    /* Ядро бачить байти поза ASCII непробільними */
+    int after_space = 0;
+    int last_space = 0;
+    size_t last_end = begin;
+    size_t i = begin;
+    out->chars = end - begin;
+    while (i < end) {
+        size_t next = utf8class_skip_ascii(data, i, end);
+        if (next > i) {
+            if (after_space) {
+                out->word_starts += !utf8class_ascii_space(data[i]);
+                after_space = 0;
+            }
+            i = next;
+            if (i == end) {
+                break;
+            }
+        }
+        unsigned bits;
+        int n = utf8class_decode(data + i, end - i, &bits);
+        int space = (bits >> TEXTCLASS_SPACE) & 1;
+        for (int c = 0; c < TEXTCLASS_COUNT; c++) {
+            out->counts[c] += (bits >> c) & 1;
+        }
+        out->chars -= (unsigned long long)(n - 1);
+        if (after_space) {
+            out->word_starts += !space;
+        }
+        if (space) {
+            /* ядро зарахувало початок слова на першому байті */
+            if (i > 0) {
+                out->word_starts -= utf8class_ascii_space(data[i - 1]);
+            }
+            if (i == begin) {
+                out->first_space = 1;
+            }
+        } else if (i == begin) {
+            out->first_space = 0;
+        }
+        after_space = space;
+        last_space = space;
+        i += (size_t)n;
+        last_end = i;
+    }
+    if (out->first_space < 0) {
+        out->first_space = utf8class_ascii_space(data[begin]);
+    }
+    out->last_space = last_end == end ? last_space : utf8class_ascii_space(data[end - 1]);
+
+    /* Початок незавершеної послідовності лишається відкритим */
+    if (end < len && end > 0) {
+        out->word_starts -= utf8class_ascii_space(data[end - 1]);
+    }
+}
+
+#endif
@@ -0,0 +1,655 @@
+#ifndef WORDFREQ_H
+#define WORDFREQ_H
+
+/*
+ * Частоти слів текстового файлу, що зливаються зі шматків (моноїд для
+ * chunkscan.h), і найчастіші K слів.
+ *
+ * Слово — найдовший ряд літер і цифр ASCII та байтів UTF-8 (кирилиця
+ * тощо); апостроф (' або ’) усередині слова належить слову ("пам'ять",
+ * "don't"), а знаки пунктуації UTF-8 (« » — … та нерозривний пробіл)
+ * розділяють слова. Регістр ASCII не розрізняється, слова зберігаються
+ * в нижньому регістрі. Слова довші за WORDFREQ_MAX_WORD байтів не
+ * рахуються.
+ *
+ * Кожен шматок має власну таблицю з відкритою адресацією (лінійне
+ * зондування), тож гарячий цикл не бере жодних блокувань. Пошук
+ * порівнює слово прямо в байтах шматка (у відображенні файлу — без
+ * копіювання); у пул таблиці копіюється лише перше входження слова, тож
+ * таблиця не залежить від часу життя відображення чи буфера. Злиття
+ * забирає записи і пул другої таблиці без копіювання слів.
+ *
+ * Пам'ять обмежена: коли різних слів більше за WORDFREQ_LIMIT, таблиця
+ * проріджується за схемою Space-Saving — рідші записи витісняються, а
+ * найбільший витіснений лічильник стає «підлогою» floor. Нове слово
+ * отримує лічильник floor + 1 з похибкою floor, тож лічильник ніколи не
+ * занижений, а завищений щонайбільше на error; поки floor == 0, усе
+ * точно. Злиття додає до слів, яких немає в іншій таблиці, її floor.
+ *
+ * Межі шматків: уривки відрізків між роздільниками ASCII (head до
+ * першого, tail після останнього) зберігаються як текст і склеюються
+ * під час злиття, як у numscan.h. Відрізки довші за
+ * WORDFREQ_MAX_SEGMENT байтів (без жодного роздільника ASCII)
+ * пропускаються цілком, тож результат не залежить від меж шматків.
+ *
+ * Таблиця володіє пам'яттю: злиття звільняє другий стан (див.
+ * chunkscan.h), а накопичувач файлу звільняє wordfreq_free().
+ *
+ * Заголовок придатний і для C (lab1), і для C++ (lab2).
+ */
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "chunkscan.h"
+#include "textscan.h"
+
+#define WORDFREQ_MAX_WORD 64
+#define WORDFREQ_MAX_SEGMENT 256
+#ifndef WORDFREQ_LIMIT
+#define WORDFREQ_LIMIT (1 << 18)
+#endif
+#define WORDFREQ_INITIAL_SLOTS 1024
+#define WORDFREQ_BLOCK (64 << 10)
+
+typedef struct {
+    const unsigned char* word;        /* у пулі таблиці; NULL — вільний слот */
+    uint32_t len;
+    uint32_t hash;
+    unsigned long long count;
+    unsigned long long error;         /* count завищено щонайбільше на error */
+} WordEntry;
+
+typedef struct WordBlock {
+    struct WordBlock* next;
+    size_t used;
+    size_t size;                      /* байти слів ідуть одразу за заголовком */
+} WordBlock;
+
+typedef struct {
+    WordEntry* slots;
+    size_t mask;                      /* слотів − 1; slots == NULL — ще порожня */
+    size_t used;
+    unsigned long long floor;         /* найбільший витіснений лічильник */
+    unsigned long long words;         /* усього слів, разом із витісненими */
+    WordBlock* blocks;
+    int failed;                       /* бракувало пам'яті, частину слів втрачено */
+} WordTable;
+
+typedef struct {
+    unsigned char text[WORDFREQ_MAX_SEGMENT];
+    size_t len;
+    int overflow;
+} WordFragment;
+
+typedef struct {
+    unsigned long long size;
+    WordTable table;
+    int has_separator;
+    WordFragment head;  /* до першого роздільника (або весь шматок) */
+    WordFragment tail;  /* після останнього роздільника */
+} WordChunk;
+
+static inline unsigned char wordfreq_lower(unsigned char c) {
+    return (c >= 'A' && c <= 'Z') ? (unsigned char)(c + ('a' - 'A')) : c;
+}
+
+/* Байт ASCII, що не може бути частиною слова: усе, крім [0-9A-Za-z'].
+ * Маски за бітами 0–63 і 64–127 замість ланцюжка порівнянь. */
+#define WORDFREQ_SEPARATORS_LO (~((0x3FFULL << '0') | (1ULL << '\'')))
+#define WORDFREQ_SEPARATORS_HI (~((0x3FFFFFFULL << ('A' - 64)) | (0x3FFFFFFULL << ('a' - 64))))
+
+static inline int wordfreq_is_separator(unsigned char c) {
+    if (c < 64) {
+        return (int)((WORDFREQ_SEPARATORS_LO >> c) & 1);
+    }
+    return c < 128 ? (int)((WORDFREQ_SEPARATORS_HI >> (c - 64)) & 1) : 0;
+}
+
+/* Довжина апострофа (' або ’) у s[i], інакше 0 */
+static inline size_t wordfreq_apostrophe(const unsigned char* s, size_t i, size_t len) {
+    if (s[i] == '\'') {
+        return 1;
+    }
+    if (s[i] == 0xE2 && i + 2 < len && s[i + 1] == 0x80 && s[i + 2] == 0x99) {
+        return 3;
+    }
+    return 0;
+}
+
+/* Довжина знака пунктуації UTF-8 у s[i] (U+0080–U+00BF, крім ª µ º, і
+ * U+2000–U+207F), інакше 0 */
+static inline size_t wordfreq_utf8_punct(const unsigned char* s, size_t i, size_t len) {
+    if (s[i] == 0xC2 && i + 1 < len && s[i + 1] >= 0x80 && s[i + 1] <= 0xBF) {
+        unsigned char c = s[i + 1];
+        return (c == 0xAA || c == 0xB5 || c == 0xBA) ? 0 : 2;
+    }
+    if (s[i] == 0xE2 && i + 2 < len && (s[i + 1] == 0x80 || s[i + 1] == 0x81)) {
+        return 3;
+    }
+    return 0;
+}
+
+static inline void wordtable_init(WordTable* t) {
+    memset(t, 0, sizeof(*t));
+}
+
+static inline void wordtable_free(WordTable* t) {
+    WordBlock* b = t->blocks;
+    while (b != NULL) {
+        WordBlock* next = b->next;
+        free(b);
+        b = next;
+    }
+    free(t->slots);
+    wordtable_init(t);
+}
+
+/* Копія слова в нижньому регістрі в пулі таблиці; NULL — бракує пам'яті */
+static inline const unsigned char* wordtable_intern(WordTable* t, const unsigned char* word, size_t len) {
+    WordBlock* b = t->blocks;
+    if (b == NULL || b->size - b->used < len) {
+        size_t size = len > WORDFREQ_BLOCK ? len : WORDFREQ_BLOCK;
+        b = (WordBlock*)malloc(sizeof(WordBlock) + size);
+        if (b == NULL) {
+            return NULL;
+        }
+        b->next = t->blocks;
+        b->used = 0;
+        b->size = size;
+        t->blocks = b;
+    }
+    unsigned char* copy = (unsigned char*)(b + 1) + b->used;
+    for (size_t i = 0; i < len; i++) {
+        copy[i] = wordfreq_lower(word[i]);
+    }
+    b->used += len;
+    return copy;
+}
+
+/* Слот зі словом word (у будь-якому регістрі) або вільний слот для нього */
+static inline WordEntry* wordtable_slot(const WordTable* t, const unsigned char* word, uint32_t len, uint32_t hash) {
+    size_t i = hash & t->mask;
+    for (;;) {
+        WordEntry* e = &t->slots[i];
+        if (e->word == NULL) {
+            return e;
+        }
+        if (e->hash == hash && e->len == len) {
+            uint32_t k = 0;
+            while (k < len && e->word[k] == wordfreq_lower(word[k])) {
+                k++;
+            }
+            if (k == len) {
+                return e;
+            }
+        }
+        i = (i + 1) & t->mask;
+    }
+}
+
+/* Переносить записи в нові слоти (слова лишаються де були) */
+static inline int wordtable_rehash(WordTable* t, size_t slots) {
+    WordEntry* fresh = (WordEntry*)calloc(slots, sizeof(WordEntry));
+    if (fresh == NULL) {
+        return -1;
+    }
+    WordEntry* old = t->slots;
+    size_t old_slots = old != NULL ? t->mask + 1 : 0;
+    t->slots = fresh;
+    t->mask = slots - 1;
+    for (size_t i = 0; i < old_slots; i++) {
+        if (old[i].word != NULL) {
+            *wordtable_slot(t, old[i].word, old[i].len, old[i].hash) = old[i];
+        }
+    }
+    free(old);
+    return 0;
+}
+
+static inline int wordfreq_count_compare(const void* x, const void* y) {
+    unsigned long long a = *(const unsigned long long*)x;
+    unsigned long long b = *(const unsigned long long*)y;
+    return (a > b) - (a < b);
+}
+
+/* Space-Saving: лишає щонайбільше половину WORDFREQ_LIMIT найчастіших
+ * записів, floor — найбільший витіснений лічильник. Пул переписується
+ * лише з уцілілими словами. */
+static inline void wordtable_prune(WordTable* t) {
+    size_t slots = t->mask + 1;
+    unsigned long long* counts = (unsigned long long*)malloc(t->used * sizeof(unsigned long long));
+    WordEntry* fresh = (WordEntry*)calloc(slots, sizeof(WordEntry));
+    if (counts == NULL || fresh == NULL) {
+        free(counts);
+        free(fresh);
+        t->failed = 1;
+        return;
+    }
+    size_t n = 0;
+    for (size_t i = 0; i < slots; i++) {
+        if (t->slots[i].word != NULL) {
+            counts[n++] = t->slots[i].count;
+        }
+    }
+    qsort(counts, n, sizeof(unsigned long long), wordfreq_count_compare);
+    unsigned long long threshold = counts[n - WORDFREQ_LIMIT / 2];
+    free(counts);
+    if (threshold > t->floor) {
+        t->floor = threshold;
+    }
+
+    WordTable kept;
+    wordtable_init(&kept);
+    kept.slots = fresh;
+    kept.mask = t->mask;
+    for (size_t i = 0; i < slots; i++) {
+        WordEntry e = t->slots[i];
+        if (e.word == NULL || e.count <= threshold) {
+            continue;
+        }
+        e.word = wordtable_intern(&kept, e.word, e.len);
+        if (e.word == NULL) {
+            t->failed = 1;
+            continue;
+        }
+        *wordtable_slot(&kept, e.word, e.len, e.hash) = e;
+        kept.used++;
+    }
+    kept.floor = t->floor;
+    kept.words = t->words;
+    kept.failed = t->failed;
+    wordtable_free(t);
+    *t = kept;
+}
+
+/* Додає count входжень слова; word може бути будь-де (копіюється лише
+ * нове слово), owned — word уже в пулі цієї таблиці */
+static inline void wordtable_add(WordTable* t, const unsigned char* word, uint32_t len, uint32_t hash,
+                                 unsigned long long count, unsigned long long error, int owned) {
+    if (t->slots == NULL || 2 * (t->used + 1) > t->mask + 1) {
+        if (t->used >= WORDFREQ_LIMIT) {
+            wordtable_prune(t);
+            if (2 * (t->used + 1) > t->mask + 1) {
+                t->failed = 1;
+                return;
+            }
+        } else if (wordtable_rehash(t, t->slots == NULL ? WORDFREQ_INITIAL_SLOTS : 2 * (t->mask + 1)) != 0) {
+            t->failed = 1;
+            return;
+        }
+    }
+    WordEntry* e = wordtable_slot(t, word, len, hash);
+    if (e->word != NULL) {
+        e->count += count;
+        e->error += error;
+        return;
+    }
+    const unsigned char* stored = owned ? word : wordtable_intern(t, word, len);
+    if (stored == NULL) {
+        t->failed = 1;
+        return;
+    }
+    e->word = stored;
+    e->len = len;
+    e->hash = hash;
+    e->count = count + t->floor;
+    e->error = error + t->floor;
+    t->used++;
+}
+
+/* acc = acc ∪ next; next звільняється (його пул переходить до acc) */
+static inline void wordtable_merge(WordTable* acc, WordTable* next) {
+    if (acc->slots == NULL && acc->blocks == NULL) {
+        unsigned long long words = acc->words;
+        int failed = acc->failed;
+        *acc = *next;
+        acc->words += words;
+        acc->failed |= failed;
+        wordtable_init(next);
+        return;
+    }
+
+    /* Слова, яких немає в next, могли мати там до next->floor входжень:
+     * спершу floor додається всім, а спільним словам потім віднімається */
+    unsigned long long floor = next->floor;
+    if (floor > 0) {
+        for (size_t i = 0; acc->slots != NULL && i <= acc->mask; i++) {
+            if (acc->slots[i].word != NULL) {
+                acc->slots[i].count += floor;
+                acc->slots[i].error += floor;
+            }
+        }
+    }
+
+    for (size_t i = 0; next->slots != NULL && i <= next->mask; i++) {
+        const WordEntry* e = &next->slots[i];
+        if (e->word == NULL) {
+            continue;
+        }
+        if (acc->slots != NULL) {
+            WordEntry* found = wordtable_slot(acc, e->word, e->len, e->hash);
+            if (found->word != NULL) {
+                found->count += e->count - floor;
+                found->error += e->error - floor;
+                continue;
+            }
+        }
+        wordtable_add(acc, e->word, e->len, e->hash, e->count, e->error, 1);
+    }
+    /* Нові записи acc посилаються на слова в пулі next: він переходить до
+     * acc після циклу, бо проріджування всередині циклу замінює пул acc */
+    if (next->blocks != NULL) {
+        WordBlock* last = next->blocks;
+        while (last->next != NULL) {
+            last = last->next;
+        }
+        /* перший блок acc лишається поточним для нових копій */
+        if (acc->blocks != NULL) {
+            last->next = acc->blocks->next;
+            acc->blocks->next = next->blocks;
+        } else {
+            acc->blocks = next->blocks;
+        }
+    }
+    acc->floor += floor;
+    acc->words += next->words;
+    acc->failed |= next->failed;
+
+    free(next->slots);
+    wordtable_init(next);
+}
+
+/* Чи стоїть a вище за b у рейтингу: більший лічильник, за рівності —
+ * менше слово */
+static inline int wordfreq_ranks_above(const WordEntry* a, const WordEntry* b) {
+    if (a->count != b->count) {
+        return a->count > b->count;
+    }
+    uint32_t len = a->len < b->len ? a->len : b->len;
+    int c = memcmp(a->word, b->word, len);
+    return c != 0 ? c < 0 : a->len < b->len;
+}
+
+static inline void wordfreq_sift_down(const WordEntry** heap, size_t n, size_t i) {
+    for (;;) {
+        size_t lowest = i;
+        size_t l = 2 * i + 1;
+        size_t r = l + 1;
+        if (l < n && wordfreq_ranks_above(heap[lowest], heap[l])) {
+            lowest = l;
+        }
+        if (r < n && wordfreq_ranks_above(heap[lowest], heap[r])) {
+            lowest = r;
+        }
+        if (lowest == i) {
+            return;
+        }
+        const WordEntry* t = heap[i];
+        heap[i] = heap[lowest];
+        heap[lowest] = t;
+        i = lowest;
+    }
+}
+
+/* Найчастіші k слів у top за спаданням; повертає їх кількість.
+ * Купа з k записів, у корені — найнижчий у рейтингу. */
+static inline size_t wordtable_top(const WordTable* t, size_t k, const WordEntry** top) {
+    size_t n = 0;
+    for (size_t i = 0; k > 0 && t->slots != NULL && i <= t->mask; i++) {
+        const WordEntry* e = &t->slots[i];
+        if (e->word == NULL) {
+            continue;
+        }
+        if (n < k) {
+            top[n++] = e;
+            for (size_t j = n - 1; j > 0 && wordfreq_ranks_above(top[(j - 1) / 2], top[j]); j = (j - 1) / 2) {
+                const WordEntry* s = top[j];
+                top[j] = top[(j - 1) / 2];
+                top[(j - 1) / 2] = s;
+            }
+        } else if (wordfreq_ranks_above(e, top[0])) {
+            top[0] = e;
+            wordfreq_sift_down(top, n, 0);
+        }
+    }
+    /* пірамідальне сортування: найнижчі йдуть у кінець */
+    for (size_t m = n; m > 1; m--) {
+        const WordEntry* s = top[0];
+        top[0] = top[m - 1];
+        top[m - 1] = s;
+        wordfreq_sift_down(top, m - 1, 0);
+    }
+    return n;
+}
+
+/* Копія найчастіших слів, що не залежить від таблиці: запис результату
+ * (results.h) живе довше за таблицю, яку вже злито далі */
+typedef struct {
+    unsigned char word[WORDFREQ_MAX_WORD];
+    uint32_t len;
+    unsigned long long count;
+    unsigned long long error;
+} WordCount;
+
+typedef struct {
+    WordCount* items;                 /* за спаданням */
+    size_t n;
+    unsigned long long words;
+    size_t distinct;
+    int pruned;                       /* словник проріджувався */
+    int failed;
+} WordTop;
+
+/* 0 — успіх, -1 — бракує пам'яті (top порожній) */
+static inline int wordtop_take(WordTop* top, const WordTable* t, size_t k) {
+    memset(top, 0, sizeof(*top));
+    top->words = t->words;
+    top->distinct = t->used;
+    top->pruned = t->floor > 0;
+    top->failed = t->failed;
+    if (k == 0) {
+        return 0;
+    }
+    const WordEntry** entries = (const WordEntry**)malloc(k * sizeof(*entries));
+    top->items = (WordCount*)malloc(k * sizeof(WordCount));
+    if (entries == NULL || top->items == NULL) {
+        free(entries);
+        free(top->items);
+        top->items = NULL;
+        return -1;
+    }
+    top->n = wordtable_top(t, k, entries);
+    for (size_t i = 0; i < top->n; i++) {
+        memcpy(top->items[i].word, entries[i]->word, entries[i]->len);
+        top->items[i].len = entries[i]->len;
+        top->items[i].count = entries[i]->count;
+        top->items[i].error = entries[i]->error;
+    }
+    free(entries);
+    return 0;
+}
+
+static inline void wordtop_free(WordTop* top) {
+    free(top->items);
+    top->items = NULL;
+    top->n = 0;
+}
+
+/* Слова одного відрізка без роздільників ASCII */
+static inline void wordfreq_segment(WordTable* t, const unsigned char* s, size_t len) {
+    size_t i = 0;
+    while (i < len) {
+        size_t skip = wordfreq_utf8_punct(s, i, len);
+        if (skip == 0) {
+            skip = wordfreq_apostrophe(s, i, len);
+        }
+        if (skip > 0) {
+            i += skip;
+            continue;
+        }
+        size_t start = i;
+        uint32_t hash = 2166136261u;
+        for (;;) {
+            while (i < len) {
+                unsigned char c = s[i];
+                if (c >= 0x80 ? wordfreq_utf8_punct(s, i, len) != 0 || wordfreq_apostrophe(s, i, len) != 0 : c == '\'') {
+                    break;
+                }
+                hash = (hash ^ wordfreq_lower(c)) * 16777619u;
+                i++;
+            }
+            /* апостроф належить слову, якщо за ним продовження */
+            size_t a = i < len ? wordfreq_apostrophe(s, i, len) : 0;
+            if (a == 0 || i + a >= len || wordfreq_utf8_punct(s, i + a, len) != 0 || wordfreq_apostrophe(s, i + a, len) != 0) {
+                break;
+            }
+            for (size_t k = 0; k < a; k++) {
+                hash = (hash ^ s[i + k]) * 16777619u;
+            }
+            i += a;
+        }
+        if (i - start <= WORDFREQ_MAX_WORD) {
+            t->words++;
+            wordtable_add(t, s + start, (uint32_t)(i - start), hash, 1, 0, 0);
+        }
+    }
+}
+
+static inline void wordfreq_fragment_append(WordFragment* f, const unsigned char* data, size_t len) {
+    if (f->overflow || f->len + len > WORDFREQ_MAX_SEGMENT) {
+        f->overflow = 1;
+        return;
+    }
+    memcpy(f->text + f->len, data, len);
+    f->len += len;
+}
+
+static inline void wordfreq_fragment_finish(WordTable* t, WordFragment* f) {
+    if (!f->overflow) {
+        wordfreq_segment(t, f->text, f->len);
+    }
+    f->len = 0;
+    f->overflow = 0;
+}
+
+static inline void wordfreq_init(WordChunk* c) {
+    c->size = 0;
+    wordtable_init(&c->table);
+    c->has_separator = 0;
+    c->head.len = 0;
+    c->head.overflow = 0;
+    c->tail.len = 0;
+    c->tail.overflow = 0;
+}
+
+/* Накопичувач для файлу: початок файлу діє як роздільник */
+static inline void wordfreq_init_file(WordChunk* c) {
+    wordfreq_init(c);
+    c->has_separator = 1;
+}
+
+static inline void wordfreq_free(WordChunk* c) {
+    wordtable_free(&c->table);
+}
+
+static inline void wordfreq_bytes(WordChunk* c, const unsigned char* data, size_t len) {
+    size_t first = 0;
+    while (first < len && !wordfreq_is_separator(data[first])) {
+        first++;
+    }
+    c->size += len;
+    if (first == len) {
+        wordfreq_fragment_append(&c->head, data, len);
+        return;
+    }
+    wordfreq_fragment_append(&c->head, data, first);
+    c->has_separator = 1;
+
+    size_t i = first;
+    while (i < len) {
+        while (i < len && wordfreq_is_separator(data[i])) {
+            i++;
+        }
+        size_t start = i;
+        while (i < len && !wordfreq_is_separator(data[i])) {
+            i++;
+        }
+        if (i == len) {
+            wordfreq_fragment_append(&c->tail, data + start, i - start);
+            break;
+        }
+        if (i - start <= WORDFREQ_MAX_SEGMENT) {
+            wordfreq_segment(&c->table, data + start, i - start);
+        }
+    }
+}
+
+/* acc = acc · next; next звільняється */
+static inline void wordfreq_merge(WordChunk* acc, WordChunk* next) {
+    if (next->size == 0 && !next->has_separator) {
+        wordfreq_free(next);
+        return;
+    }
+    if (acc->size == 0 && !acc->has_separator) {
+        wordfreq_free(acc);
+        *acc = *next;
+        wordtable_init(&next->table);
+        return;
+    }
+    acc->size += next->size;
+    wordtable_merge(&acc->table, &next->table);
+
+    /* Уривок у кінці acc продовжується першим уривком next */
+    WordFragment* open = acc->has_separator ? &acc->tail : &acc->head;
+    wordfreq_fragment_append(open, next->head.text, next->head.len);
+    open->overflow |= next->head.overflow;
+    if (!next->has_separator) {
+        return;
+    }
+    if (acc->has_separator) {
+        wordfreq_fragment_finish(&acc->table, &acc->tail);
+    }
+    acc->has_separator = 1;
+    acc->tail = next->tail;
+}
+
+/* Кінець файлу: останній уривок — повний відрізок */
+static inline void wordfreq_finish(WordChunk* c) {
+    if (c->has_separator) {
+        wordfreq_fragment_finish(&c->table, &c->tail);
+    }
+}
+
+/* Текстова статистика разом із частотами слів за один прохід */
+typedef struct {
+    TextChunk text;     /* першим: &chunk.text годиться і для textscan_ops */
+    WordChunk words;
+} TextWordsChunk;
+
+static inline void textwords_op_init(void* state) {
+    TextWordsChunk* c = (TextWordsChunk*)state;
+    textscan_init(&c->text);
+    wordfreq_init(&c->words);
+}
+
+static inline void textwords_op_scan(void* state, const unsigned char* data, size_t len) {
+    TextWordsChunk* c = (TextWordsChunk*)state;
+    textscan_bytes(&c->text, data, len);
+    wordfreq_bytes(&c->words, data, len);
+}
+
+/* Стан next більше не використовується, тож злиття забирає його таблицю */
+static inline void textwords_op_merge(void* acc, const void* next) {
+    TextWordsChunk* a = (TextWordsChunk*)acc;
+    TextWordsChunk* b = (TextWordsChunk*)next;
+    textscan_merge(&a->text, &b->text);
+    wordfreq_merge(&a->words, &b->words);
+}
+
+static const ChunkScanOps textwords_ops = {
+    sizeof(TextWordsChunk), textwords_op_init, textwords_op_scan, textwords_op_merge
+};
+
+#endif
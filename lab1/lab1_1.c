@@ -5,16 +5,26 @@
 #include <ctype.h>
 #include <stdbool.h>
 #include <float.h>
+#include <math.h>
 #include <unistd.h>
+#include <dirent.h>
+#include <errno.h>
+#include <limits.h>
+#include <time.h>
+#include <sys/stat.h>
 
-#define MAX_FILENAME_LEN 256
-#define MAX_LINE_LEN 1024
-#define MAX_FILES 10
+#include "../common/filetype.h"
+#include "../common/results.h"
+#include "../common/statcache.h"
+#include "../common/wordfreq.h"
+#include "../common/trace.h"
 
-pthread_mutex_t print_mutex = PTHREAD_MUTEX_INITIALIZER;
+#define MAX_FILENAME_LEN PATH_MAX
+#define QUEUE_CAPACITY 256
+/* Скільки готових записів може чекати на вивід (див. results.h) */
+#define RESULT_WINDOW 1024
 
 typedef struct {
-    char filename[MAX_FILENAME_LEN];
     long characters;
     long words;
     long punctuation;
@@ -23,17 +33,121 @@ typedef struct {
 } TextStats;
 
 typedef struct {
-    char filename[MAX_FILENAME_LEN];
     double sum;
     double average;
     double max;
     double min;
+    double variance;
+    double stddev;
+    double median;
+    double p90;
+    double p99;
     long count;
     long positive_count;
     long negative_count;
     long zero_count;
+    LogHistogram histogram;
 } NumberStats;
 
+typedef enum {
+    FILE_TEXT,
+    FILE_NUMBERS,
+    FILE_SKIPPED,
+    FILE_ERROR
+} FileKind;
+
+/* Звідки взято статистику (див. statcache.h) */
+typedef enum {
+    CACHE_SCANNED,              /* повне сканування */
+    CACHE_HIT,                  /* файл не змінився */
+    CACHE_APPENDED              /* дочитано лише дописаний хвіст */
+} CacheUse;
+
+/* Результат одного шляху. Створюється під час обходу аргументів (тоді ж
+ * отримує номер у виводі), заповнюється робочим потоком і виводиться
+ * потоком-писачем, який його й звільняє */
+typedef struct {
+    unsigned long long seq;
+    FileKind kind;
+    char* path;
+    const char* message;        /* FILE_ERROR: що саме не вдалося */
+    int error;                  /* errno або 0 */
+    long long bytes;
+    double confidence;
+    TextStats text;
+    NumberStats numbers;
+    WordTop words;
+    CacheUse cache;
+    StatCacheEntry* fresh;      /* новий запис кешу, забирає писач */
+} FileResult;
+
+/* Підсумок усіх файлів; його веде лише потік-писач */
+typedef struct {
+    long files_processed;
+    long files_skipped;
+    long long bytes_processed;
+    long text_files;
+    long number_files;
+    long cache_hits;
+    long cache_appends;
+    TextStats text;
+    NumberStats numbers;        /* суми, крайні значення, гістограма */
+    double m2;                  /* для дисперсії всіх чисел разом */
+} Summary;
+
+/* Обмежена черга записів: головний потік обходить аргументи і кладе
+ * записи зі шляхами, робочі потоки забирають. Коли черга повна, обхід
+ * чекає, тож пам'ять не росте з кількістю файлів */
+typedef struct {
+    FileResult* items[QUEUE_CAPACITY];
+    int head;
+    int count;
+    int busy;       /* робочих потоків, що саме обробляють файл */
+    bool closed;
+    pthread_mutex_t mutex;
+    pthread_cond_t not_empty;
+    pthread_cond_t not_full;
+} PathQueue;
+
+PathQueue queue = {
+    .mutex = PTHREAD_MUTEX_INITIALIZER,
+    .not_empty = PTHREAD_COND_INITIALIZER,
+    .not_full = PTHREAD_COND_INITIALIZER
+};
+
+/* Потоків сканування на всі файли разом (діапазони байтів, див.
+ * chunkscan.h): файл отримує частку, поділену між зайнятими робочими
+ * потоками, тож ядра не перевантажуються робочі × діапазони разів */
+int scan_threads = 1;
+
+/* Скільки найчастіших слів друкувати (--words[=N]); 0 — частоти не рахуються */
+int word_top = 0;
+
+/* --format=text|jsonl|csv */
+ResultFormat output_format = RESULT_FORMAT_TEXT;
+
+ResultSlots results;
+Summary summary;
+
+/* Кеш статистики між запусками (--no-cache, --rebuild-cache,
+ * --cache-verify, --cache=шлях). Завантажений кеш лише читається, нові
+ * записи збирає потік-писач */
+bool cache_enabled = true;
+bool cache_rebuild = false;
+bool cache_verify = false;
+const char* cache_path = "lab1_1.statcache";
+StatCache cache;
+StatCacheList cache_fresh;
+
+static const char* const cache_use_names[] = { "scan", "hit", "append" };
+
+static const char* const csv_columns[] = {
+    "type", "path", "bytes", "files", "confidence",
+    "characters", "words", "punctuation", "paragraphs", "lines",
+    "count", "sum", "mean", "min", "max", "variance", "stddev", "median", "p90", "p99",
+    "positive", "negative", "zero", "cache", "message"
+};
+
 bool is_punctuation(char c) {
     return (c == '.' || c == ',' || c == ';' || c == ':' || 
             c == '!' || c == '?' || c == '-' || c == '(' || 
@@ -41,150 +155,164 @@ bool is_punctuation(char c) {
             c == '\'' || c == '/' || c == '_');
 }
 
-void* process_text_file(void* arg) {
-    char* filename = (char*)arg;
-    TextStats* stats = (TextStats*)malloc(sizeof(TextStats));
-    
-    if (stats == NULL) {
-        fprintf(stderr, "Помилка виділення пам'яті\n");
-        pthread_exit(NULL);
+/* Найчастіші слова; лічильники після проріджування наближені згори */
+void print_top_words(const WordTop* top) {
+    printf("Найчастіші слова (усього: %llu, різних: %zu):\n", top->words, top->distinct);
+    for (size_t i = 0; i < top->n; i++) {
+        const WordCount* w = &top->items[i];
+        if (w->error > 0) {
+            printf("  %-24.*s %llu (завищено щонайбільше на %llu)\n",
+                   (int)w->len, (const char*)w->word, w->count, w->error);
+        } else {
+            printf("  %-24.*s %llu\n", (int)w->len, (const char*)w->word, w->count);
+        }
     }
-    
-    strncpy(stats->filename, filename, MAX_FILENAME_LEN - 1);
-    stats->filename[MAX_FILENAME_LEN - 1] = '\0';
-    stats->characters = 0;
-    stats->words = 0;
-    stats->punctuation = 0;
-    stats->paragraphs = 0;
-    stats->lines = 0;
-    
-    FILE* file = fopen(filename, "r");
-    if (file == NULL) {
-        pthread_mutex_lock(&print_mutex);
-        fprintf(stderr, "Не вдається відкрити файл: %s\n", filename);
-        pthread_mutex_unlock(&print_mutex);
-        free(stats);
-        pthread_exit(NULL);
+    if (top->pruned) {
+        printf("Словник обмежено до %d записів, рідкісні слова витіснено\n", WORDFREQ_LIMIT);
+    }
+    if (top->failed) {
+        printf("Бракувало пам'яті: частину слів не враховано\n");
     }
+}
+
+/* Статистика з накопичувача файлу — щойно просканованого чи відновленого
+ * з кешу; накопичувач завершується (textscan_finish) */
+void text_result(FileResult* result, TextChunk* text) {
+    TextStats* stats = &result->text;
+    textscan_finish(text);
     
-    char line[MAX_LINE_LEN];
-    bool in_word = false;
-    bool was_empty_line = false;
+    /* Символи UTF-8 (кодові точки), а не байти */
+    stats->lines = (long)textscan_lines(text);
+    stats->words = (long)text->word_starts;
+    stats->paragraphs = (long)text->paragraph_starts;
+    stats->characters = (long)(text->chars - text->classes[TEXTCLASS_SPACE]);
+    stats->punctuation = (long)text->classes[TEXTCLASS_MARK];
     
-    while (fgets(line, MAX_LINE_LEN, file) != NULL) {
-        stats->lines++;
-        
-        if (strlen(line) <= 1) { 
-            was_empty_line = true;
-            continue;
-        } else if (was_empty_line) {
-            stats->paragraphs++;
-            was_empty_line = false;
-        }
-        
-        for (int i = 0; line[i] != '\0'; i++) {
-            if (!isspace(line[i])) {
-                stats->characters++;
-                
-                if (is_punctuation(line[i])) {
-                    stats->punctuation++;
-                }
-            }
-            
-            if (isspace(line[i])) {
-                if (in_word) {
-                    in_word = false;
-                }
-            } else {
-                if (!in_word) {
-                    in_word = true;
-                    stats->words++;
-                }
+    /* Рядок з одного символу без '\n' у кінці файлу fgets повертає як
+     * рядок довжини 1, і він вважається порожнім: не рахуємо його вміст */
+    int last = textscan_tail_byte(text, 1);
+    if (text->size > 0 && last != '\n' && textscan_tail_byte(text, 2) == '\n') {
+        if (!textscan_is_space((unsigned char)last)) {
+            stats->characters--;
+            stats->words--;
+            if (is_punctuation((char)last)) {
+                stats->punctuation--;
             }
         }
-        
-        in_word = false;
+        if (textscan_tail_byte(text, 3) == '\n') {
+            stats->paragraphs--;
+        }
     }
     
     if (stats->lines > 0 && stats->paragraphs == 0) {
         stats->paragraphs = 1;
     }
     
-    fclose(file);
-    
-    pthread_mutex_lock(&print_mutex);
-    printf("\n=== Статистика текстового файлу [%s] ===\n", stats->filename);
-    printf("Кількість символів: %ld\n", stats->characters);
-    printf("Кількість слів: %ld\n", stats->words);
-    printf("Кількість знаків пунктуації: %ld\n", stats->punctuation);
-    printf("Кількість абзаців: %ld\n", stats->paragraphs);
-    printf("Кількість рядків: %ld\n", stats->lines);
-    pthread_mutex_unlock(&print_mutex);
-    
-    pthread_exit((void*)stats);
+    result->kind = FILE_TEXT;
 }
 
-void* process_number_file(void* arg) {
-    char* filename = (char*)arg;
-    NumberStats* stats = (NumberStats*)malloc(sizeof(NumberStats));
+/* Новий запис кешу зі стану файлу до завершення; кеш вимкнено, файл
+ * не звичайний чи це stdin — нічого */
+void cache_remember(FileResult* result, MappedFile* file, const struct stat* st, int kind, StatBuf* state) {
+    if (!cache_enabled || !file->regular || strcmp(result->path, "-") == 0) {
+        free(state->data);
+        return;
+    }
+    result->fresh = statcache_entry_new(st, file->size, file->fd, kind, result->confidence, result->path, state);
+}
+
+/* total — таблиця слів робочого потоку, куди зливаються частоти файлу;
+ * base — запис кешу, якщо до файлу лише дописали (сканується хвіст);
+ * threads — частка потоків сканування для цього файлу */
+void process_text_file(MappedFile* file, const struct stat* st, FileResult* result, WordTable* total,
+                       const StatCacheEntry* base, int threads) {
+    uint64_t trace_start = trace_begin();
     
-    if (stats == NULL) {
-        fprintf(stderr, "Помилка виділення пам'яті\n");
-        pthread_exit(NULL);
+    /* Віртуальний префікс: перед файлом ніби кінець непорожнього рядка,
+     * тож перший рядок не відкриває новий абзац */
+    TextWordsChunk chunk;
+    long long offset = 0;
+    if (base != NULL && statcache_get_text(base, &chunk.text) == 0) {
+        offset = (long long)base->size;
+        result->cache = CACHE_APPENDED;
+    } else {
+        textscan_init_prefix(&chunk.text, "\0\n", 2);
+    }
+    wordfreq_init_file(&chunk.words);
+    const ChunkScanOps* ops = word_top > 0 ? &textwords_ops : &textscan_ops;
+    void* state = word_top > 0 ? (void*)&chunk : (void*)&chunk.text;
+    if (chunkscan_mapped_from(file, ops, threads, offset, state) != 0) {
+        result->kind = FILE_ERROR;
+        result->message = "Не вдається прочитати файл";
+        result->error = errno;
+        wordfreq_free(&chunk.words);
+        trace_end_detail("process_text_file", trace_start, result->path, TRACE_NO_ARG);
+        return;
+    }
+    
+    if (!file->regular) {
+        result->bytes = (long long)chunk.text.size;  /* розмір каналу відомий лише тепер */
     }
     
-    strncpy(stats->filename, filename, MAX_FILENAME_LEN - 1);
-    stats->filename[MAX_FILENAME_LEN - 1] = '\0';
-    stats->sum = 0.0;
-    stats->count = 0;
-    stats->positive_count = 0;
-    stats->negative_count = 0;
-    stats->zero_count = 0;
-    stats->max = -DBL_MAX;
-    stats->min = DBL_MAX;
+    StatBuf saved;
+    statbuf_init(&saved);
+    statcache_put_text(&saved, &chunk.text);
+    cache_remember(result, file, st, STATCACHE_TEXT, &saved);
     
-    FILE* file = fopen(filename, "r");
-    if (file == NULL) {
-        pthread_mutex_lock(&print_mutex);
-        fprintf(stderr, "Не вдається відкрити файл: %s\n", filename);
-        pthread_mutex_unlock(&print_mutex);
-        free(stats);
-        pthread_exit(NULL);
+    text_result(result, &chunk.text);
+    wordfreq_finish(&chunk.words);
+    if (word_top > 0 && wordtop_take(&result->words, &chunk.words.table, (size_t)word_top) != 0) {
+        fprintf(stderr, "Помилка виділення пам'яті\n");
     }
     
-    double value;
-    char line[MAX_LINE_LEN];
+    /* Злиття у таблицю потоку без блокування; таблиця файлу звільняється */
+    wordtable_merge(total, &chunk.words.table);
     
-    while (fgets(line, MAX_LINE_LEN, file) != NULL) {
-        char* token = strtok(line, " \t\n");
-        
-        while (token != NULL) {
-            if (sscanf(token, "%lf", &value) == 1) {
-                stats->sum += value;
-                stats->count++;
-                
-                if (value > stats->max) {
-                    stats->max = value;
-                }
-                
-                if (value < stats->min) {
-                    stats->min = value;
-                }
-                
-                if (value > 0) {
-                    stats->positive_count++;
-                } else if (value < 0) {
-                    stats->negative_count++;
-                } else {
-                    stats->zero_count++;
-                }
-            }
-            
-            token = strtok(NULL, " \t\n");
+    trace_end_detail("process_text_file", trace_start, result->path, TRACE_NO_ARG);
+}
+
+/* Непорожні кошики від найменших від'ємних до найбільших додатних */
+void print_histogram(const LogHistogram* h) {
+    char label[64];
+    printf("Гістограма за порядком величини:\n");
+    for (int b = LOGHIST_SIDE - 1; b >= 0; b--) {
+        if (h->negative[b] > 0) {
+            loghist_label(h, 1, b, label, sizeof(label));
+            printf("  %-24s %llu\n", label, h->negative[b]);
+        }
+    }
+    if (h->zero > 0) {
+        printf("  %-24s %llu\n", "0", h->zero);
+    }
+    for (int b = 0; b < LOGHIST_SIDE; b++) {
+        if (h->positive[b] > 0) {
+            loghist_label(h, 0, b, label, sizeof(label));
+            printf("  %-24s %llu\n", label, h->positive[b]);
         }
     }
+    if (h->nan > 0) {
+        printf("  %-24s %llu\n", "NaN", h->nan);
+    }
+}
+
+/* Статистика з накопичувача файлу; накопичувач завершується */
+void number_result(FileResult* result, NumberChunk* chunk) {
+    NumberStats* stats = &result->numbers;
+    numscan_finish(chunk);
     
-    fclose(file);
+    stats->sum = chunk->acc.sum;
+    stats->count = (long)chunk->acc.count;
+    stats->max = chunk->acc.max;
+    stats->min = chunk->acc.min;
+    stats->positive_count = (long)chunk->acc.positive;
+    stats->negative_count = (long)chunk->acc.negative;
+    stats->zero_count = (long)chunk->acc.zero;
+    stats->variance = numscan_variance(&chunk->acc);
+    stats->stddev = sqrt(stats->variance);
+    stats->median = qsketch_quantile(&chunk->acc.quantiles, 0.5);
+    stats->p90 = qsketch_quantile(&chunk->acc.quantiles, 0.9);
+    stats->p99 = qsketch_quantile(&chunk->acc.quantiles, 0.99);
+    stats->histogram = chunk->acc.histogram;
     
     if (stats->count > 0) {
         stats->average = stats->sum / stats->count;
@@ -192,107 +320,818 @@ void* process_number_file(void* arg) {
         stats->average = 0.0;
     }
     
-    pthread_mutex_lock(&print_mutex);
-    printf("\n=== Статистика числового файлу [%s] ===\n", stats->filename);
-    printf("Кількість чисел: %ld\n", stats->count);
-    printf("Сума чисел: %f\n", stats->sum);
-    printf("Середнє значення: %f\n", stats->average);
-    printf("Максимальне значення: %f\n", stats->max);
-    printf("Мінімальне значення: %f\n", stats->min);
-    printf("Кількість додатніх чисел: %ld\n", stats->positive_count);
-    printf("Кількість від'ємних чисел: %ld\n", stats->negative_count);
-    printf("Кількість нулів: %ld\n", stats->zero_count);
-    pthread_mutex_unlock(&print_mutex);
+    result->kind = FILE_NUMBERS;
+}
+
+void process_number_file(MappedFile* file, const struct stat* st, FileResult* result, const StatCacheEntry* base,
+                         int threads) {
+    uint64_t trace_start = trace_begin();
+    
+    NumberChunk chunk;
+    long long offset = 0;
+    if (base != NULL && statcache_get_numbers(base, &chunk) == 0) {
+        offset = (long long)base->size;
+        result->cache = CACHE_APPENDED;
+    } else {
+        numscan_init_file(&chunk, NUMSCAN_SKIP_INVALID);
+    }
+    if (chunkscan_mapped_from(file, &numscan_skip_ops, threads, offset, &chunk) != 0) {
+        result->kind = FILE_ERROR;
+        result->message = "Не вдається прочитати файл";
+        result->error = errno;
+        trace_end_detail("process_number_file", trace_start, result->path, TRACE_NO_ARG);
+        return;
+    }
+    
+    if (!file->regular) {
+        result->bytes = (long long)chunk.size;
+    }
     
-    pthread_exit((void*)stats);
+    StatBuf saved;
+    statbuf_init(&saved);
+    statcache_put_numbers(&saved, &chunk);
+    cache_remember(result, file, st, STATCACHE_NUMBERS, &saved);
+    
+    number_result(result, &chunk);
+    trace_end_detail("process_number_file", trace_start, result->path, TRACE_NO_ARG);
+}
+
+/* Чи годиться запис кешу: частоти слів у кеші не зберігаються, тож з
+ * --words текстові файли скануються заново */
+bool cache_usable(const StatCacheEntry* e) {
+    return e->kind == STATCACHE_NUMBERS || (e->kind == STATCACHE_TEXT && word_top == 0);
+}
+
+/* Результат незміненого файлу прямо з кешу; 0 — успіх */
+int cache_restore(FileResult* result, const StatCacheEntry* e) {
+    result->confidence = e->confidence;
+    result->bytes = (long long)e->size;
+    result->cache = CACHE_HIT;
+    if (e->kind == STATCACHE_TEXT) {
+        TextChunk text;
+        if (statcache_get_text(e, &text) != 0) {
+            return -1;
+        }
+        text_result(result, &text);
+        return 0;
+    }
+    NumberChunk chunk;
+    if (statcache_get_numbers(e, &chunk) != 0) {
+        return -1;
+    }
+    number_result(result, &chunk);
+    return 0;
+}
+
+void print_text_counts(const TextStats* stats) {
+    printf("Кількість символів: %ld\n", stats->characters);
+    printf("Кількість слів: %ld\n", stats->words);
+    printf("Кількість знаків пунктуації: %ld\n", stats->punctuation);
+    printf("Кількість абзаців: %ld\n", stats->paragraphs);
+    printf("Кількість рядків: %ld\n", stats->lines);
+}
+
+void print_result_text(const FileResult* r) {
+    if (r->kind == FILE_TEXT) {
+        printf("\n=== Статистика текстового файлу [%s] ===\n", r->path);
+        print_text_counts(&r->text);
+        printf("Впевненість визначення типу: %.2f\n", r->confidence);
+        if (word_top > 0) {
+            print_top_words(&r->words);
+        }
+    } else if (r->kind == FILE_NUMBERS) {
+        const NumberStats* stats = &r->numbers;
+        printf("\n=== Статистика числового файлу [%s] ===\n", r->path);
+        printf("Кількість чисел: %ld\n", stats->count);
+        printf("Сума чисел: %f\n", stats->sum);
+        printf("Середнє значення: %f\n", stats->average);
+        printf("Максимальне значення: %f\n", stats->max);
+        printf("Мінімальне значення: %f\n", stats->min);
+        printf("Дисперсія: %f\n", stats->variance);
+        printf("Стандартне відхилення: %f\n", stats->stddev);
+        if (stats->count > 0) {
+            printf("Медіана (наближено): %f\n", stats->median);
+            printf("90-й перцентиль (наближено): %f\n", stats->p90);
+            printf("99-й перцентиль (наближено): %f\n", stats->p99);
+            print_histogram(&stats->histogram);
+        }
+        printf("Кількість додатніх чисел: %ld\n", stats->positive_count);
+        printf("Кількість від'ємних чисел: %ld\n", stats->negative_count);
+        printf("Кількість нулів: %ld\n", stats->zero_count);
+        printf("Впевненість визначення типу: %.2f\n", r->confidence);
+    } else if (r->kind == FILE_SKIPPED) {
+        printf("Пропускаємо файл: %s (не вдалося визначити тип)\n", r->path);
+    } else if (r->error != 0) {
+        fprintf(stderr, "%s: %s (%s)\n", r->message, r->path, strerror(r->error));
+    } else {
+        fprintf(stderr, "%s: %s\n", r->message, r->path);
+    }
 }
 
-int detect_file_type(const char* filename) {
-    FILE* file = fopen(filename, "r");
-    if (file == NULL) {
-        fprintf(stderr, "Не вдається відкрити файл для визначення типу: %s\n", filename);
-        return -1; 
+void json_histogram(ResultJson* j, const LogHistogram* h) {
+    char label[64];
+    ResultJson buckets;
+    ResultJson bucket;
+    result_json_key(j, "histogram");
+    result_json_begin_array(&buckets, j->out);
+    for (int side = 1; side >= 0; side--) {
+        for (int i = 0; i < LOGHIST_SIDE; i++) {
+            int b = side ? LOGHIST_SIDE - 1 - i : i;
+            unsigned long long count = side ? h->negative[b] : h->positive[b];
+            if (count == 0) {
+                continue;
+            }
+            loghist_label(h, side, b, label, sizeof(label));
+            result_json_item(&buckets);
+            result_json_begin(&bucket, j->out);
+            result_json_cstr(&bucket, "bucket", label);
+            result_json_uint(&bucket, "count", count);
+            result_json_end(&bucket);
+        }
+        if (side == 1 && h->zero > 0) {
+            result_json_item(&buckets);
+            result_json_begin(&bucket, j->out);
+            result_json_cstr(&bucket, "bucket", "0");
+            result_json_uint(&bucket, "count", h->zero);
+            result_json_end(&bucket);
+        }
+    }
+    result_json_end_array(&buckets);
+    result_json_uint(j, "nan", h->nan);
+}
+
+void json_top_words(ResultJson* j, const WordTop* top) {
+    ResultJson words;
+    ResultJson items;
+    ResultJson item;
+    result_json_key(j, "top_words");
+    result_json_begin(&words, j->out);
+    result_json_uint(&words, "total", top->words);
+    result_json_uint(&words, "distinct", top->distinct);
+    result_json_bool(&words, "pruned", top->pruned);
+    result_json_bool(&words, "failed", top->failed);
+    result_json_key(&words, "items");
+    result_json_begin_array(&items, j->out);
+    for (size_t i = 0; i < top->n; i++) {
+        result_json_item(&items);
+        result_json_begin(&item, j->out);
+        result_json_text(&item, "word", (const char*)top->items[i].word, top->items[i].len);
+        result_json_uint(&item, "count", top->items[i].count);
+        result_json_uint(&item, "error", top->items[i].error);
+        result_json_end(&item);
+    }
+    result_json_end_array(&items);
+    result_json_end(&words);
+}
+
+void json_text_counts(ResultJson* j, const TextStats* stats) {
+    result_json_int(j, "characters", stats->characters);
+    result_json_int(j, "words", stats->words);
+    result_json_int(j, "punctuation", stats->punctuation);
+    result_json_int(j, "paragraphs", stats->paragraphs);
+    result_json_int(j, "lines", stats->lines);
+}
+
+/* Крайні значення й середнє порожнього файлу — null */
+void json_number_counts(ResultJson* j, const NumberStats* stats) {
+    int any = stats->count > 0;
+    result_json_int(j, "count", stats->count);
+    result_json_real(j, "sum", stats->sum);
+    result_json_real(j, "mean", any ? stats->average : NAN);
+    result_json_real(j, "min", any ? stats->min : NAN);
+    result_json_real(j, "max", any ? stats->max : NAN);
+    result_json_real(j, "variance", stats->variance);
+    result_json_real(j, "stddev", stats->stddev);
+}
+
+static const char* const file_kind_names[] = { "text", "numbers", "skipped", "error" };
+
+void print_result_json(const FileResult* r) {
+    ResultJson j;
+    result_json_begin(&j, stdout);
+    result_json_cstr(&j, "type", file_kind_names[r->kind]);
+    result_json_cstr(&j, "path", r->path);
+    if (r->kind == FILE_TEXT || r->kind == FILE_NUMBERS) {
+        result_json_int(&j, "bytes", r->bytes);
+        result_json_real(&j, "confidence", r->confidence);
+    }
+    if (r->kind == FILE_TEXT) {
+        json_text_counts(&j, &r->text);
+        if (word_top > 0) {
+            json_top_words(&j, &r->words);
+        }
+    } else if (r->kind == FILE_NUMBERS) {
+        json_number_counts(&j, &r->numbers);
+        result_json_real(&j, "median", r->numbers.median);
+        result_json_real(&j, "p90", r->numbers.p90);
+        result_json_real(&j, "p99", r->numbers.p99);
+        result_json_int(&j, "positive", r->numbers.positive_count);
+        result_json_int(&j, "negative", r->numbers.negative_count);
+        result_json_int(&j, "zero", r->numbers.zero_count);
+        json_histogram(&j, &r->numbers.histogram);
+    } else if (r->kind == FILE_SKIPPED) {
+        result_json_cstr(&j, "message", "не вдалося визначити тип");
+    } else {
+        result_json_cstr(&j, "message", r->message);
+        result_json_int(&j, "errno", r->error);
+        if (r->error != 0) {
+            result_json_cstr(&j, "error", strerror(r->error));
+        }
+    }
+    if (cache_enabled && (r->kind == FILE_TEXT || r->kind == FILE_NUMBERS)) {
+        result_json_cstr(&j, "cache", cache_use_names[r->cache]);
+    }
+    result_json_end(&j);
+    fputc('\n', stdout);
+}
+
+/* Стовпці csv_columns; чого в записі немає, те порожнє */
+void print_csv_row(const char* type, const char* path, long long bytes, long files, double confidence,
+                   const TextStats* text, const NumberStats* numbers, int quantiles, const char* cache,
+                   const char* message) {
+    ResultCsv c;
+    result_csv_begin(&c, stdout);
+    result_csv_cstr(&c, type);
+    result_csv_cstr(&c, path);
+    result_csv_int(&c, bytes);
+    if (files > 0) {
+        result_csv_int(&c, files);
+    } else {
+        result_csv_empty(&c);
+    }
+    result_csv_real(&c, confidence);
+    if (text != NULL) {
+        result_csv_int(&c, text->characters);
+        result_csv_int(&c, text->words);
+        result_csv_int(&c, text->punctuation);
+        result_csv_int(&c, text->paragraphs);
+        result_csv_int(&c, text->lines);
+    } else {
+        for (int i = 0; i < 5; i++) {
+            result_csv_empty(&c);
+        }
+    }
+    if (numbers != NULL) {
+        int any = numbers->count > 0;
+        result_csv_int(&c, numbers->count);
+        result_csv_real(&c, numbers->sum);
+        result_csv_real(&c, any ? numbers->average : NAN);
+        result_csv_real(&c, any ? numbers->min : NAN);
+        result_csv_real(&c, any ? numbers->max : NAN);
+        result_csv_real(&c, numbers->variance);
+        result_csv_real(&c, numbers->stddev);
+        result_csv_real(&c, quantiles ? numbers->median : NAN);
+        result_csv_real(&c, quantiles ? numbers->p90 : NAN);
+        result_csv_real(&c, quantiles ? numbers->p99 : NAN);
+        result_csv_int(&c, numbers->positive_count);
+        result_csv_int(&c, numbers->negative_count);
+        result_csv_int(&c, numbers->zero_count);
+    } else {
+        for (int i = 0; i < 13; i++) {
+            result_csv_empty(&c);
+        }
+    }
+    result_csv_cstr(&c, cache);
+    result_csv_cstr(&c, message);
+    result_csv_end(&c);
+}
+
+void print_result_csv(const FileResult* r) {
+    const TextStats* text = r->kind == FILE_TEXT ? &r->text : NULL;
+    const NumberStats* numbers = r->kind == FILE_NUMBERS ? &r->numbers : NULL;
+    double confidence = text != NULL || numbers != NULL ? r->confidence : NAN;
+    const char* message = r->kind == FILE_SKIPPED ? "не вдалося визначити тип" :
+                          r->kind == FILE_ERROR ? r->message : "";
+    const char* cache = cache_enabled && (text != NULL || numbers != NULL) ? cache_use_names[r->cache] : "";
+    if (r->kind == FILE_ERROR && r->error != 0) {
+        char detail[512];
+        snprintf(detail, sizeof(detail), "%s (%s)", r->message, strerror(r->error));
+        print_csv_row(file_kind_names[r->kind], r->path, r->bytes, 0, confidence, text, numbers, 1, cache, detail);
+    } else {
+        print_csv_row(file_kind_names[r->kind], r->path, r->bytes, 0, confidence, text, numbers, 1, cache, message);
+    }
+}
+
+/* Додає файл до підсумку; дисперсія всіх чисел — злиттям за Чаном, як
+ * у numscan_accum_merge() */
+void summary_add(Summary* s, const FileResult* r) {
+    if (r->kind == FILE_SKIPPED || r->kind == FILE_ERROR) {
+        s->files_skipped++;
+        return;
+    }
+    s->files_processed++;
+    s->bytes_processed += r->bytes;
+    s->cache_hits += r->cache == CACHE_HIT;
+    s->cache_appends += r->cache == CACHE_APPENDED;
+    if (r->kind == FILE_TEXT) {
+        s->text_files++;
+        s->text.characters += r->text.characters;
+        s->text.words += r->text.words;
+        s->text.punctuation += r->text.punctuation;
+        s->text.paragraphs += r->text.paragraphs;
+        s->text.lines += r->text.lines;
+        return;
+    }
+    const NumberStats* n = &r->numbers;
+    NumberStats* t = &s->numbers;
+    s->number_files++;
+    if (n->count > 0) {
+        double na = (double)t->count;
+        double nb = (double)n->count;
+        double delta = n->average - t->average;
+        t->average += delta * (nb / (na + nb));
+        s->m2 += n->variance * (nb - 1.0) + delta * delta * (na * nb / (na + nb));
+    }
+    t->count += n->count;
+    t->sum += n->sum;
+    t->positive_count += n->positive_count;
+    t->negative_count += n->negative_count;
+    t->zero_count += n->zero_count;
+    if (n->max > t->max) {
+        t->max = n->max;
+    }
+    if (n->min < t->min) {
+        t->min = n->min;
+    }
+    t->variance = t->count > 1 ? s->m2 / (double)(t->count - 1) : 0.0;
+    t->stddev = sqrt(t->variance);
+    loghist_merge(&t->histogram, &n->histogram);
+}
+
+void summary_init(Summary* s) {
+    memset(s, 0, sizeof(*s));
+    s->numbers.max = -DBL_MAX;
+    s->numbers.min = DBL_MAX;
+    loghist_init(&s->numbers.histogram);
+}
+
+/* Потік-писач: записи приходять строго в порядку постановки в чергу */
+void emit_result(void* record, void* context) {
+    FileResult* r = (FileResult*)record;
+    summary_add((Summary*)context, r);
+    if (r->fresh != NULL) {
+        statcache_list_push(&cache_fresh, r->fresh);  /* без пам'яті запис просто губиться */
+    }
+    if (output_format == RESULT_FORMAT_JSONL) {
+        print_result_json(r);
+    } else if (output_format == RESULT_FORMAT_CSV) {
+        print_result_csv(r);
+    } else {
+        print_result_text(r);
+    }
+    wordtop_free(&r->words);
+    free(r->path);
+    free(r);
+}
+
+void print_summary(const Summary* s, const WordTop* words, double seconds) {
+    if (output_format == RESULT_FORMAT_CSV) {
+        print_csv_row("summary", "", s->bytes_processed, s->files_processed, NAN,
+                      s->text_files > 0 ? &s->text : NULL, s->number_files > 0 ? &s->numbers : NULL, 0, "", "");
+        return;
+    }
+    if (output_format == RESULT_FORMAT_JSONL) {
+        ResultJson j;
+        ResultJson part;
+        result_json_begin(&j, stdout);
+        result_json_cstr(&j, "type", "summary");
+        result_json_int(&j, "files", s->files_processed);
+        result_json_int(&j, "skipped", s->files_skipped);
+        result_json_int(&j, "bytes", s->bytes_processed);
+        result_json_real(&j, "seconds", seconds);
+        if (cache_enabled) {
+            result_json_int(&j, "cache_hits", s->cache_hits);
+            result_json_int(&j, "cache_appends", s->cache_appends);
+        }
+        result_json_key(&j, "text");
+        result_json_begin(&part, stdout);
+        result_json_int(&part, "files", s->text_files);
+        json_text_counts(&part, &s->text);
+        result_json_end(&part);
+        result_json_key(&j, "numbers");
+        result_json_begin(&part, stdout);
+        result_json_int(&part, "files", s->number_files);
+        json_number_counts(&part, &s->numbers);
+        result_json_int(&part, "positive", s->numbers.positive_count);
+        result_json_int(&part, "negative", s->numbers.negative_count);
+        result_json_int(&part, "zero", s->numbers.zero_count);
+        json_histogram(&part, &s->numbers.histogram);
+        result_json_end(&part);
+        if (word_top > 0) {
+            json_top_words(&j, words);
+        }
+        result_json_end(&j);
+        fputc('\n', stdout);
+        return;
     }
     
-    char line[MAX_LINE_LEN];
-    if (fgets(line, MAX_LINE_LEN, file) != NULL) {
-        int digit_count = 0;
-        int char_count = 0;
+    printf("\nОбробка всіх файлів завершена.\n");
+    printf("Оброблено файлів: %ld, пропущено: %ld, обсяг: %.2f МБ, час: %.3f с\n",
+           s->files_processed, s->files_skipped, s->bytes_processed / 1048576.0, seconds);
+    if (seconds > 0.0) {
+        printf("Швидкість: %.1f файлів/с, %.2f МБ/с\n",
+               s->files_processed / seconds, s->bytes_processed / 1048576.0 / seconds);
+    }
+    if (cache_enabled && (s->cache_hits > 0 || s->cache_appends > 0)) {
+        printf("З кешу: без змін %ld, дочитано хвіст %ld\n", s->cache_hits, s->cache_appends);
+    }
+    if (s->files_processed > 1) {
+        printf("\n=== Усі файли ===\n");
+        if (s->text_files > 0) {
+            printf("Текстових файлів: %ld\n", s->text_files);
+            print_text_counts(&s->text);
+        }
+        if (s->number_files > 0) {
+            const NumberStats* n = &s->numbers;
+            printf("Числових файлів: %ld\n", s->number_files);
+            printf("Кількість чисел: %ld\n", n->count);
+            printf("Сума чисел: %f\n", n->sum);
+            if (n->count > 0) {
+                printf("Середнє значення: %f\n", n->average);
+                printf("Максимальне значення: %f\n", n->max);
+                printf("Мінімальне значення: %f\n", n->min);
+                printf("Дисперсія: %f\n", n->variance);
+                printf("Стандартне відхилення: %f\n", n->stddev);
+                print_histogram(&n->histogram);
+            }
+        }
+        if (word_top > 0) {
+            print_top_words(words);
+        }
+    }
+}
+
+void queue_push(FileResult* item) {
+    pthread_mutex_lock(&queue.mutex);
+    while (queue.count == QUEUE_CAPACITY) {
+        pthread_cond_wait(&queue.not_full, &queue.mutex);
+    }
+    queue.items[(queue.head + queue.count) % QUEUE_CAPACITY] = item;
+    queue.count++;
+    pthread_cond_signal(&queue.not_empty);
+    pthread_mutex_unlock(&queue.mutex);
+}
+
+/* NULL, коли черга закрита і порожня. *threads — частка потоків
+ * сканування: бюджет ділиться на зайняті потоки разом із файлами, що
+ * чекають у черзі, тож діапазони розбиваються лише тоді, коли файлів
+ * менше, ніж ядер. Після обробки запису потік викликає queue_done() */
+FileResult* queue_pop(int* threads) {
+    pthread_mutex_lock(&queue.mutex);
+    while (queue.count == 0 && !queue.closed) {
+        pthread_cond_wait(&queue.not_empty, &queue.mutex);
+    }
+    FileResult* item = NULL;
+    if (queue.count > 0) {
+        item = queue.items[queue.head];
+        queue.head = (queue.head + 1) % QUEUE_CAPACITY;
+        queue.count--;
+        queue.busy++;
+        int files = queue.busy + queue.count;
+        *threads = scan_threads / files > 1 ? scan_threads / files : 1;
+        pthread_cond_signal(&queue.not_full);
+    }
+    pthread_mutex_unlock(&queue.mutex);
+    return item;
+}
+
+void queue_done(void) {
+    pthread_mutex_lock(&queue.mutex);
+    queue.busy--;
+    pthread_mutex_unlock(&queue.mutex);
+}
+
+void queue_close(void) {
+    pthread_mutex_lock(&queue.mutex);
+    queue.closed = true;
+    pthread_cond_broadcast(&queue.not_empty);
+    pthread_mutex_unlock(&queue.mutex);
+}
+
+/* arg — таблиця слів цього потоку. Потік нічого не друкує: готовий
+ * запис публікується, а виводить його потік-писач (results.h) */
+void* worker_thread(void* arg) {
+    WordTable* words = (WordTable*)arg;
+    FileResult* result;
+    int threads;
+    
+    while ((result = queue_pop(&threads)) != NULL) {
+        /* Незмінений файл навіть не відкривається */
+        struct stat st;
+        const StatCacheEntry* cached = NULL;
+        if (cache.count > 0 && stat(result->path, &st) == 0) {
+            cached = statcache_find(&cache, &st);
+            if (cached != NULL && !cache_usable(cached)) {
+                cached = NULL;
+            }
+            if (cached != NULL && statcache_unchanged(cached, &st) &&
+                (!cache_verify || statcache_verify_path(result->path, cached)) &&
+                cache_restore(result, cached) == 0) {
+                results_publish(&results, result->seq, result);
+                queue_done();
+                continue;
+            }
+            result->cache = CACHE_SCANNED;
+        }
         
-        for (int i = 0; line[i] != '\0'; i++) {
-            if (isdigit(line[i]) || line[i] == '.' || line[i] == '-' || line[i] == '+' || 
-                isspace(line[i])) {
-                if (isdigit(line[i])) {
-                    digit_count++;
-                }
+        /* Тип визначається за першим блоком того самого відображення
+         * (потоку), яке потім сканує обробник: файл читається один раз.
+         * Файл, до якого лише дописали, зберігає тип із кешу */
+        MappedFile file;
+        FileTypeGuess guess;
+        const StatCacheEntry* base = NULL;
+        int rc = mapped_file_open(&file, result->path);
+        if (rc == 0) {
+            rc = fstat(file.fd, &st);
+        }
+        if (rc == 0 && cached != NULL && file.regular && statcache_grown(cached, &st) &&
+            (unsigned long long)file.size >= cached->size && statcache_verify_fd(file.fd, cached)) {
+            base = cached;
+            guess.type = base->kind == STATCACHE_TEXT ? FILETYPE_TEXT : FILETYPE_NUMBERS;
+            guess.confidence = base->confidence;
+        } else if (rc == 0) {
+            rc = filetype_detect(&file, &guess);
+        }
+        if (rc != 0) {
+            result->kind = FILE_ERROR;
+            result->message = "Не вдається відкрити файл для визначення типу";
+            result->error = errno;
+        } else {
+            result->confidence = guess.confidence;
+            result->bytes = file.regular ? (long long)file.size : 0;
+            if (guess.type == FILETYPE_TEXT) {
+                process_text_file(&file, &st, result, words, base, threads);
+            } else if (guess.type == FILETYPE_NUMBERS) {
+                process_number_file(&file, &st, result, base, threads);
             } else {
-                char_count++;
+                result->kind = FILE_SKIPPED;
             }
         }
+        mapped_file_close(&file);
         
-        fclose(file);
-        
-        if (digit_count > char_count) {
-            return 1; 
-        } else {
-            return 0; 
+        results_publish(&results, result->seq, result);
+        queue_done();
+    }
+    
+    return NULL;
+}
+
+/* Запис зі шляхом і наступним номером у виводі; викликає лише головний
+ * потік (він єдиний резервує номери). NULL — бракує пам'яті */
+FileResult* file_result_new(const char* path) {
+    FileResult* result = (FileResult*)calloc(1, sizeof(FileResult));
+    char* copy = strdup(path);
+    if (result == NULL || copy == NULL) {
+        fprintf(stderr, "Помилка виділення пам'яті\n");
+        free(result);
+        free(copy);
+        return NULL;
+    }
+    result->path = copy;
+    result->seq = results_reserve(&results);
+    return result;
+}
+
+/* Помилка, знайдена ще під час обходу, виводиться на своєму місці серед
+ * результатів */
+void publish_error(const char* path, const char* message, int error) {
+    FileResult* result = file_result_new(path);
+    if (result != NULL) {
+        result->kind = FILE_ERROR;
+        result->message = message;
+        result->error = error;
+        results_publish(&results, result->seq, result);
+    }
+}
+
+void enqueue_path(const char* path, bool from_directory);
+
+/* Рекурсивний обхід каталогу; символьні посилання на каталоги не
+ * розкриваються, щоб не зациклитися */
+void enqueue_directory(const char* dirname) {
+    DIR* dir = opendir(dirname);
+    if (dir == NULL) {
+        publish_error(dirname, "Не вдається відкрити каталог", errno);
+        return;
+    }
+    
+    struct dirent* entry;
+    char path[MAX_FILENAME_LEN];
+    while ((entry = readdir(dir)) != NULL) {
+        if (strcmp(entry->d_name, ".") == 0 || strcmp(entry->d_name, "..") == 0) {
+            continue;
+        }
+        if (snprintf(path, sizeof(path), "%s/%s", dirname, entry->d_name) >= (int)sizeof(path)) {
+            fprintf(stderr, "Задовгий шлях: %s/%s\n", dirname, entry->d_name);
+            continue;
         }
+        enqueue_path(path, true);
     }
     
-    fclose(file);
-    return -1; 
+    closedir(dir);
+}
+
+/* Рядки файлу — шляхи до файлів чи каталогів */
+void enqueue_list_file(const char* listname) {
+    FILE* list = fopen(listname, "r");
+    if (list == NULL) {
+        publish_error(listname, "Не вдається відкрити список файлів", errno);
+        return;
+    }
+    
+    char path[MAX_FILENAME_LEN];
+    while (fgets(path, sizeof(path), list) != NULL) {
+        path[strcspn(path, "\r\n")] = '\0';
+        if (path[0] != '\0') {
+            enqueue_path(path, false);
+        }
+    }
+    
+    fclose(list);
+}
+
+/* Канали, stdin ("-") і пристрої беруться лише з явних аргументів: у
+ * каталозі FIFO без писача заблокував би робочий потік назавжди */
+void enqueue_path(const char* path, bool from_directory) {
+    struct stat st;
+    if (strcmp(path, "-") == 0 && !from_directory) {
+        FileResult* result = file_result_new(path);
+        if (result != NULL) {
+            queue_push(result);
+        }
+        return;
+    }
+    int rc = from_directory ? lstat(path, &st) : stat(path, &st);
+    if (rc != 0) {
+        publish_error(path, "Не вдається відкрити файл", errno);
+        return;
+    }
+    
+    if (S_ISDIR(st.st_mode)) {
+        enqueue_directory(path);
+    } else if (S_ISREG(st.st_mode) || (S_ISLNK(st.st_mode) && stat(path, &st) == 0 && S_ISREG(st.st_mode)) ||
+               (!from_directory && (S_ISFIFO(st.st_mode) || S_ISCHR(st.st_mode)))) {
+        FileResult* result = file_result_new(path);
+        if (result != NULL) {
+            queue_push(result);
+        }
+    }
+}
+
+/* Параметр програми, а не шлях */
+bool is_option(const char* arg) {
+    return strcmp(arg, "--words") == 0 || strncmp(arg, "--words=", 8) == 0 ||
+           strncmp(arg, "--format=", 9) == 0 || strcmp(arg, "--no-cache") == 0 ||
+           strcmp(arg, "--rebuild-cache") == 0 || strcmp(arg, "--cache-verify") == 0 ||
+           strncmp(arg, "--cache=", 8) == 0;
+}
+
+void print_usage(const char* program) {
+    printf("Використання: %s [--words[=N]] [--format=text|jsonl|csv] [--no-cache] [--rebuild-cache]\n"
+           "       [--cache-verify] [--cache=шлях] <файл|каталог|@список|-> ...\n", program);
+    printf("Каталоги обходяться рекурсивно; @список — файл зі шляхами, по одному на рядок;\n");
+    printf("\"-\" — стандартний ввід (канали й FIFO читаються потоково)\n");
+    printf("--words[=N] — N найчастіших слів (типово 10) для кожного файлу і загалом\n");
+    printf("--format — text (типово), jsonl (об'єкт JSON на рядок) або csv; наприкінці —\n");
+    printf("           підсумок усіх файлів. Результати йдуть у порядку аргументів\n");
+    printf("Статистика зберігається в кеші (типово lab1_1.statcache): незмінені файли не\n");
+    printf("читаються, у дописаних читається лише хвіст. --cache-verify звіряє зразки вмісту\n");
+    printf("навіть для незмінених, --rebuild-cache сканує все наново, --no-cache вимикає кеш\n");    printf("--help — ця довідка; інші параметри на \"--\" — помилка, а не ім'я файлу\n");
 }
 
 int main(int argc, char *argv[]) {
     if (argc < 2) {
-        printf("Використання: %s <файл1> <файл2> ... <файлN>\n", argv[0]);
+        print_usage(argv[0]);
         return 1;
     }
     
-    int file_count = argc - 1;
-    if (file_count > MAX_FILES) {
-        printf("Перевищено максимальну кількість файлів (%d). Буде оброблено тільки перші %d файлів.\n", 
-               MAX_FILES, MAX_FILES);
-        file_count = MAX_FILES;
+    trace_init();
+    
+    /* Параметри розбираються до запуску потоків: обробники лише читають їх */
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--words") == 0) {
+            word_top = 10;
+        } else if (strncmp(argv[i], "--words=", 8) == 0) {
+            word_top = atoi(argv[i] + 8);
+            if (word_top <= 0) {
+                fprintf(stderr, "Некоректна кількість слів: %s\n", argv[i] + 8);
+                return 1;
+            }
+        } else if (strncmp(argv[i], "--format=", 9) == 0) {
+            if (result_format_parse(argv[i] + 9, &output_format) != 0) {
+                fprintf(stderr, "Невідомий формат виводу: %s\n", argv[i] + 9);
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--no-cache") == 0) {
+            cache_enabled = false;
+        } else if (strcmp(argv[i], "--rebuild-cache") == 0) {
+            cache_rebuild = true;
+        } else if (strcmp(argv[i], "--cache-verify") == 0) {
+            cache_verify = true;
+        } else if (strncmp(argv[i], "--cache=", 8) == 0) {
+            cache_path = argv[i] + 8;
+        } else if (strcmp(argv[i], "--help") == 0 || strcmp(argv[i], "-h") == 0) {
+            print_usage(argv[0]);
+            return 0;
+        } else if (strncmp(argv[i], "--", 2) == 0) {
+            /* Помилка в назві параметра не стає шляхом до файлу */
+            fprintf(stderr, "Невідомий параметр: %s (див. --help)\n", argv[i]);
+            return 1;
+        }
     }
     
-    pthread_t threads[MAX_FILES];
-    int file_types[MAX_FILES]; 
-    void* thread_results[MAX_FILES];
+    /* Пошкоджений чи чужий кеш — просто порожній */
+    if (cache_enabled && !cache_rebuild && statcache_load(&cache, cache_path, "lab1_1") != 0) {
+        fprintf(stderr, "Не вдається прочитати кеш %s: %s\n", cache_path, strerror(errno));
+    }
     
-    printf("Початок обробки %d файлів...\n", file_count);
+    long cores = sysconf(_SC_NPROCESSORS_ONLN);
+    int worker_count = cores > 0 ? (int)cores : 1;
+    scan_threads = worker_count;
+    pthread_t* workers = (pthread_t*)malloc(worker_count * sizeof(pthread_t));
+    WordTable* worker_words = (WordTable*)malloc(worker_count * sizeof(WordTable));
+    if (workers == NULL || worker_words == NULL) {
+        fprintf(stderr, "Помилка виділення пам'яті\n");
+        return 1;
+    }
     
-    for (int i = 0; i < file_count; i++) {
-        file_types[i] = detect_file_type(argv[i + 1]);
-        
-        if (file_types[i] == 0) { 
-            pthread_create(&threads[i], NULL, process_text_file, argv[i + 1]);
-            printf("Створено потік #%d для обробки текстового файлу: %s\n", i, argv[i + 1]);
-        } else if (file_types[i] == 1) { 
-            pthread_create(&threads[i], NULL, process_number_file, argv[i + 1]);
-            printf("Створено потік #%d для обробки числового файлу: %s\n", i, argv[i + 1]);
-        } else {
-            printf("Пропускаємо файл #%d: %s (не вдалося визначити тип)\n", i, argv[i + 1]);
-            threads[i] = 0; 
-        }
+    if (output_format == RESULT_FORMAT_TEXT) {
+        printf("Початок обробки, робочих потоків: %d...\n", worker_count);
+    } else if (output_format == RESULT_FORMAT_CSV) {
+        result_csv_header(stdout, csv_columns, (int)(sizeof(csv_columns) / sizeof(csv_columns[0])));
     }
     
-    for (int i = 0; i < file_count; i++) {
-        if (threads[i] != 0) {
-            pthread_join(threads[i], &thread_results[i]);
-            printf("Потік #%d завершив обробку\n", i);
+    summary_init(&summary);
+    if (results_init(&results, RESULT_WINDOW, emit_result, &summary) != 0) {
+        fprintf(stderr, "Не вдається запустити потік виводу: %s\n", strerror(errno));
+        return 1;
+    }
+    
+    struct timespec start, end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    
+    /* Потоків вистачає й менше, ніж ядер; далі рахуються лише запущені.
+     * Без жодного робочого потоку обхід заблокувався б на повній черзі */
+    int started = 0;
+    while (started < worker_count) {
+        wordtable_init(&worker_words[started]);
+        int rc = pthread_create(&workers[started], NULL, worker_thread, &worker_words[started]);
+        if (rc != 0) {
+            wordtable_free(&worker_words[started]);
+            if (started == 0) {
+                fprintf(stderr, "Не вдається запустити робочий потік: %s\n", strerror(rc));
+                results_close(&results);
+                return 1;
+            }
+            break;
         }
+        started++;
     }
+    worker_count = started;
     
-    for (int i = 0; i < file_count; i++) {
-        if (thread_results[i] != NULL) {
-            free(thread_results[i]);
+    for (int i = 1; i < argc; i++) {
+        if (is_option(argv[i])) {
+            continue;
+        } else if (argv[i][0] == '@') {
+            enqueue_list_file(argv[i] + 1);
+        } else {
+            enqueue_path(argv[i], false);
         }
     }
+    queue_close();
     
-    pthread_mutex_destroy(&print_mutex);
+    for (int i = 0; i < worker_count; i++) {
+        pthread_join(workers[i], NULL);
+    }
+    /* Писач доводить вивід до кінця; після цього summary вже не змінюється */
+    results_close(&results);
     
-    printf("\nОбробка всіх файлів завершена.\n");
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    double seconds = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+    
+    /* Таблиці потоків зливаються вже після join, без блокувань */
+    for (int i = 1; i < worker_count; i++) {
+        wordtable_merge(&worker_words[0], &worker_words[i]);
+    }
+    WordTop top;
+    if (wordtop_take(&top, &worker_words[0], (size_t)word_top) != 0) {
+        fprintf(stderr, "Помилка виділення пам'яті\n");
+    }
+    wordtable_free(&worker_words[0]);
+    free(worker_words);
+    free(workers);
+    
+    print_summary(&summary, &top, seconds);
+    wordtop_free(&top);
+    
+    /* Без жодного просканованого файлу (усе з кешу чи лише помилки) кеш
+     * не змінився: файл не створюється і не переписується */
+    if (cache_enabled && cache_fresh.count > 0 &&
+        statcache_save(&cache, &cache_fresh, cache_path, "lab1_1") != 0) {
+        fprintf(stderr, "Не вдається записати кеш %s: %s\n", cache_path, strerror(errno));
+    }
+    statcache_list_free(&cache_fresh);
+    statcache_free(&cache);
     
     return 0;
 }
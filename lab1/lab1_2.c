@@ -1,43 +1,121 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <pthread.h>
 #include <math.h>
 #include <time.h>
 
+#include "../common/series.h"
+#include "../common/trace.h"
+
+#define CACHE_LINE 64
+#define PARTITION_COUNT 3
+
+/* Розбиття ведеться цілими блоками SERIES_BLOCK з series.h, тож сума
+ * однакова до біта для будь-якого розбиття і кількості потоків */
+typedef enum {
+    PARTITION_BLOCK,    /* суцільні діапазони блоків однакового розміру */
+    PARTITION_STRIDED,  /* блоки id, id+T, ... */
+    PARTITION_DYNAMIC   /* блоки по одному зі спільного лічильника */
+} Partition;
+
+static const char* partition_names[PARTITION_COUNT] = {"block", "strided", "dynamic"};
+
+/* Точність накопичення сум блоків і їхнього зведення */
+typedef enum {
+    ACCUM_DOUBLE,  /* double з компенсацією Кехена */
+    ACCUM_DD,      /* double-double (ddouble.h) */
+    ACCUM_QUAD     /* __float128, якщо підтримується компілятором */
+} Accumulation;
+
+static const char* accumulation_names[] = {"double", "dd", "quad"};
+
+/* Кожен потік має власну кеш-лінію, тож сусідні описи не
+ * спричиняють хибного розділення */
 typedef struct {
     int thread_id;
     int thread_count;
-    int iterations;
-    double partial_sum;
-} ThreadData;
+    long long iterations;
+    Partition partition;
+    long long* next_block;
+    Accumulation accumulation;
+    double* block_sums;      /* ACCUM_DOUBLE */
+    ddouble* block_sums_dd;  /* ACCUM_DD, ACCUM_QUAD */
+} __attribute__((aligned(CACHE_LINE))) ThreadData;
 
-pthread_mutex_t mutex = PTHREAD_MUTEX_INITIALIZER;
+static void sum_block(ThreadData* data, long long block) {
+    long long first, last;
+    series_block_range(block, data->iterations, &first, &last);
+    if (data->accumulation == ACCUM_DOUBLE) {
+        data->block_sums[block] = series_inv_square_block(first, last);
+    } else if (data->accumulation == ACCUM_DD) {
+        data->block_sums_dd[block] = series_inv_square_block_dd(first, last);
+    } else {
+#ifdef DD_HAVE_FLOAT128
+        data->block_sums_dd[block] = series_inv_square_block_quad(first, last);
+#endif
+    }
+}
 
 void* calculate_partial_sum(void* arg) {
     ThreadData* data = (ThreadData*)arg;
-    double local_sum = 0.0;
+    uint64_t trace_start = trace_begin();
+    long long blocks = series_block_count(data->iterations);
     
-    for (int i = data->thread_id + 1; i <= data->iterations; i += data->thread_count) {
-        local_sum += 1.0 / ((double)i * i);
+    if (data->partition == PARTITION_BLOCK) {
+        long long per_thread = blocks / data->thread_count;
+        long long extra = blocks % data->thread_count;
+        long long first = data->thread_id * per_thread + (data->thread_id < extra ? data->thread_id : extra);
+        long long count = per_thread + (data->thread_id < extra ? 1 : 0);
+        for (long long b = first; b < first + count; b++) {
+            sum_block(data, b);
+        }
+    } else if (data->partition == PARTITION_STRIDED) {
+        for (long long b = data->thread_id; b < blocks; b += data->thread_count) {
+            sum_block(data, b);
+        }
+    } else {
+        for (;;) {
+            long long b = __atomic_fetch_add(data->next_block, 1, __ATOMIC_RELAXED);
+            if (b >= blocks) {
+                break;
+            }
+            sum_block(data, b);
+        }
     }
     
-    data->partial_sum = local_sum;
-    
+    trace_end_detail("calculate_partial_sum", trace_start, NULL, data->thread_id);
     pthread_exit(NULL);
 }
 
-double measure_time(int thread_count, int iterations) {
+/* Паралельна сума 1/i² для i = 1..iterations */
+ddouble parallel_sum(int thread_count, long long iterations, Partition partition,
+                     Accumulation accumulation) {
     pthread_t threads[thread_count];
     ThreadData thread_data[thread_count];
-    
-    struct timespec start, end;
-    clock_gettime(CLOCK_MONOTONIC, &start);
+    long long next_block = 0;
+    long long blocks = series_block_count(iterations);
+    double* block_sums = NULL;
+    ddouble* block_sums_dd = NULL;
+    if (accumulation == ACCUM_DOUBLE) {
+        block_sums = (double*)malloc(blocks * sizeof(double));
+    } else {
+        block_sums_dd = (ddouble*)malloc(blocks * sizeof(ddouble));
+    }
+    if (block_sums == NULL && block_sums_dd == NULL) {
+        perror("Помилка виділення пам'яті");
+        exit(1);
+    }
     
     for (int i = 0; i < thread_count; i++) {
         thread_data[i].thread_id = i;
         thread_data[i].thread_count = thread_count;
         thread_data[i].iterations = iterations;
-        thread_data[i].partial_sum = 0.0;
+        thread_data[i].partition = partition;
+        thread_data[i].next_block = &next_block;
+        thread_data[i].accumulation = accumulation;
+        thread_data[i].block_sums = block_sums;
+        thread_data[i].block_sums_dd = block_sums_dd;
         
         pthread_create(&threads[i], NULL, calculate_partial_sum, (void*)&thread_data[i]);
     }
@@ -46,35 +124,140 @@ double measure_time(int thread_count, int iterations) {
         pthread_join(threads[i], NULL);
     }
     
-    double total_sum = 0.0;
-    for (int i = 0; i < thread_count; i++) {
-        total_sum += thread_data[i].partial_sum;
+    ddouble total_sum;
+    if (accumulation == ACCUM_DOUBLE) {
+        total_sum = dd_make(series_pairwise_sum(block_sums, blocks), 0.0);
+    } else {
+        total_sum = dd_pairwise_sum(block_sums_dd, blocks);
     }
+    free(block_sums);
+    free(block_sums_dd);
+    return total_sum;
+}
+
+double measure_time(int thread_count, long long iterations, Partition partition,
+                    Accumulation accumulation) {
+    struct timespec start, end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    uint64_t trace_start = trace_begin();
+    
+    ddouble total_sum = parallel_sum(thread_count, iterations, partition, accumulation);
     
     clock_gettime(CLOCK_MONOTONIC, &end);
+    trace_end_detail("measure_time", trace_start, partition_names[partition], thread_count);
     
-    double time_ms = (end.tv_sec - start.tv_sec) * 1000.0 + 
+    double time_ms = (end.tv_sec - start.tv_sec) * 1000.0 +
                     (end.tv_nsec - start.tv_nsec) / 1000000.0;
     
-    printf("Потоків: %d, Сума: %.15f, Час: %.3f мс\n", 
-           thread_count, total_sum, time_ms);
+    /* Похибка відносно π²/6 після додавання хвоста ряду: показує саме
+     * втрати на округленні, а не обрив ряду */
+    ddouble tail = dd_make(series_inv_square_tail(iterations, NULL), 0.0);
+    ddouble error = dd_sub(dd_add(total_sum, tail), dd_make(DD_ZETA2_HI, DD_ZETA2_LO));
+    
+    printf("Потоків: %d, Розбиття: %s, Сума: %.15f, Похибка: %.2e, Час: %.3f мс, %.1f млн дод./с\n",
+           thread_count, partition_names[partition], total_sum.hi, fabs(error.hi), time_ms,
+           iterations / (time_ms * 1000.0));
     
     return time_ms;
 }
 
+/* Подвоює кількість доданків, доки залишок хвоста Ейлера–Маклорена
+ * не стане меншим за tolerance */
+int sum_to_tolerance(double tolerance, int thread_count) {
+    const double exact = M_PI * M_PI / 6.0;
+    long long n = 16;
+    double sum, tail, tail_error, error;
+    
+    struct timespec start, end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    
+    for (;;) {
+        sum = parallel_sum(thread_count, n, PARTITION_DYNAMIC, ACCUM_DOUBLE).hi;
+        tail = series_inv_square_tail(n, &tail_error);
+        error = tail_error + series_rounding_error(sum + tail, n);
+        if (tail_error <= tolerance || n >= (1LL << 40)) {
+            break;
+        }
+        n *= 2;
+    }
+    
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    double time_ms = (end.tv_sec - start.tv_sec) * 1000.0 +
+                    (end.tv_nsec - start.tv_nsec) / 1000000.0;
+    
+    printf("Точність: %g, Потоків: %d\n", tolerance, thread_count);
+    printf("Доданків: %lld, Часткова сума: %.15f, Хвіст: %.3e\n", n, sum, tail);
+    printf("Сума: %.15f, Оцінка похибки: %.3e, Фактична похибка: %.3e, Час: %.3f мс\n",
+           sum + tail, error, fabs(sum + tail - exact), time_ms);
+    if (error > tolerance) {
+        printf("Точність %g недосяжна в double через округлення\n", tolerance);
+    }
+    printf("Без оцінки хвоста знадобилося б близько %.0e доданків\n", 1.0 / tolerance);
+    return 0;
+}
+
 int main(int argc, char* argv[]) {
     int max_threads = 16;
-    int iterations = 1000000;
+    long long iterations = 1000000;
+    const char* selected = "all";
+    Accumulation accumulation = ACCUM_DOUBLE;
+    int accumulation_ok = 1;
+    
+    trace_init();
+    
+    if (argc > 1 && strcmp(argv[1], "--tol") == 0) {
+        double tolerance = (argc > 2) ? strtod(argv[2], NULL) : 1e-12;
+        int thread_count = (argc > 3) ? atoi(argv[3]) : 4;
+        if (tolerance <= 0.0 || thread_count < 1) {
+            printf("Використання: %s --tol [точність] [потоків]\n", argv[0]);
+            return 1;
+        }
+        return sum_to_tolerance(tolerance, thread_count);
+    }
     
     if (argc > 1) {
         max_threads = atoi(argv[1]);
     }
     if (argc > 2) {
-        iterations = atoi(argv[2]);
+        iterations = strtoll(argv[2], NULL, 10);
+    }
+    if (argc > 3) {
+        selected = argv[3];
+    }
+    if (argc > 4) {
+        accumulation_ok = 0;
+        for (int a = ACCUM_DOUBLE; a <= ACCUM_QUAD; a++) {
+            if (strcmp(argv[4], accumulation_names[a]) == 0) {
+                accumulation = (Accumulation)a;
+                accumulation_ok = 1;
+            }
+        }
+#ifndef DD_HAVE_FLOAT128
+        if (accumulation == ACCUM_QUAD) {
+            printf("__float128 не підтримується цим компілятором\n");
+            accumulation_ok = 0;
+        }
+#endif
     }
     
-    printf("Обчислення суми ряду 1/n² від n=1 до n=%d\n", iterations);
-    printf("Теоретичне значення при n->∞: π²/6 ≈ 1.644934066848226\n\n");
+    Partition partitions[PARTITION_COUNT];
+    int partition_count = 0;
+    for (int p = 0; p < PARTITION_COUNT; p++) {
+        if (strcmp(selected, "all") == 0 || strcmp(selected, partition_names[p]) == 0) {
+            partitions[partition_count++] = (Partition)p;
+        }
+    }
+    
+    if (max_threads < 1 || iterations < 1 || partition_count == 0 || !accumulation_ok) {
+        printf("Використання: %s [макс_потоків] [кількість_доданків] [block|strided|dynamic|all]"
+               " [double|dd|quad]\n", argv[0]);
+        printf("              %s --tol [точність] [потоків]\n", argv[0]);
+        return 1;
+    }
+    
+    printf("Обчислення суми ряду 1/n² від n=1 до n=%lld\n", iterations);
+    printf("Теоретичне значення при n->∞: π²/6 ≈ 1.644934066848226\n");
+    printf("Накопичення: %s\n\n", accumulation_names[accumulation]);
     
     FILE* data_file = fopen("timing_data.txt", "w");
     if (!data_file) {
@@ -82,11 +265,19 @@ int main(int argc, char* argv[]) {
         return 1;
     }
     
-    fprintf(data_file, "# Потоків\tЧас (мс)\n");
+    fprintf(data_file, "# Потоків");
+    for (int p = 0; p < partition_count; p++) {
+        fprintf(data_file, "\t%s (мс)", partition_names[partitions[p]]);
+    }
+    fprintf(data_file, "\n");
     
     for (int thread_count = 1; thread_count <= max_threads; thread_count++) {
-        double time_ms = measure_time(thread_count, iterations);
-        fprintf(data_file, "%d\t%.3f\n", thread_count, time_ms);
+        fprintf(data_file, "%d", thread_count);
+        for (int p = 0; p < partition_count; p++) {
+            double time_ms = measure_time(thread_count, iterations, partitions[p], accumulation);
+            fprintf(data_file, "\t%.3f", time_ms);
+        }
+        fprintf(data_file, "\n");
     }
     
     fclose(data_file);
@@ -99,7 +290,12 @@ int main(int argc, char* argv[]) {
         fprintf(gnuplot_script, "set xlabel 'Кількість потоків'\n");
         fprintf(gnuplot_script, "set ylabel 'Час виконання (мс)'\n");
         fprintf(gnuplot_script, "set grid\n");
-        fprintf(gnuplot_script, "plot 'timing_data.txt' using 1:2 with linespoints lw 2 pt 7 title 'Час виконання'\n");
+        fprintf(gnuplot_script, "plot");
+        for (int p = 0; p < partition_count; p++) {
+            fprintf(gnuplot_script, "%s 'timing_data.txt' using 1:%d with linespoints lw 2 pt 7 title '%s'",
+                    p > 0 ? "," : "", p + 2, partition_names[partitions[p]]);
+        }
+        fprintf(gnuplot_script, "\n");
         fclose(gnuplot_script);
         
         printf("Створено скрипт plot_script.gp для gnuplot\n");
@@ -1,20 +1,53 @@
 #include <iostream>
-#include <fstream>
-#include <sstream>
 #include <string>
 #include <vector>
 #include <thread>
 #include <mutex>
+#include <atomic>
 #include <algorithm>
 #include <cctype>
 #include <iomanip>
 #include <numeric>
 #include <limits>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <cerrno>
 
-std::mutex cout_mutex;
+#include "../common/filetype.h"
+#include "../common/results.h"
+#include "../common/statcache.h"
+#include "../common/wordfreq.h"
+#include "../common/trace.h"
+
+// Потоків сканування на всі файли разом (діапазони байтів, див.
+// chunkscan.h). Кожен файл має свій потік, тож файл отримує частку,
+// поділену на кількість файлів, що ще обробляються
+const int scanThreads = std::max(1u, std::thread::hardware_concurrency());
+std::atomic<int> runningFiles(0);
+
+// Скільки найчастіших слів друкувати (--words[=N]); 0 — частоти не рахуються
+size_t wordTop = 0;
+
+// --format=text|jsonl|csv
+ResultFormat outputFormat = RESULT_FORMAT_TEXT;
+
+// Кеш статистики між запусками (--no-cache, --rebuild-cache, --cache-verify,
+// --cache=шлях, див. statcache.h). Завантажений кеш лише читається, нові
+// записи збирає потік-писач
+bool cacheEnabled = true;
+bool cacheRebuild = false;
+bool cacheVerify = false;
+std::string cachePath = "lab2_1.statcache";
+StatCache cache;
+StatCacheList cacheFresh;
+
+// Частоти слів усіх файлів: кожен файл зливає сюди свою таблицю один раз,
+// уже після сканування, тож блокування не на гарячому шляху
+WordTable allWords;
+std::mutex words_mutex;
 
 struct TextStatistics {
-    std::string filename;
     size_t total_chars;
     size_t letters;
     size_t digits;
@@ -29,186 +62,710 @@ struct TextStatistics {
 };
 
 struct NumberStatistics {
-    std::string filename;
     double mean;
     double min;
     double max;
+    double variance;
+    double stddev;
+    double median;
+    double p90;
+    double p99;
     size_t count;
     size_t positive_count;
     size_t negative_count;
     size_t zero_count;
     
     NumberStatistics() : mean(0.0), min(std::numeric_limits<double>::max()), 
-                        max(std::numeric_limits<double>::lowest()), count(0),
+                        max(std::numeric_limits<double>::lowest()), variance(0.0), stddev(0.0),
+                        median(0.0), p90(0.0), p99(0.0), count(0),
                         positive_count(0), negative_count(0), zero_count(0) {}
 };
 
+// Результат одного файлу: заповнює потік файлу, виводить і звільняє
+// потік-писач (results.h) — у порядку аргументів
+struct FileRecord {
+    enum Kind { Text, Numbers, Error };
+    // Звідки статистика: повне сканування, незмінений файл із кешу чи
+    // дочитаний дописаний хвіст
+    enum CacheUse { Scanned, Hit, Appended };
+    
+    Kind kind;
+    std::string filename;
+    std::string error;
+    long long bytes;
+    double confidence;
+    TextStatistics text;
+    NumberStatistics numbers;
+    LogHistogram histogram;
+    WordTop words;
+    CacheUse cache;
+    StatCacheEntry* fresh;      // новий запис кешу, забирає писач
+    
+    FileRecord() : kind(Error), bytes(0), confidence(0.0), words(), cache(Scanned), fresh(nullptr) {}
+    ~FileRecord() {
+        wordtop_free(&words);
+        if (fresh != nullptr) {
+            statcache_entry_free(fresh);
+            std::free(fresh);
+        }
+    }
+};
+
+// Підсумок усіх файлів; його веде лише потік-писач
+struct Summary {
+    size_t files;
+    size_t errors;
+    long long bytes;
+    size_t textFiles;
+    size_t numberFiles;
+    size_t cacheHits;
+    size_t cacheAppends;
+    TextStatistics text;
+    NumberStatistics numbers;
+    double m2;
+    LogHistogram histogram;
+    
+    Summary() : files(0), errors(0), bytes(0), textFiles(0), numberFiles(0), cacheHits(0), cacheAppends(0),
+                m2(0.0) {
+        loghist_init(&histogram);
+    }
+};
+
+ResultSlots results;
+Summary summary;
+
+static const char* const csvColumns[] = {
+    "type", "path", "bytes", "files", "confidence",
+    "characters", "letters", "digits", "spaces", "punctuation", "words", "paragraphs", "lines",
+    "count", "mean", "min", "max", "variance", "stddev", "median", "p90", "p99",
+    "positive", "negative", "zero", "cache", "message"
+};
+
+static const char* const cacheUseNames[] = { "scan", "hit", "append" };
+
+// Без відкриття: FIFO без писача заблокував би open(); "-" — stdin
 bool fileExists(const std::string& filename) {
-    std::ifstream file(filename.c_str());
-    return file.good();
+    struct stat st;
+    return filename == "-" || stat(filename.c_str(), &st) == 0;
 }
 
-void processTextFile(const std::string& filename) {
-    TextStatistics stats;
-    stats.filename = filename;
-    
-    std::ifstream file(filename.c_str());
-    if (!file.is_open()) {
-        std::lock_guard<std::mutex> lock(cout_mutex);
-        std::cerr << "Помилка відкриття файлу: " << filename << std::endl;
+// Найчастіші слова; лічильники після проріджування наближені згори
+void printTopWords(const WordTop& top) {
+    std::cout << "Найчастіші слова (усього: " << top.words << ", різних: " << top.distinct << "):\n";
+    for (size_t i = 0; i < top.n; ++i) {
+        const WordCount& w = top.items[i];
+        std::string word(reinterpret_cast<const char*>(w.word), w.len);
+        std::cout << "  " << std::left << std::setw(24) << word << std::right << " " << w.count;
+        if (w.error > 0) {
+            std::cout << " (завищено щонайбільше на " << w.error << ")";
+        }
+        std::cout << std::endl;
+    }
+    if (top.pruned) {
+        std::cout << "Словник обмежено до " << WORDFREQ_LIMIT << " записів, рідкісні слова витіснено\n";
+    }
+    if (top.failed) {
+        std::cout << "Бракувало пам'яті: частину слів не враховано\n";
+    }
+}
+
+// Статистика з накопичувача файлу — щойно просканованого чи відновленого
+// з кешу; накопичувач завершується
+void textRecord(FileRecord& record, TextChunk& text) {
+    TextStatistics& stats = record.text;
+    textscan_finish(&text);
+    
+    // Символи UTF-8 і їхні класи за Unicode (textscan.h); '\n' не входить
+    // до жодного рядка
+    stats.lines = textscan_lines(&text);
+    stats.total_chars = text.chars - text.classes[TEXTCLASS_NEWLINE];
+    stats.letters = text.classes[TEXTCLASS_ALPHA];
+    stats.digits = text.classes[TEXTCLASS_DIGIT];
+    stats.spaces = text.classes[TEXTCLASS_SPACE] - text.classes[TEXTCLASS_NEWLINE];
+    stats.punctuation = text.classes[TEXTCLASS_PUNCT];
+    stats.words = text.word_starts;
+    stats.paragraphs = text.paragraph_starts;
+    record.kind = FileRecord::Text;
+}
+
+// Новий запис кешу зі стану файлу до завершення
+void cacheRemember(FileRecord& record, MappedFile& file, const struct stat& st, int kind, StatBuf& state) {
+    if (!cacheEnabled || !file.regular || record.filename == "-") {
+        std::free(state.data);
+        return;
+    }
+    record.fresh = statcache_entry_new(&st, file.size, file.fd, kind, record.confidence,
+                                       record.filename.c_str(), &state);
+}
+
+// base — запис кешу, якщо до файлу лише дописали: сканується тільки хвіст;
+// threads — частка потоків сканування для цього файлу
+void processTextFile(MappedFile& file, const struct stat& st, FileRecord& record, const StatCacheEntry* base,
+                     int threads) {
+    TraceScope trace("processTextFile", record.filename.c_str());
+    
+    // Віртуальний префікс "\n\n": файл починається з нового абзацу
+    TextWordsChunk chunk;
+    long long offset = 0;
+    if (base != nullptr && statcache_get_text(base, &chunk.text) == 0) {
+        offset = static_cast<long long>(base->size);
+        record.cache = FileRecord::Appended;
+    } else {
+        textscan_init_prefix(&chunk.text, "\n\n", 2);
+    }
+    wordfreq_init_file(&chunk.words);
+    const ChunkScanOps* ops = wordTop > 0 ? &textwords_ops : &textscan_ops;
+    void* state = wordTop > 0 ? static_cast<void*>(&chunk) : static_cast<void*>(&chunk.text);
+    if (chunkscan_mapped_from(&file, ops, threads, offset, state) != 0) {
+        wordfreq_free(&chunk.words);
+        record.error = "Помилка читання файлу";
         return;
     }
     
-    std::string line;
-    bool in_paragraph = false;
+    if (!file.regular) {
+        record.bytes = static_cast<long long>(chunk.text.size);  // розмір каналу відомий лише тепер
+    }
     
-    while (std::getline(file, line)) {
-        stats.lines++;
-        stats.total_chars += line.length();
-        
-        if (!line.empty()) {
-            if (!in_paragraph) {
-                in_paragraph = true;
-                stats.paragraphs++;
-            }
-        } else {
-            in_paragraph = false;
-        }
-        
-        for (size_t i = 0; i < line.length(); ++i) {
-            char c = line[i];
-            if (std::isalpha(c)) stats.letters++;
-            else if (std::isdigit(c)) stats.digits++;
-            else if (std::isspace(c)) stats.spaces++;
-            else if (std::ispunct(c)) stats.punctuation++;
+    StatBuf saved;
+    statbuf_init(&saved);
+    statcache_put_text(&saved, &chunk.text);
+    cacheRemember(record, file, st, STATCACHE_TEXT, saved);
+    
+    textRecord(record, chunk.text);
+    wordfreq_finish(&chunk.words);
+    if (wordTop > 0 && wordtop_take(&record.words, &chunk.words.table, wordTop) != 0) {
+        std::cerr << "Помилка виділення пам'яті\n";
+    }
+    
+    std::lock_guard<std::mutex> lock(words_mutex);
+    wordtable_merge(&allWords, &chunk.words.table);
+}
+
+// Непорожні кошики від найменших від'ємних до найбільших додатних
+void printHistogram(const LogHistogram& h) {
+    char label[64];
+    std::cout << "Гістограма за порядком величини:\n";
+    for (int b = LOGHIST_SIDE - 1; b >= 0; --b) {
+        if (h.negative[b] > 0) {
+            loghist_label(&h, 1, b, label, sizeof(label));
+            std::cout << "  " << std::left << std::setw(24) << label << " " << h.negative[b] << std::endl;
         }
-        
-        std::istringstream iss(line);
-        std::string word;
-        while (iss >> word) {
-            stats.words++;
+    }
+    if (h.zero > 0) {
+        std::cout << "  " << std::left << std::setw(24) << "0" << " " << h.zero << std::endl;
+    }
+    for (int b = 0; b < LOGHIST_SIDE; ++b) {
+        if (h.positive[b] > 0) {
+            loghist_label(&h, 0, b, label, sizeof(label));
+            std::cout << "  " << std::left << std::setw(24) << label << " " << h.positive[b] << std::endl;
         }
     }
-    
-    {
-        std::lock_guard<std::mutex> lock(cout_mutex);
-        std::cout << "\n=== Статистика текстового файлу: " << stats.filename << " ===\n";
-        std::cout << "Загальна кількість символів: " << stats.total_chars << std::endl;
-        std::cout << "Літери: " << stats.letters << std::endl;
-        std::cout << "Цифри: " << stats.digits << std::endl;
-        std::cout << "Пробіли: " << stats.spaces << std::endl;
-        std::cout << "Знаки пунктуації: " << stats.punctuation << std::endl;
-        std::cout << "Кількість слів: " << stats.words << std::endl;
-        std::cout << "Кількість абзаців: " << stats.paragraphs << std::endl;
-        std::cout << "Кількість рядків: " << stats.lines << std::endl;
+    if (h.nan > 0) {
+        std::cout << "  " << std::left << std::setw(24) << "NaN" << " " << h.nan << std::endl;
     }
-    
-    file.close();
+    std::cout << std::right;
 }
 
-void processNumberFile(const std::string& filename) {
-    NumberStatistics stats;
-    stats.filename = filename;
-    
-    std::ifstream file(filename.c_str());
-    if (!file.is_open()) {
-        std::lock_guard<std::mutex> lock(cout_mutex);
-        std::cerr << "Помилка відкриття файлу: " << filename << std::endl;
+// Статистика з накопичувача файлу; накопичувач завершується
+void numberRecord(FileRecord& record, NumberChunk& chunk) {
+    NumberStatistics& stats = record.numbers;
+    numscan_finish(&chunk);
+    
+    stats.count = chunk.acc.count;
+    stats.positive_count = chunk.acc.positive;
+    stats.negative_count = chunk.acc.negative;
+    stats.zero_count = chunk.acc.zero;
+    stats.min = chunk.acc.min;
+    stats.max = chunk.acc.max;
+    if (stats.count > 0) {
+        stats.mean = chunk.acc.sum / stats.count;
+    }
+    stats.variance = numscan_variance(&chunk.acc);
+    stats.stddev = std::sqrt(stats.variance);
+    stats.median = qsketch_quantile(&chunk.acc.quantiles, 0.5);
+    stats.p90 = qsketch_quantile(&chunk.acc.quantiles, 0.9);
+    stats.p99 = qsketch_quantile(&chunk.acc.quantiles, 0.99);
+    record.histogram = chunk.acc.histogram;
+    record.kind = FileRecord::Numbers;
+}
+
+void processNumberFile(MappedFile& file, const struct stat& st, FileRecord& record, const StatCacheEntry* base,
+                       int threads) {
+    TraceScope trace("processNumberFile", record.filename.c_str());
+    
+    // Як і цикл file >> number: розбір зупиняється на першому нечисловому токені
+    NumberChunk chunk;
+    long long offset = 0;
+    if (base != nullptr && statcache_get_numbers(base, &chunk) == 0) {
+        offset = static_cast<long long>(base->size);
+        record.cache = FileRecord::Appended;
+    } else {
+        numscan_init_file(&chunk, NUMSCAN_STOP_AT_INVALID);
+    }
+    if (chunkscan_mapped_from(&file, &numscan_stop_ops, threads, offset, &chunk) != 0) {
+        record.error = "Помилка читання файлу";
         return;
     }
     
-    std::vector<double> numbers;
-    double number;
-    
-    while (file >> number) {
-        numbers.push_back(number);
-        stats.count++;
-        
-        if (number > 0) stats.positive_count++;
-        else if (number < 0) stats.negative_count++;
-        else stats.zero_count++;
-        
-        stats.min = std::min(stats.min, number);
-        stats.max = std::max(stats.max, number);
+    if (!file.regular) {
+        record.bytes = static_cast<long long>(chunk.size);
     }
     
-    if (!numbers.empty()) {
-        stats.mean = std::accumulate(numbers.begin(), numbers.end(), 0.0) / numbers.size();
-    }
+    StatBuf saved;
+    statbuf_init(&saved);
+    statcache_put_numbers(&saved, &chunk);
+    cacheRemember(record, file, st, STATCACHE_NUMBERS, saved);
     
-    {
-        std::lock_guard<std::mutex> lock(cout_mutex);
-        std::cout << "\n=== Статистика числового файлу: " << stats.filename << " ===\n";
-        std::cout << "Кількість чисел: " << stats.count << std::endl;
-        if (stats.count > 0) {
-            std::cout << "Середнє значення: " << stats.mean << std::endl;
-            std::cout << "Мінімальне значення: " << stats.min << std::endl;
-            std::cout << "Максимальне значення: " << stats.max << std::endl;
+    numberRecord(record, chunk);
+}
+
+// Частоти слів у кеші не зберігаються, тож з --words текстові файли
+// скануються заново
+bool cacheUsable(const StatCacheEntry* e) {
+    return e->kind == STATCACHE_NUMBERS || (e->kind == STATCACHE_TEXT && wordTop == 0);
+}
+
+// Результат незміненого файлу прямо з кешу
+bool cacheRestore(FileRecord& record, const StatCacheEntry* e) {
+    record.confidence = e->confidence;
+    record.bytes = static_cast<long long>(e->size);
+    if (e->kind == STATCACHE_TEXT) {
+        TextChunk text;
+        if (statcache_get_text(e, &text) != 0) {
+            return false;
         }
-        std::cout << "Додатних чисел: " << stats.positive_count << std::endl;
-        std::cout << "Від'ємних чисел: " << stats.negative_count << std::endl;
-        std::cout << "Нульових значень: " << stats.zero_count << std::endl;
+        textRecord(record, text);
+    } else {
+        NumberChunk chunk;
+        if (statcache_get_numbers(e, &chunk) != 0) {
+            return false;
+        }
+        numberRecord(record, chunk);
     }
-    
-    file.close();
+    record.cache = FileRecord::Hit;
+    return true;
 }
 
-bool isNumberFile(const std::string& filename) {
-    std::ifstream file(filename.c_str());
-    if (!file.is_open()) {
-        return false;
+// Тип визначається за першим блоком того самого відображення (потоку),
+// яке потім сканує обробник: файл читається один раз. Готовий запис
+// публікується без блокувань, друкує його потік-писач
+void processFile(unsigned long long seq, const std::string& filename) {
+    FileRecord* record = new FileRecord;
+    record->filename = filename;
+    
+    // Незмінений файл навіть не відкривається
+    struct stat st;
+    const StatCacheEntry* cached = nullptr;
+    if (cache.count > 0 && stat(filename.c_str(), &st) == 0) {
+        cached = statcache_find(&cache, &st);
+        if (cached != nullptr && !cacheUsable(cached)) {
+            cached = nullptr;
+        }
+        if (cached != nullptr && statcache_unchanged(cached, &st) &&
+            (!cacheVerify || statcache_verify_path(filename.c_str(), cached)) && cacheRestore(*record, cached)) {
+            results_publish(&results, seq, record);
+            runningFiles--;
+            return;
+        }
     }
     
-    std::string content;
-    std::string line;
-    
-    while (std::getline(file, line)) {
-        if (!content.empty()) content += "\n";
-        content += line;
+    // Файл, до якого лише дописали, зберігає тип із кешу
+    MappedFile file;
+    FileTypeGuess guess;
+    const StatCacheEntry* base = nullptr;
+    int rc = mapped_file_open(&file, filename.c_str());
+    if (rc == 0) {
+        rc = fstat(file.fd, &st);
     }
-    
-    if (content.empty()) {
-        return false;
+    if (rc == 0 && cached != nullptr && file.regular && statcache_grown(cached, &st) &&
+        file.size >= cached->size && statcache_verify_fd(file.fd, cached)) {
+        base = cached;
+        guess.type = base->kind == STATCACHE_TEXT ? FILETYPE_TEXT : FILETYPE_NUMBERS;
+        guess.confidence = base->confidence;
+    } else if (rc == 0) {
+        rc = filetype_detect(&file, &guess);
     }
-    
-    file.close();
-    file.open(filename.c_str());
-    
-    size_t total_chars = content.length();
-    size_t digits = 0;
-    size_t letters = 0;
-    size_t numeric_chars = 0;
-    
-    for (size_t i = 0; i < content.length(); ++i) {
-        char c = content[i];
-        if (std::isdigit(c)) {
-            digits++;
-            numeric_chars++;
-        } else if (std::isalpha(c)) {
-            letters++;
-        } else if (c == '.' || c == '-' || c == '+' || c == 'e' || c == 'E') {
-            numeric_chars++;
+    if (rc != 0) {
+        record->error = "Помилка відкриття файлу";
+    } else {
+        record->confidence = guess.confidence;
+        record->bytes = file.regular ? static_cast<long long>(file.size) : 0;
+        int threads = std::max(1, scanThreads / std::max(1, runningFiles.load()));
+        if (guess.type == FILETYPE_NUMBERS) {
+            processNumberFile(file, st, *record, base, threads);
+        } else {
+            processTextFile(file, st, *record, base, threads);
         }
     }
+    mapped_file_close(&file);
     
-    bool can_parse_as_numbers = true;
-    std::istringstream iss(content);
-    double value;
-    
-    int numbers_parsed = 0;
-    while (iss >> value) {
-        numbers_parsed++;
+    results_publish(&results, seq, record);
+    runningFiles--;
+}
+
+void printTextCounts(const TextStatistics& stats) {
+    std::cout << "Загальна кількість символів: " << stats.total_chars << std::endl;
+    std::cout << "Літери: " << stats.letters << std::endl;
+    std::cout << "Цифри: " << stats.digits << std::endl;
+    std::cout << "Пробіли: " << stats.spaces << std::endl;
+    std::cout << "Знаки пунктуації: " << stats.punctuation << std::endl;
+    std::cout << "Кількість слів: " << stats.words << std::endl;
+    std::cout << "Кількість абзаців: " << stats.paragraphs << std::endl;
+    std::cout << "Кількість рядків: " << stats.lines << std::endl;
+}
+
+void printRecordText(const FileRecord& record) {
+    if (record.kind == FileRecord::Error) {
+        std::cerr << record.error << ": " << record.filename << std::endl;
+        return;
+    }
+    if (record.kind == FileRecord::Text) {
+        std::cout << "\n=== Статистика текстового файлу: " << record.filename << " ===\n";
+        printTextCounts(record.text);
+        std::cout << "Впевненість визначення типу: " << record.confidence << std::endl;
+        if (wordTop > 0) {
+            printTopWords(record.words);
+        }
+        return;
     }
     
-    bool has_significant_numbers = (digits > 0 && letters < digits * 0.1);
-    
-    bool numeric_content_dominates = (numeric_chars > (total_chars - numeric_chars - content.find_first_not_of(" \t\n\r")));
+    const NumberStatistics& stats = record.numbers;
+    std::cout << "\n=== Статистика числового файлу: " << record.filename << " ===\n";
+    std::cout << "Кількість чисел: " << stats.count << std::endl;
+    if (stats.count > 0) {
+        std::cout << "Середнє значення: " << stats.mean << std::endl;
+        std::cout << "Мінімальне значення: " << stats.min << std::endl;
+        std::cout << "Максимальне значення: " << stats.max << std::endl;
+        std::cout << "Дисперсія: " << stats.variance << std::endl;
+        std::cout << "Стандартне відхилення: " << stats.stddev << std::endl;
+        std::cout << "Медіана (наближено): " << stats.median << std::endl;
+        std::cout << "90-й перцентиль (наближено): " << stats.p90 << std::endl;
+        std::cout << "99-й перцентиль (наближено): " << stats.p99 << std::endl;
+        printHistogram(record.histogram);
+    }
+    std::cout << "Додатних чисел: " << stats.positive_count << std::endl;
+    std::cout << "Від'ємних чисел: " << stats.negative_count << std::endl;
+    std::cout << "Нульових значень: " << stats.zero_count << std::endl;
+    std::cout << "Впевненість визначення типу: " << record.confidence << std::endl;
+}
+
+void jsonHistogram(ResultJson& j, const LogHistogram& h) {
+    char label[64];
+    ResultJson buckets;
+    result_json_key(&j, "histogram");
+    result_json_begin_array(&buckets, j.out);
+    for (int side = 1; side >= 0; --side) {
+        for (int i = 0; i < LOGHIST_SIDE; ++i) {
+            int b = side ? LOGHIST_SIDE - 1 - i : i;
+            unsigned long long count = side ? h.negative[b] : h.positive[b];
+            if (count == 0) {
+                continue;
+            }
+            loghist_label(&h, side, b, label, sizeof(label));
+            ResultJson bucket;
+            result_json_item(&buckets);
+            result_json_begin(&bucket, j.out);
+            result_json_cstr(&bucket, "bucket", label);
+            result_json_uint(&bucket, "count", count);
+            result_json_end(&bucket);
+        }
+        if (side == 1 && h.zero > 0) {
+            ResultJson bucket;
+            result_json_item(&buckets);
+            result_json_begin(&bucket, j.out);
+            result_json_cstr(&bucket, "bucket", "0");
+            result_json_uint(&bucket, "count", h.zero);
+            result_json_end(&bucket);
+        }
+    }
+    result_json_end_array(&buckets);
+    result_json_uint(&j, "nan", h.nan);
+}
+
+void jsonTopWords(ResultJson& j, const WordTop& top) {
+    ResultJson words;
+    ResultJson items;
+    result_json_key(&j, "top_words");
+    result_json_begin(&words, j.out);
+    result_json_uint(&words, "total", top.words);
+    result_json_uint(&words, "distinct", top.distinct);
+    result_json_bool(&words, "pruned", top.pruned);
+    result_json_bool(&words, "failed", top.failed);
+    result_json_key(&words, "items");
+    result_json_begin_array(&items, j.out);
+    for (size_t i = 0; i < top.n; ++i) {
+        ResultJson item;
+        result_json_item(&items);
+        result_json_begin(&item, j.out);
+        result_json_text(&item, "word", reinterpret_cast<const char*>(top.items[i].word), top.items[i].len);
+        result_json_uint(&item, "count", top.items[i].count);
+        result_json_uint(&item, "error", top.items[i].error);
+        result_json_end(&item);
+    }
+    result_json_end_array(&items);
+    result_json_end(&words);
+}
+
+void jsonTextCounts(ResultJson& j, const TextStatistics& stats) {
+    result_json_uint(&j, "characters", stats.total_chars);
+    result_json_uint(&j, "letters", stats.letters);
+    result_json_uint(&j, "digits", stats.digits);
+    result_json_uint(&j, "spaces", stats.spaces);
+    result_json_uint(&j, "punctuation", stats.punctuation);
+    result_json_uint(&j, "words", stats.words);
+    result_json_uint(&j, "paragraphs", stats.paragraphs);
+    result_json_uint(&j, "lines", stats.lines);
+}
+
+// Середнє й крайні значення порожнього файлу — null
+void jsonNumberCounts(ResultJson& j, const NumberStatistics& stats) {
+    bool any = stats.count > 0;
+    result_json_uint(&j, "count", stats.count);
+    result_json_real(&j, "mean", any ? stats.mean : NAN);
+    result_json_real(&j, "min", any ? stats.min : NAN);
+    result_json_real(&j, "max", any ? stats.max : NAN);
+    result_json_real(&j, "variance", stats.variance);
+    result_json_real(&j, "stddev", stats.stddev);
+}
+
+void printRecordJson(const FileRecord& record) {
+    static const char* const kinds[] = { "text", "numbers", "error" };
+    ResultJson j;
+    result_json_begin(&j, stdout);
+    result_json_cstr(&j, "type", kinds[record.kind]);
+    result_json_text(&j, "path", record.filename.data(), record.filename.size());
+    if (record.kind == FileRecord::Error) {
+        result_json_text(&j, "message", record.error.data(), record.error.size());
+    } else {
+        result_json_int(&j, "bytes", record.bytes);
+        result_json_real(&j, "confidence", record.confidence);
+    }
+    if (record.kind == FileRecord::Text) {
+        jsonTextCounts(j, record.text);
+        if (wordTop > 0) {
+            jsonTopWords(j, record.words);
+        }
+    } else if (record.kind == FileRecord::Numbers) {
+        jsonNumberCounts(j, record.numbers);
+        result_json_real(&j, "median", record.numbers.median);
+        result_json_real(&j, "p90", record.numbers.p90);
+        result_json_real(&j, "p99", record.numbers.p99);
+        result_json_uint(&j, "positive", record.numbers.positive_count);
+        result_json_uint(&j, "negative", record.numbers.negative_count);
+        result_json_uint(&j, "zero", record.numbers.zero_count);
+        jsonHistogram(j, record.histogram);
+    }
+    if (cacheEnabled && record.kind != FileRecord::Error) {
+        result_json_cstr(&j, "cache", cacheUseNames[record.cache]);
+    }
+    result_json_end(&j);
+    std::fputc('\n', stdout);
+}
+
+// Стовпці csvColumns; чого в рядку немає, те порожнє
+void printCsvRow(const char* type, const std::string& path, long long bytes, size_t files, double confidence,
+                 const TextStatistics* text, const NumberStatistics* numbers, bool quantiles,
+                 const char* cache, const std::string& message) {
+    ResultCsv c;
+    result_csv_begin(&c, stdout);
+    result_csv_cstr(&c, type);
+    result_csv_text(&c, path.data(), path.size());
+    result_csv_int(&c, bytes);
+    if (files > 0) {
+        result_csv_uint(&c, files);
+    } else {
+        result_csv_empty(&c);
+    }
+    result_csv_real(&c, confidence);
+    if (text != nullptr) {
+        result_csv_uint(&c, text->total_chars);
+        result_csv_uint(&c, text->letters);
+        result_csv_uint(&c, text->digits);
+        result_csv_uint(&c, text->spaces);
+        result_csv_uint(&c, text->punctuation);
+        result_csv_uint(&c, text->words);
+        result_csv_uint(&c, text->paragraphs);
+        result_csv_uint(&c, text->lines);
+    } else {
+        for (int i = 0; i < 8; ++i) {
+            result_csv_empty(&c);
+        }
+    }
+    if (numbers != nullptr) {
+        bool any = numbers->count > 0;
+        result_csv_uint(&c, numbers->count);
+        result_csv_real(&c, any ? numbers->mean : NAN);
+        result_csv_real(&c, any ? numbers->min : NAN);
+        result_csv_real(&c, any ? numbers->max : NAN);
+        result_csv_real(&c, numbers->variance);
+        result_csv_real(&c, numbers->stddev);
+        result_csv_real(&c, quantiles ? numbers->median : NAN);
+        result_csv_real(&c, quantiles ? numbers->p90 : NAN);
+        result_csv_real(&c, quantiles ? numbers->p99 : NAN);
+        result_csv_uint(&c, numbers->positive_count);
+        result_csv_uint(&c, numbers->negative_count);
+        result_csv_uint(&c, numbers->zero_count);
+    } else {
+        for (int i = 0; i < 12; ++i) {
+            result_csv_empty(&c);
+        }
+    }
+    result_csv_cstr(&c, cache);
+    result_csv_text(&c, message.data(), message.size());
+    result_csv_end(&c);
+}
+
+void printRecordCsv(const FileRecord& record) {
+    static const char* const kinds[] = { "text", "numbers", "error" };
+    bool ok = record.kind != FileRecord::Error;
+    printCsvRow(kinds[record.kind], record.filename, record.bytes, 0, ok ? record.confidence : NAN,
+                record.kind == FileRecord::Text ? &record.text : nullptr,
+                record.kind == FileRecord::Numbers ? &record.numbers : nullptr, true,
+                cacheEnabled && ok ? cacheUseNames[record.cache] : "", record.error);
+}
+
+// Додає файл до підсумку; дисперсія всіх чисел — злиттям за Чаном, як
+// у numscan_accum_merge()
+void summaryAdd(Summary& s, const FileRecord& record) {
+    if (record.kind == FileRecord::Error) {
+        s.errors++;
+        return;
+    }
+    s.files++;
+    s.bytes += record.bytes;
+    s.cacheHits += record.cache == FileRecord::Hit;
+    s.cacheAppends += record.cache == FileRecord::Appended;
+    if (record.kind == FileRecord::Text) {
+        const TextStatistics& t = record.text;
+        s.textFiles++;
+        s.text.total_chars += t.total_chars;
+        s.text.letters += t.letters;
+        s.text.digits += t.digits;
+        s.text.spaces += t.spaces;
+        s.text.punctuation += t.punctuation;
+        s.text.words += t.words;
+        s.text.paragraphs += t.paragraphs;
+        s.text.lines += t.lines;
+        return;
+    }
+    const NumberStatistics& n = record.numbers;
+    NumberStatistics& total = s.numbers;
+    s.numberFiles++;
+    if (n.count > 0) {
+        double na = static_cast<double>(total.count);
+        double nb = static_cast<double>(n.count);
+        double delta = n.mean - total.mean;
+        total.mean += delta * (nb / (na + nb));
+        s.m2 += n.variance * (nb - 1.0) + delta * delta * (na * nb / (na + nb));
+    }
+    total.count += n.count;
+    total.positive_count += n.positive_count;
+    total.negative_count += n.negative_count;
+    total.zero_count += n.zero_count;
+    total.min = std::min(total.min, n.min);
+    total.max = std::max(total.max, n.max);
+    total.variance = total.count > 1 ? s.m2 / static_cast<double>(total.count - 1) : 0.0;
+    total.stddev = std::sqrt(total.variance);
+    loghist_merge(&s.histogram, &record.histogram);
+}
+
+// Потік-писач: записи приходять строго в порядку аргументів
+void emitRecord(void* data, void* context) {
+    FileRecord* record = static_cast<FileRecord*>(data);
+    summaryAdd(*static_cast<Summary*>(context), *record);
+    if (record->fresh != nullptr) {
+        statcache_list_push(&cacheFresh, record->fresh);  // без пам'яті запис просто губиться
+        record->fresh = nullptr;
+    }
+    if (outputFormat == RESULT_FORMAT_JSONL) {
+        printRecordJson(*record);
+    } else if (outputFormat == RESULT_FORMAT_CSV) {
+        printRecordCsv(*record);
+    } else {
+        printRecordText(*record);
+    }
+    delete record;
+}
+
+void printSummary(const Summary& s, const WordTop& top) {
+    if (outputFormat == RESULT_FORMAT_CSV) {
+        printCsvRow("summary", "", s.bytes, s.files, NAN, s.textFiles > 0 ? &s.text : nullptr,
+                    s.numberFiles > 0 ? &s.numbers : nullptr, false, "", "");
+        return;
+    }
+    if (outputFormat == RESULT_FORMAT_JSONL) {
+        ResultJson j;
+        ResultJson part;
+        result_json_begin(&j, stdout);
+        result_json_cstr(&j, "type", "summary");
+        result_json_uint(&j, "files", s.files);
+        result_json_uint(&j, "errors", s.errors);
+        result_json_int(&j, "bytes", s.bytes);
+        if (cacheEnabled) {
+            result_json_uint(&j, "cache_hits", s.cacheHits);
+            result_json_uint(&j, "cache_appends", s.cacheAppends);
+        }
+        result_json_key(&j, "text");
+        result_json_begin(&part, stdout);
+        result_json_uint(&part, "files", s.textFiles);
+        jsonTextCounts(part, s.text);
+        result_json_end(&part);
+        result_json_key(&j, "numbers");
+        result_json_begin(&part, stdout);
+        result_json_uint(&part, "files", s.numberFiles);
+        jsonNumberCounts(part, s.numbers);
+        result_json_uint(&part, "positive", s.numbers.positive_count);
+        result_json_uint(&part, "negative", s.numbers.negative_count);
+        result_json_uint(&part, "zero", s.numbers.zero_count);
+        jsonHistogram(part, s.histogram);
+        result_json_end(&part);
+        if (wordTop > 0) {
+            jsonTopWords(j, top);
+        }
+        result_json_end(&j);
+        std::fputc('\n', stdout);
+        return;
+    }
     
-    return (has_significant_numbers || numeric_content_dominates) && numbers_parsed > 0;
+    if (cacheEnabled && (s.cacheHits > 0 || s.cacheAppends > 0)) {
+        std::cout << "\nЗ кешу: без змін " << s.cacheHits << ", дочитано хвіст " << s.cacheAppends << std::endl;
+    }
+    if (s.files < 2) {
+        return;
+    }
+    std::cout << "\n=== Усі файли ===\n";
+    if (s.textFiles > 0) {
+        std::cout << "Текстових файлів: " << s.textFiles << std::endl;
+        printTextCounts(s.text);
+    }
+    if (s.numberFiles > 0) {
+        const NumberStatistics& n = s.numbers;
+        std::cout << "Числових файлів: " << s.numberFiles << std::endl;
+        std::cout << "Кількість чисел: " << n.count << std::endl;
+        if (n.count > 0) {
+            std::cout << "Середнє значення: " << n.mean << std::endl;
+            std::cout << "Мінімальне значення: " << n.min << std::endl;
+            std::cout << "Максимальне значення: " << n.max << std::endl;
+            std::cout << "Дисперсія: " << n.variance << std::endl;
+            std::cout << "Стандартне відхилення: " << n.stddev << std::endl;
+            printHistogram(s.histogram);
+        }
+    }
+    if (wordTop > 0) {
+        printTopWords(top);
+    }
 }
 
 void printUsage(const std::string& programName) {
-    std::cout << "Використання: " << programName << " [файл1] [файл2] ...\n";
+    std::cout << "Використання: " << programName << " [--words[=N]] [--format=text|jsonl|csv] [--no-cache]\n"
+              << "       [--rebuild-cache] [--cache-verify] [--cache=шлях] [файл1] [файл2] ...\n";
+    std::cout << "\"-\" — стандартний ввід; канали й FIFO читаються потоково\n";
+    std::cout << "--words[=N] — N найчастіших слів (типово 10) для кожного файлу і загалом\n";
+    std::cout << "--format — text (типово), jsonl (об'єкт JSON на рядок) або csv; наприкінці —\n";
+    std::cout << "           підсумок усіх файлів. Результати йдуть у порядку аргументів\n";
+    std::cout << "Статистика зберігається в кеші (типово lab2_1.statcache): незмінені файли не\n";
+    std::cout << "читаються, у дописаних читається лише хвіст. --cache-verify звіряє зразки вмісту\n";
+    std::cout << "навіть для незмінених, --rebuild-cache сканує все наново, --no-cache вимикає кеш\n";    std::cout << "--help — ця довідка; інші параметри на \"--\" — помилка, а не ім'я файлу\n";
 }
 
 int main(int argc, char* argv[]) {
@@ -217,12 +774,43 @@ int main(int argc, char* argv[]) {
         return 1;
     }
     
+    trace_init();
+    
     std::vector<std::string> filenames;
     
     for (int i = 1; i < argc; ++i) {
         std::string filename = argv[i];
         
-        if (fileExists(filename)) {
+        if (filename == "--words") {
+            wordTop = 10;
+        } else if (filename.compare(0, 8, "--words=") == 0) {
+            int top = std::atoi(filename.c_str() + 8);
+            if (top <= 0) {
+                std::cerr << "Некоректна кількість слів: " << filename.substr(8) << std::endl;
+                return 1;
+            }
+            wordTop = static_cast<size_t>(top);
+        } else if (filename.compare(0, 9, "--format=") == 0) {
+            if (result_format_parse(filename.c_str() + 9, &outputFormat) != 0) {
+                std::cerr << "Невідомий формат виводу: " << filename.substr(9) << std::endl;
+                return 1;
+            }
+        } else if (filename == "--no-cache") {
+            cacheEnabled = false;
+        } else if (filename == "--rebuild-cache") {
+            cacheRebuild = true;
+        } else if (filename == "--cache-verify") {
+            cacheVerify = true;
+        } else if (filename.compare(0, 8, "--cache=") == 0) {
+            cachePath = filename.substr(8);
+        } else if (filename == "--help" || filename == "-h") {
+            printUsage(argv[0]);
+            return 0;
+        } else if (filename.compare(0, 2, "--") == 0) {
+            // Помилка в назві параметра не стає шляхом до файлу
+            std::cerr << "Невідомий параметр: " << filename << " (див. --help)" << std::endl;
+            return 1;
+        } else if (fileExists(filename)) {
             filenames.push_back(filename);
         } else {
             std::cerr << "Файл не існує: " << filename << std::endl;
@@ -234,23 +822,52 @@ int main(int argc, char* argv[]) {
         return 1;
     }
     
-    std::cout << "Початок обробки " << filenames.size() << " файлів...\n";
+    // Пошкоджений чи чужий кеш — просто порожній
+    if (cacheEnabled && !cacheRebuild && statcache_load(&cache, cachePath.c_str(), "lab2_1") != 0) {
+        std::cerr << "Не вдається прочитати кеш " << cachePath << ": " << std::strerror(errno) << std::endl;
+    }
+    
+    if (outputFormat == RESULT_FORMAT_TEXT) {
+        std::cout << "Початок обробки " << filenames.size() << " файлів...\n";
+    } else if (outputFormat == RESULT_FORMAT_CSV) {
+        result_csv_header(stdout, csvColumns, static_cast<int>(sizeof(csvColumns) / sizeof(csvColumns[0])));
+    }
+    
+    // Слот на кожен файл: резервування номерів ніколи не чекає
+    if (results_init(&results, filenames.size(), emitRecord, &summary) != 0) {
+        std::cerr << "Не вдається запустити потік виводу\n";
+        return 1;
+    }
     
     std::vector<std::thread> threads;
+    runningFiles = static_cast<int>(filenames.size());
     
     for (size_t i = 0; i < filenames.size(); ++i) {
-        const std::string& file = filenames[i];
-        if (isNumberFile(file)) {
-            threads.push_back(std::thread(processNumberFile, file));
-        } else {
-            threads.push_back(std::thread(processTextFile, file));
-        }
+        unsigned long long seq = results_reserve(&results);
+        threads.push_back(std::thread(processFile, seq, filenames[i]));
     }
     
     for (size_t i = 0; i < threads.size(); ++i) {
         threads[i].join();
     }
+    results_close(&results);
     
+    WordTop top;
+    if (wordtop_take(&top, &allWords, wordTop) != 0) {
+        std::cerr << "Помилка виділення пам'яті\n";
+    }
+    printSummary(summary, top);
+    wordtop_free(&top);
+    wordtable_free(&allWords);
+    
+    // Без жодного просканованого файлу (усе з кешу чи лише помилки) кеш
+    // не змінився: файл не створюється і не переписується
+    if (cacheEnabled && cacheFresh.count > 0 &&
+        statcache_save(&cache, &cacheFresh, cachePath.c_str(), "lab2_1") != 0) {
+        std::cerr << "Не вдається записати кеш " << cachePath << ": " << std::strerror(errno) << std::endl;
+    }
+    statcache_list_free(&cacheFresh);
+    statcache_free(&cache);
     
     return 0;
 }
@@ -6,46 +6,78 @@
 #include <chrono>
 #include <iomanip>
 #include <string>
+#include <cstring>
 
+#include "../common/autotune.hpp"
+#include "../common/freivalds.hpp"
+#include "../common/huge_alloc.hpp"
+#include "../common/input_file.hpp"
+#include "../common/trace.h"
+
+// Рядки зберігаються неперервно (row-major); великі матриці — на сторінках 2 МБ,
+// щоб обхід стовпця B не торкався нової 4 КБ сторінки кожні кілька рядків
 class Matrix {
 private:
     size_t rows;
     size_t cols;
-    std::vector<std::vector<double>> data;
+    HugeBuffer data;
     
 public:
-    Matrix(size_t r = 0, size_t c = 0) : rows(r), cols(c) {
-        data.resize(rows, std::vector<double>(cols, 0.0));
-    }
+    Matrix(size_t r = 0, size_t c = 0) : rows(r), cols(c), data(r * c * sizeof(double)) {}
     
-    std::vector<double>& operator[](size_t i) {
-        return data[i];
+    double* operator[](size_t i) {
+        return data.as<double>() + i * cols;
     }
     
-    const std::vector<double>& operator[](size_t i) const {
-        return data[i];
+    const double* operator[](size_t i) const {
+        return data.as<double>() + i * cols;
     }
     
     size_t getRows() const { return rows; }
     size_t getCols() const { return cols; }
+    PageBacking getBacking() const { return data.backing(); }
     
-    bool loadFromFile(const std::string& filename) {
-        std::ifstream file(filename.c_str());
+    // Причина невдачі — в error: завантаження йде паралельно, тож друкує
+    // її викликач під cout_mutex
+    bool loadFromFile(const std::string& filename, std::string& error) {
+        InputFile file(filename);
         if (!file.is_open()) {
-            std::cerr << "Помилка відкриття файлу: " << filename << std::endl;
+            error = "не вдається відкрити файл";
             return false;
         }
         
-        file >> rows >> cols;
+        size_t r = 0, c = 0;
+        if (!(file >> r >> c) || r == 0 || c == 0) {
+            error = "некоректний розмір матриці";
+            return false;
+        }
         
-        data.resize(rows, std::vector<double>(cols, 0.0));
+        rows = r;
+        cols = c;
+        data = HugeBuffer(rows * cols * sizeof(double));
         
+        // Обірваний чи пошкоджений стиснений файл закінчується раніше:
+        // неповна матриця не повертається як успішно завантажена
         for (size_t i = 0; i < rows; ++i) {
             for (size_t j = 0; j < cols; ++j) {
-                file >> data[i][j];
+                if (!(file >> (*this)[i][j])) {
+                    error = "прочитано " + std::to_string(i * cols + j) + " з " + std::to_string(rows * cols) +
+                            " елементів";
+                    if (file.error() != 0) {
+                        error += std::string(" (") + std::strerror(file.error()) + ")";
+                    }
+                    *this = Matrix();
+                    return false;
+                }
             }
         }
         
+        if (file.finish() != 0) {
+            error = std::strerror(file.error());
+            *this = Matrix();
+            return false;
+        }
+        
         file.close();
         return true;
     }
@@ -61,7 +93,7 @@ public:
         
         for (size_t i = 0; i < rows; ++i) {
             for (size_t j = 0; j < cols; ++j) {
-                file << data[i][j] << " ";
+                file << (*this)[i][j] << " ";
             }
             file << std::endl;
         }
@@ -73,7 +105,7 @@ public:
     void print() const {
         for (size_t i = 0; i < rows; ++i) {
             for (size_t j = 0; j < cols; ++j) {
-                std::cout << std::setw(8) << std::fixed << std::setprecision(2) << data[i][j] << " ";
+                std::cout << std::setw(8) << std::fixed << std::setprecision(2) << (*this)[i][j] << " ";
             }
             std::cout << std::endl;
         }
@@ -83,28 +115,27 @@ public:
 std::mutex cout_mutex;
 
 void loadMatrixFromFile(Matrix& matrix, const std::string& filename) {
-    if (matrix.loadFromFile(filename)) {
+    std::string error;
+    if (matrix.loadFromFile(filename, error)) {
         std::lock_guard<std::mutex> lock(cout_mutex);
         std::cout << "Матриця завантажена з файлу: " << filename << std::endl;
-        std::cout << "Розмір: " << matrix.getRows() << "x" << matrix.getCols() << std::endl;
+        std::cout << "Розмір: " << matrix.getRows() << "x" << matrix.getCols()
+                  << ", сторінки: " << page_backing_name(matrix.getBacking()) << std::endl;
     } else {
         std::lock_guard<std::mutex> lock(cout_mutex);
-        std::cerr << "Помилка завантаження матриці з файлу: " << filename << std::endl;
+        std::cerr << "Помилка завантаження матриці з файлу: " << filename << ": " << error << std::endl;
     }
 }
 
-void multiplyMatricesPart(const Matrix& A, const Matrix& B, Matrix& C, size_t startRow, size_t endRow) {
-    for (size_t i = startRow; i < endRow; ++i) {
-        for (size_t j = 0; j < B.getCols(); ++j) {
-            C[i][j] = 0.0;
-            for (size_t k = 0; k < A.getCols(); ++k) {
-                C[i][j] += A[i][k] * B[k][j];
-            }
-        }
-    }
+void multiplyMatricesPart(const Matrix& A, const Matrix& B, Matrix& C, size_t startRow, size_t endRow,
+                          const MatmulConfig& config) {
+    TraceScope trace("multiplyMatricesPart", nullptr, static_cast<long long>(endRow - startRow));
+    matmul_rows(A, B, C, A.getCols(), B.getCols(), startRow, endRow, config.kernel, config.tile);
 }
 
-Matrix multiplyMatrices(const Matrix& A, const Matrix& B, size_t numThreads) {
+Matrix multiplyMatrices(const Matrix& A, const Matrix& B, const MatmulConfig& config) {
+    size_t numThreads = std::max<size_t>(1, config.threads);
+    TraceScope trace("multiplyMatrices", nullptr, static_cast<long long>(numThreads));
     if (A.getCols() != B.getRows()) {
         std::cerr << "Помилка: Неможливо помножити матриці. Несумісні розміри." << std::endl;
         return Matrix(0, 0);
@@ -121,7 +152,8 @@ Matrix multiplyMatrices(const Matrix& A, const Matrix& B, size_t numThreads) {
         size_t startRow = t * rowsPerThread;
         size_t endRow = (t == numThreads - 1) ? A.getRows() : (t + 1) * rowsPerThread;
         
-        threads.push_back(std::thread(multiplyMatricesPart, std::ref(A), std::ref(B), std::ref(C), startRow, endRow));
+        threads.push_back(std::thread(multiplyMatricesPart, std::ref(A), std::ref(B), std::ref(C), startRow, endRow,
+                                      std::cref(config)));
     }
     
     for (size_t t = 0; t < threads.size(); ++t) {
@@ -131,6 +163,12 @@ Matrix multiplyMatrices(const Matrix& A, const Matrix& B, size_t numThreads) {
     return C;
 }
 
+Matrix multiplyMatrices(const Matrix& A, const Matrix& B, size_t numThreads) {
+    MatmulConfig config;
+    config.threads = numThreads;
+    return multiplyMatrices(A, B, config);
+}
+
 double measureMultiplicationTime(const Matrix& A, const Matrix& B, size_t numThreads) {
     auto start = std::chrono::high_resolution_clock::now();
     
@@ -174,11 +212,19 @@ void saveTimingData(const std::vector<size_t>& threadCounts, const std::vector<d
 }
 
 int main(int argc, char* argv[]) {
+    bool autotune = (argc > 1 && std::string(argv[1]) == "--autotune");
+    if (autotune) {
+        --argc;
+        ++argv;
+    }
+    
     if (argc != 3 && argc != 4) {
-        std::cout << "Використання: " << argv[0] << " <матриця_A.txt> <матриця_B.txt> [кількість_потоків]" << std::endl;
+        std::cout << "Використання: " << argv[0] << " [--autotune] <матриця_A.txt> <матриця_B.txt> [кількість_потоків]" << std::endl;
         return 1;
     }
     
+    trace_init();
+    
     std::string matrixA_file = argv[1];
     std::string matrixB_file = argv[2];
     
@@ -197,6 +243,11 @@ int main(int argc, char* argv[]) {
     loadA.join();
     loadB.join();
     
+    // Невдале завантаження лишає порожню матрицю
+    if (A.getRows() == 0 || B.getRows() == 0) {
+        return 1;
+    }
+    
     if (A.getCols() != B.getRows()) {
         std::cerr << "Помилка: Неможливо помножити матриці. Несумісні розміри." << std::endl;
         return 1;
@@ -205,6 +256,27 @@ int main(int argc, char* argv[]) {
     std::cout << "Обчислення множення матриць розміром " << A.getRows() << "x" << A.getCols() 
               << " та " << B.getRows() << "x" << B.getCols() << std::endl;
     
+    AutotuneStore tuned("lab2_2");
+    
+    if (autotune) {
+        AutotuneEntry best = autotune_search(A.getRows(), A.getCols(), B.getCols(), [&](const MatmulConfig& config) {
+            auto start = std::chrono::high_resolution_clock::now();
+            Matrix C = multiplyMatrices(A, B, config);
+            auto end = std::chrono::high_resolution_clock::now();
+            return std::chrono::duration<double, std::milli>(end - start).count();
+        });
+        
+        tuned.put(best);
+        if (!tuned.save()) {
+            return 1;
+        }
+        std::cout << "Найкраща конфігурація: " << matmul_kernel_name(best.config.kernel)
+                  << ", плитка " << best.config.tile << ", потоків " << best.config.threads
+                  << ", " << std::fixed << std::setprecision(3) << best.timeMs << " мс" << std::endl;
+        std::cout << "Збережено у файлі: " << tuned.path() << std::endl;
+        return 0;
+    }
+    
     std::vector<size_t> threadCounts;
     std::vector<double> executionTimes;
     
@@ -227,14 +299,36 @@ int main(int argc, char* argv[]) {
         std::cout << "Потоків: " << t << ", Час: " << std::fixed << std::setprecision(3) << avgTime << " мс" << std::endl;
     }
     
-    std::cout << "Виконання множення з " << numThreads << " потоками..." << std::endl;
+    // Ядро й плитка — зі збереженої конфігурації; явно задана кількість
+    // потоків замінює лише збережену кількість потоків
+    MatmulConfig config;
+    config.threads = numThreads;
+    bool exact = false;
+    if (tuned.lookup(A.getRows(), A.getCols(), B.getCols(), config, exact)) {
+        if (argc == 4) {
+            config.threads = numThreads;
+        }
+        std::cout << "Використано " << (exact ? "налаштовану" : "найближчу налаштовану")
+                  << " конфігурацію з " << tuned.path() << ": " << matmul_kernel_name(config.kernel)
+                  << ", плитка " << config.tile << std::endl;
+    }
+    
+    std::cout << "Виконання множення з " << config.threads << " потоками..." << std::endl;
     auto start = std::chrono::high_resolution_clock::now();
-    Matrix C = multiplyMatrices(A, B, numThreads);
+    Matrix C = multiplyMatrices(A, B, config);
     auto end = std::chrono::high_resolution_clock::now();
     
     std::chrono::duration<double, std::milli> duration = end - start;
     std::cout << "Час виконання: " << duration.count() << " мс" << std::endl;
     
+    FreivaldsResult check = freivalds_verify(A, B, C, A.getRows(), A.getCols(), B.getCols());
+    if (check.ok) {
+        std::cout << "Перевірка (Фрейвалдс, " << check.rounds << " раунди): результат коректний" << std::endl;
+    } else {
+        std::cerr << "Перевірка (Фрейвалдс): помилка у рядку " << check.worst_row
+                  << ", відхилення " << check.worst_diff << std::endl;
+    }
+    
     C.saveToFile("result_matrix.txt");
     std::cout << "Результат збережено у файлі: result_matrix.txt" << std::endl;
     
@@ -1,5 +1,4 @@
 #include <iostream>
-#include <fstream>
 #include <future>
 #include <vector>
 #include <string>
@@ -7,6 +6,10 @@
 #include <thread>
 #include <locale>
 #include <algorithm>
+#include <cstring>
+
+#include "../common/input_file.hpp"
+#include "../common/trace.h"
 
 using namespace std;
 
@@ -25,8 +28,9 @@ struct Matrix {
 };
 
 Matrix readMatrixFromFile(const string& filename) {
+    TraceScope trace("readMatrixFromFile", filename.c_str());
     Matrix matrix;
-    ifstream file(filename);
+    InputFile file(filename);
     
     if (!file.is_open()) {
         cerr << "Помилка відкриття файлу: " << filename << endl;
@@ -53,6 +57,11 @@ Matrix readMatrixFromFile(const string& filename) {
     for (int i = 0; i < matrix.size; i++) {
         for (int j = 0; j < matrix.size; j++) {
             if (file.eof()) {
+                if (file.error() != 0) {
+                    cerr << "Помилка читання файлу " << filename << " на елементі [" << i << "][" << j
+                         << "]: " << strerror(file.error()) << endl;
+                    return Matrix();
+                }
                 cerr << "Передчасний кінець файлу при читанні елемента [" << i << "][" << j << "] з файлу: " << filename << endl;
                 return matrix;
             }
@@ -69,12 +78,20 @@ Matrix readMatrixFromFile(const string& filename) {
         }
     }
     
+    // Обірваний чи пошкоджений стиснений файл: навіть якщо всі елементи
+    // прочиталися, частина з них могла бути хибною
+    if (file.finish() != 0) {
+        cerr << "Помилка читання файлу " << filename << ": " << strerror(file.error()) << endl;
+        return Matrix();
+    }
+    
     cout << "Матрицю з файлу " << filename << " зчитано успішно" << endl;
     return matrix;
 }
 
 int main(int argc, char* argv[]) {
     setlocale(LC_ALL, "uk_UA.UTF-8");
+    trace_init();
     if (argc != 5) {
         cerr << "Використання: " << argv[0] << " <файл1> <файл2> <файл3> <файл4>" << endl;
         cerr << "Приклад: " << argv[0] << " matrix1.txt matrix2.txt matrix3.txt matrix4.txt" << endl;
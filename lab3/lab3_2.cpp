@@ -7,6 +7,10 @@
 #include <iomanip>
 #include <string>
 #include <sstream>
+#include <cstring>
+
+#include "../common/freivalds.hpp"
+#include "../common/input_file.hpp"
 
 using namespace std;
 using namespace std::chrono;
@@ -58,26 +62,40 @@ public:
     }
 
     static Matrix loadFromFile(const string& filename) {
-        ifstream file(filename);
+        InputFile file(filename);
         if (!file) {
             cerr << "Не вдалося відкрити файл для читання: " << filename << endl;
             exit(1);
         }
 
-        size_t size;
-        file >> size;
+        size_t size = 0;
+        if (!(file >> size) || size == 0) {
+            cerr << "Некоректний розмір матриці у файлі: " << filename << endl;
+            exit(1);
+        }
 
         Matrix result(size, size);
         
         for (size_t i = 0; i < size; ++i) {
             for (size_t j = 0; j < size; ++j) {
                 if (!(file >> result[i][j])) {
-                    cerr << "Помилка читання даних з файлу: " << filename << endl;
+                    cerr << "Помилка читання даних з файлу: " << filename << ", прочитано "
+                         << i * size + j << " з " << size * size << " елементів";
+                    if (file.error() != 0) {
+                        cerr << " (" << strerror(file.error()) << ")";
+                    }
+                    cerr << endl;
                     exit(1);
                 }
             }
         }
         
+        // Хвіст стисненого файлу перевіряється лише при дочитуванні
+        if (file.finish() != 0) {
+            cerr << "Помилка читання файлу " << filename << ": " << strerror(file.error()) << endl;
+            exit(1);
+        }
+        
         return result;
     }
 };
@@ -150,6 +168,14 @@ int main(int argc, char* argv[]) {
     cout << "Час послідовного множення: " << fixed << setprecision(3) << seqTime << " с" << endl;
     cout << "Час асинхронного множення: " << fixed << setprecision(3) << asyncTime << " с" << endl;
     
+    // Перевірка обох результатів за O(n²) без повторного множення
+    vector<const Matrix*> factors = {&A, &B, &C, &D};
+    vector<size_t> dims = {A.getRows(), A.getCols(), B.getCols(), C.getCols(), D.getCols()};
+    FreivaldsResult seqCheck = freivalds_verify_chain(factors, dims, seqResult);
+    FreivaldsResult asyncCheck = freivalds_verify_chain(factors, dims, asyncResult);
+    cout << "Перевірка послідовного результату: " << (seqCheck.ok ? "коректний" : "ПОМИЛКА") << endl;
+    cout << "Перевірка асинхронного результату: " << (asyncCheck.ok ? "коректний" : "ПОМИЛКА") << endl;
+    
     ofstream report("result.txt");
     if (report) {
         report << "Розмір матриць: " << A.getRows() << "x" << A.getCols() << endl;
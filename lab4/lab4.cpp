@@ -1,6 +1,5 @@
 #include <iostream>
 #include <vector>
-#include <random>
 #include <iomanip>
 #include <boost/thread/thread.hpp>
 #include <boost/thread/mutex.hpp>
@@ -9,6 +8,12 @@
 #include <fstream>
 #include <string>
 #include <sstream>
+#include <cstring>
+
+#include "../common/freivalds.hpp"
+#include "../common/input_file.hpp"
+#include "../common/matrix_gen.hpp"
+#include "../common/trace.h"
 
 struct Matrix {
     std::vector<std::vector<double>> data;
@@ -19,16 +24,16 @@ struct Matrix {
         data.resize(rows, std::vector<double>(cols, 0.0));
     }
 
-    void randomize() {
-        std::random_device rd;
-        std::mt19937 gen(rd());
-        std::uniform_real_distribution<> dis(1.0, 10.0);
+    const std::vector<double>& operator[](size_t i) const {
+        return data[i];
+    }
 
-        for (size_t i = 0; i < rows; ++i) {
-            for (size_t j = 0; j < cols; ++j) {
-                data[i][j] = dis(gen);
-            }
-        }
+    void randomize(uint64_t seed) {
+        MatrixGenOptions opts;
+        opts.seed = seed;
+        opts.a = 1.0;
+        opts.b = 10.0;
+        matrix_generate(data, rows, cols, opts);
     }
 
     void print(const std::string& name) const {
@@ -43,7 +48,7 @@ struct Matrix {
     }
 
     static Matrix loadFromFile(const std::string& filename) {
-        std::ifstream file(filename);
+        InputFile file(filename);
         if (!file.is_open()) {
             throw std::runtime_error("Неможливо відкрити файл: " + filename);
         }
@@ -68,13 +73,20 @@ struct Matrix {
         for (size_t i = 0; i < rows; ++i) {
             std::string line;
             if (!std::getline(file, line)) {
+                std::string reason = file.error() != 0 ? std::string(" (") + std::strerror(file.error()) + ")" : "";
                 throw std::runtime_error("Недостатньо даних в файлі: " + filename + 
-                                        ". Очікувалось " + std::to_string(rows) + " рядків.");
+                                        ". Очікувалось " + std::to_string(rows) + " рядків, прочитано " +
+                                        std::to_string(i) + reason + ".");
             }
             
             std::stringstream line_ss(line);
             for (size_t j = 0; j < cols; ++j) {
                 if (!(line_ss >> matrix.data[i][j])) {
+                    if (file.error() != 0) {
+                        throw std::runtime_error("Помилка читання файлу " + filename + ": " +
+                                                 std::strerror(file.error()) + ". Дані обриваються в рядку " +
+                                                 std::to_string(i+1) + ", стовпці " + std::to_string(j+1) + ".");
+                    }
                     throw std::runtime_error("Помилка при читанні даних з файлу: " + filename + 
                                             ". Рядок " + std::to_string(i+1) + ", стовпець " + 
                                             std::to_string(j+1) + ". Перевірте формат файлу.");
@@ -95,6 +107,12 @@ struct Matrix {
                                     ". Очікувалось " + std::to_string(rows) + " рядків.");
         }
 
+        // Обірваний чи пошкоджений стиснений файл: останній рядок міг
+        // обірватися посеред числа, а контрольна сума — лише в хвості
+        if (file.finish() != 0) {
+            throw std::runtime_error("Помилка читання файлу " + filename + ": " + std::strerror(file.error()));
+        }
+
         file.close();
         
         std::cout << "Успішно завантажено матрицю з файлу " << filename 
@@ -137,6 +155,7 @@ Matrix multiply_matrices(const Matrix& A, const Matrix& B) {
 
 void multiply_matrices_partial(const Matrix& A, const Matrix& B, Matrix& result, 
                                size_t start_row, size_t end_row) {
+    TraceScope trace("multiply_matrices_partial", nullptr, static_cast<long long>(end_row - start_row));
     for (size_t i = start_row; i < end_row; ++i) {
         for (size_t j = 0; j < B.cols; ++j) {
             double sum = 0.0;
@@ -156,6 +175,7 @@ void multiply_matrices_partial(const Matrix& A, const Matrix& B, Matrix& result,
 }
 
 Matrix parallel_multiply_matrices(const Matrix& A, const Matrix& B, int num_threads) {
+    TraceScope trace("parallel_multiply_matrices", nullptr, num_threads);
     if (A.cols != B.rows) {
         throw std::runtime_error("Неможливо помножити матриці: розміри не співпадають");
     }
@@ -232,6 +252,7 @@ void save_matrix_to_file(const Matrix& matrix, const std::string& filename) {
 
 int main() {
     try {
+        trace_init();
         std::cout << "Багатопотокове множення матриць з використанням Boost" << std::endl;
         
         Matrix A = Matrix::loadFromFile(get_file_path("A"));
@@ -310,6 +331,14 @@ int main() {
         std::cout << "Час виконання: " << duration.count() << " мс" << std::endl;
         std::cout << "Розмір результуючої матриці: " << result.rows << "x" << result.cols << std::endl;
         
+        FreivaldsResult check = freivalds_verify_chain<Matrix>(
+            {&A, &B, &C, &D}, {A.rows, A.cols, B.cols, C.cols, D.cols}, result);
+        if (!check.ok) {
+            throw std::runtime_error("Перевірка результату не пройдена: відхилення у рядку " +
+                                     std::to_string(check.worst_row));
+        }
+        std::cout << "Перевірка результату (Фрейвалдс): коректний" << std::endl;
+        
         const std::string result_filename = "result.txt";
         save_matrix_to_file(result, result_filename);
         
@@ -2,39 +2,282 @@
 #include <vector>
 #include <fstream>
 #include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+#include <iomanip>
+#include <cmath>
 #include <omp.h>
 
+#include "../common/series_engine.hpp"
+
 using namespace std;
 
-int main() {
-    constexpr int max_iter = 50000;
-    vector<pair<int, double>> results;
+// Часткова сума на окремій кеш-лінії, щоб потоки не ділили лінію
+struct alignas(64) PaddedSum {
+    double value;
+};
+
+// i*i рахується в double: у int добуток переповнюється вже після i > 46341
+double sum_critical(int64_t max_iter, int n) {
+    double Sum = 0.0;
+    #pragma omp parallel for num_threads(n)
+    for (int64_t i = 1; i <= max_iter; i++) {
+        double term = 1.0 / ((double)i * i);
+        #pragma omp critical
+        Sum += term;
+    }
+    return Sum;
+}
+
+double sum_atomic(int64_t max_iter, int n) {
+    double Sum = 0.0;
+    #pragma omp parallel for num_threads(n)
+    for (int64_t i = 1; i <= max_iter; i++) {
+        double term = 1.0 / ((double)i * i);
+        #pragma omp atomic
+        Sum += term;
+    }
+    return Sum;
+}
+
+double sum_reduction(int64_t max_iter, int n) {
+    double Sum = 0.0;
+    #pragma omp parallel for num_threads(n) reduction(+:Sum)
+    for (int64_t i = 1; i <= max_iter; i++) {
+        Sum += 1.0 / ((double)i * i);
+    }
+    return Sum;
+}
+
+double sum_padded(int64_t max_iter, int n) {
+    vector<PaddedSum> partial(n);
+    #pragma omp parallel num_threads(n)
+    {
+        PaddedSum& mine = partial[omp_get_thread_num()];
+        mine.value = 0.0;
+        #pragma omp for
+        for (int64_t i = 1; i <= max_iter; i++) {
+            mine.value += 1.0 / ((double)i * i);
+        }
+    }
     
-    for (int n = 1; n <= 10; n++) {
-        double Sum = 0.0;
-        
+    double Sum = 0.0;
+    for (const auto& p : partial) {
+        Sum += p.value;
+    }
+    return Sum;
+}
+
+double sum_simd(int64_t max_iter, int n) {
+    double Sum = 0.0;
+    #pragma omp parallel for simd num_threads(n) reduction(+:Sum)
+    for (int64_t i = 1; i <= max_iter; i++) {
+        Sum += 1.0 / ((double)i * i);
+    }
+    return Sum;
+}
+
+// Однаковий до біта результат для будь-якої кількості потоків: блоки
+// фіксованого розміру і попарне зведення їхніх сум (див. series_engine.hpp)
+double sum_blocked(int64_t max_iter, int n) {
+    return series_evaluate(ZetaTerm<2>(), max_iter, n, SeriesBackend::OpenMP).sum;
+}
+
+// Суми блоків у double-double або __float128 і їхнє зведення у double-double
+ddouble sum_blocked_extended(int64_t max_iter, int n, bool quad) {
+    const long long blocks = series_block_count(max_iter);
+    vector<ddouble> block_sums(blocks);
+    #pragma omp parallel for num_threads(n) schedule(dynamic, 4)
+    for (long long b = 0; b < blocks; b++) {
+        long long first, last;
+        series_block_range(b, max_iter, &first, &last);
+#ifdef DD_HAVE_FLOAT128
+        block_sums[b] = quad ? series_inv_square_block_quad(first, last)
+                             : series_inv_square_block_dd(first, last);
+#else
+        (void)quad;
+        block_sums[b] = series_inv_square_block_dd(first, last);
+#endif
+    }
+    return dd_pairwise_sum(block_sums.data(), blocks);
+}
+
+struct Strategy {
+    const char* name;
+    double (*run)(int64_t, int);
+};
+
+const Strategy strategies[] = {
+    {"critical", sum_critical},
+    {"atomic", sum_atomic},
+    {"reduction", sum_reduction},
+    {"padded", sum_padded},
+    {"simd", sum_simd},
+    {"blocked", sum_blocked},
+};
+
+template <class Term>
+void report_series(const char* name, const Term& term, double exact, int64_t terms, int threads) {
+    for (SeriesBackend backend : {SeriesBackend::Threads, SeriesBackend::OpenMP}) {
+        SeriesResult r = series_evaluate(term, terms, threads, backend);
+        cout << setw(8) << name << setw(9) << series_backend_name(backend)
+             << setw(20) << setprecision(15) << r.sum
+             << setw(12) << setprecision(2) << scientific << fabs(r.sum - exact)
+             << setw(12) << fixed << setprecision(3) << r.timeMs
+             << setw(12) << setprecision(1) << r.termsPerSec / 1e6 << defaultfloat << endl;
+    }
+}
+
+// Набір рядів на обох бекендах: сума, відхилення від точного значення, швидкість
+int run_series_catalog(int64_t terms, int threads) {
+    cout << "Ряди для i = 1.." << terms << ", потоків: " << threads << "\n"
+         << "     Ряд   Бекенд                Сума     Похибка    Час (мс)  Млн дод./с" << endl;
+    report_series("zeta2", ZetaTerm<2>(), M_PI * M_PI / 6.0, terms, threads);
+    report_series("zeta4", ZetaTerm<4>(), pow(M_PI, 4) / 90.0, terms, threads);
+    report_series("eta1", EtaTerm<1>(), log(2.0), terms, threads);
+    report_series("leibniz", LeibnizTerm(), M_PI, terms, threads);
+    return 0;
+}
+
+// Точність накопичення: похибка відносно π²/6 після додавання хвоста,
+// тобто саме втрати на округленні, та швидкість
+int run_precision(int64_t terms, int threads) {
+    cout << "Ряд 1/i², i = 1.." << terms << ", потоків: " << threads << "\n"
+         << "Накопичення                Сума     Похибка    Час (мс)  Млн дод./с" << endl;
+    const ddouble exact = dd_make(DD_ZETA2_HI, DD_ZETA2_LO);
+    const ddouble tail = dd_make(series_inv_square_tail(terms, nullptr), 0.0);
+
+    auto report = [&](const char* name, auto run) {
         auto start = chrono::high_resolution_clock::now();
-        
-        #pragma omp parallel for num_threads(n)
-        for (int i = 1; i <= max_iter; i++) {
-            #pragma omp critical
-            Sum += 1.0 / (i * i);
+        ddouble sum = run();
+        chrono::duration<double, milli> elapsed = chrono::high_resolution_clock::now() - start;
+        ddouble error = dd_sub(dd_add(sum, tail), exact);
+        cout << setw(11) << name << setw(20) << setprecision(15) << sum.hi
+             << setw(12) << setprecision(2) << scientific << fabs(error.hi)
+             << setw(12) << fixed << setprecision(3) << elapsed.count()
+             << setw(12) << setprecision(1) << terms / (elapsed.count() * 1000.0) << defaultfloat << endl;
+    };
+
+    report("reduction", [&] { return dd_make(sum_reduction(terms, threads), 0.0); });
+    report("double", [&] { return dd_make(sum_blocked(terms, threads), 0.0); });
+    report("dd", [&] { return sum_blocked_extended(terms, threads, false); });
+#ifdef DD_HAVE_FLOAT128
+    report("quad", [&] { return sum_blocked_extended(terms, threads, true); });
+#endif
+    return 0;
+}
+
+template <class Term>
+void report_tolerance(const char* name, const Term& term, double exact, double tolerance, int threads) {
+    SeriesEstimate e = series_evaluate_to_tolerance(term, tolerance, threads, SeriesBackend::OpenMP);
+    cout << setw(8) << name << setw(20) << setprecision(15) << e.value
+         << setw(12) << setprecision(2) << scientific << e.errorEstimate
+         << setw(12) << fabs(e.value - exact)
+         << setw(12) << e.terms << setw(8) << e.rounds
+         << setw(12) << fixed << setprecision(3) << e.timeMs << defaultfloat
+         << (e.converged ? "" : "  (точність недосяжна)") << endl;
+}
+
+// Ряди з оцінкою хвоста: доданки подвоюються, доки оцінка похибки > tolerance
+int run_series_tolerance(double tolerance, int threads) {
+    cout << "Точність " << tolerance << ", потоків: " << threads << "\n"
+         << "     Ряд            Значення      Оцінка     Похибка    Доданків  Кроків    Час (мс)" << endl;
+    report_tolerance("zeta2", ZetaTerm<2>(), M_PI * M_PI / 6.0, tolerance, threads);
+    report_tolerance("zeta4", ZetaTerm<4>(), pow(M_PI, 4) / 90.0, tolerance, threads);
+    report_tolerance("eta1", EtaTerm<1>(), log(2.0), tolerance, threads);
+    report_tolerance("leibniz", LeibnizTerm(), M_PI, tolerance, threads);
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    string selected = (argc > 1) ? argv[1] : "all";
+    int64_t max_iter = (argc > 2) ? strtoll(argv[2], nullptr, 10) : 50000;
+    int max_threads = (argc > 3) ? atoi(argv[3]) : 10;
+    
+    if (selected == "tol") {
+        double tolerance = (argc > 2) ? strtod(argv[2], nullptr) : 1e-12;
+        if (tolerance > 0.0 && max_threads >= 1) {
+            return run_series_tolerance(tolerance, max_threads);
         }
-        
-        auto end = chrono::high_resolution_clock::now();
-        chrono::duration<double, milli> elapsed = end - start;
-        
-        cout << "Потоків: " << n << ", Час: " << elapsed.count() 
-             << " мс, Сума: " << Sum << endl;
-        
-        results.push_back({n, elapsed.count()});
+    }
+    if (selected == "precision" && max_iter >= 1 && max_threads >= 1) {
+        return run_precision(max_iter, max_threads);
+    }
+    if (selected == "series" && max_iter >= 1 && max_threads >= 1) {
+        return run_series_catalog(max_iter, max_threads);
     }
     
+    vector<Strategy> chosen;
+    for (const auto& s : strategies) {
+        if (selected == "all" || selected == s.name) {
+            chosen.push_back(s);
+        }
+    }
+    
+    if (chosen.empty() || max_iter < 1 || max_threads < 1) {
+        cerr << "Використання: " << argv[0] << " [critical|atomic|reduction|padded|simd|blocked|all]"
+             << " [кількість_доданків] [макс_потоків]\n"
+             << "       " << argv[0] << " series [кількість_доданків] [потоків]\n"
+             << "       " << argv[0] << " precision [кількість_доданків] [потоків]\n"
+             << "       " << argv[0] << " tol [точність=1e-12] [потоків]" << endl;
+        return 1;
+    }
+    
+    cout << "Сума ряду 1/i² для i = 1.." << max_iter << endl;
+    
+    // results[n-1][s] — час стратегії s з n потоками
+    vector<vector<double>> results(max_threads, vector<double>(chosen.size()));
+    
+    for (int n = 1; n <= max_threads; n++) {
+        for (size_t s = 0; s < chosen.size(); s++) {
+            auto start = chrono::high_resolution_clock::now();
+            
+            double Sum = chosen[s].run(max_iter, n);
+            
+            auto end = chrono::high_resolution_clock::now();
+            chrono::duration<double, milli> elapsed = end - start;
+            
+            cout << "Потоків: " << n << ", Стратегія: " << chosen[s].name << ", Час: " << elapsed.count()
+                 << " мс, Сума: " << setprecision(15) << Sum << setprecision(6) << endl;
+            
+            results[n - 1][s] = elapsed.count();
+        }
+    }
+    
+    cout << "\nЧас (мс) за кількістю потоків:\n" << setw(8) << "Потоків";
+    for (const auto& s : chosen) {
+        cout << setw(12) << s.name;
+    }
+    cout << "\n" << fixed << setprecision(3);
+    for (int n = 1; n <= max_threads; n++) {
+        cout << setw(8) << n;
+        for (double t : results[n - 1]) {
+            cout << setw(12) << t;
+        }
+        cout << "\n";
+    }
+    
+    cout << setw(8) << "Приск.";
+    for (size_t s = 0; s < chosen.size(); s++) {
+        cout << setw(11) << results[0][s] / results[max_threads - 1][s] << "x";
+    }
+    cout << "  (" << max_threads << " потоків відносно 1)" << endl;
+    
     ofstream datafile("timing.dat");
     if (datafile.is_open()) {
-        datafile << "# Кількість_потоків Час_виконання(мс)\n";
-        for (const auto& result : results) {
-            datafile << result.first << " " << result.second << "\n";
+        // Рядок заголовка без '#': plot_results.gnu бере з нього назви ліній
+        datafile << "Потоків";
+        for (const auto& s : chosen) {
+            datafile << " " << s.name;
+        }
+        datafile << "\n";
+        for (int n = 1; n <= max_threads; n++) {
+            datafile << n;
+            for (double t : results[n - 1]) {
+                datafile << " " << t;
+            }
+            datafile << "\n";
         }
         datafile.close();
         cout << "Результати збережено у файлі timing.dat" << endl;
@@ -2,15 +2,32 @@
 #include <fstream>
 #include <vector>
 #include <cstdlib>
-#include <ctime>
+#include <string>
 #include <cmath>
 #include <omp.h>
 
+#include "../common/autotune.hpp"
+#include "../common/freivalds.hpp"
+#include "../common/huge_alloc.hpp"
+#include "../common/matrix_gen.hpp"
+
 #define N 1000
 
-void sequential_matrix_multiply(const std::vector<std::vector<double>>& A, 
-                               const std::vector<std::vector<double>>& B, 
-                               std::vector<std::vector<double>>& C, int n) {
+// Квадратна матриця з неперервними рядками; від кількох МБ — на сторінках 2 МБ
+struct Matrix {
+    int n;
+    HugeBuffer data;
+    
+    Matrix(int n, PagePolicy policy = PagePolicy::Auto)
+        : n(n), data(sizeof(double) * n * n, policy) {}
+    
+    double* operator[](int i) { return data.as<double>() + (size_t)i * n; }
+    const double* operator[](int i) const { return data.as<double>() + (size_t)i * n; }
+};
+
+void sequential_matrix_multiply(const Matrix& A, 
+                               const Matrix& B, 
+                               Matrix& C, int n) {
     for (int i = 0; i < n; i++) {
         for (int j = 0; j < n; j++) {
             C[i][j] = 0.0;
@@ -21,9 +38,9 @@ void sequential_matrix_multiply(const std::vector<std::vector<double>>& A,
     }
 }
 
-void parallel_matrix_multiply(const std::vector<std::vector<double>>& A, 
-                             const std::vector<std::vector<double>>& B, 
-                             std::vector<std::vector<double>>& C, int n) {
+void parallel_matrix_multiply(const Matrix& A, 
+                             const Matrix& B, 
+                             Matrix& C, int n) {
     #pragma omp parallel for
     for (int i = 0; i < n; i++) {
         for (int j = 0; j < n; j++) {
@@ -35,15 +52,24 @@ void parallel_matrix_multiply(const std::vector<std::vector<double>>& A,
     }
 }
 
-void generate_random_matrix(std::vector<std::vector<double>>& matrix, int n) {
-    for (int i = 0; i < n; i++) {
-        for (int j = 0; j < n; j++) {
-            matrix[i][j] = ((double)rand() / RAND_MAX) * 10.0;  // Випадкові числа від 0 до 10
-        }
+// Множення з підібраною конфігурацією: як і в lab2_2, кожен потік отримує
+// суцільну смугу рядків, а config.tile — лише плитка кешу всередині ядра
+void parallel_matrix_multiply_tuned(const Matrix& A, 
+                                   const Matrix& B, 
+                                   Matrix& C, int n,
+                                   const MatmulConfig& config) {
+    #pragma omp parallel num_threads(config.threads)
+    {
+        int threads = omp_get_num_threads();
+        int t = omp_get_thread_num();
+        int per = n / threads, extra = n % threads;
+        int begin = t * per + std::min(t, extra);
+        int end = begin + per + (t < extra ? 1 : 0);
+        matmul_rows(A, B, C, n, n, begin, end, config.kernel, config.tile);
     }
 }
 
-void write_matrix_to_file(const std::vector<std::vector<double>>& matrix, int n, const std::string& filename) {
+void write_matrix_to_file(const Matrix& matrix, int n, const std::string& filename) {
     std::ofstream file(filename);
     if (!file.is_open()) {
         std::cout << "Помилка відкриття файлу " << filename << " для запису" << std::endl;
@@ -61,26 +87,102 @@ void write_matrix_to_file(const std::vector<std::vector<double>>& matrix, int n,
     std::cout << "Матриця записана у файл " << filename << std::endl;
 }
 
-int main() {
-    srand(static_cast<unsigned int>(time(nullptr)));
+// Той самий вимір на сторінках 4 КБ та 2 МБ; наївне ядро обходить стовпці B,
+// тож різниця в основному — промахи dTLB
+void compare_page_backings(int n, uint64_t seed) {
+    const PagePolicy policies[] = {PagePolicy::Small, PagePolicy::Huge};
+    const int NUM_RUNS = 3;
+    
+    std::cout << "Порівняння підкріплення пам'яті для " << n << "x" << n << ":" << std::endl;
+    for (PagePolicy policy : policies) {
+        Matrix A(n, policy), B(n, policy), C(n, policy);
+        MatrixGenOptions gen;
+        gen.seed = seed;
+        matrix_generate(A, n, n, gen);
+        gen.seed = seed + 1;
+        matrix_generate(B, n, n, gen);
+        
+        double best = 0.0;
+        for (int run = 0; run < NUM_RUNS; run++) {
+            double start = omp_get_wtime();
+            parallel_matrix_multiply(A, B, C, n);
+            double elapsed = omp_get_wtime() - start;
+            if (run == 0 || elapsed < best) {
+                best = elapsed;
+            }
+        }
+        
+        size_t huge_mb = (A.data.resident_huge_bytes() + B.data.resident_huge_bytes() +
+                          C.data.resident_huge_bytes()) >> 20;
+        std::cout << "- " << page_backing_name(A.data.backing()) << " (на великих сторінках "
+                  << huge_mb << " МБ): " << best << " секунд" << std::endl;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    std::string mode = (argc > 1 && argv[1][0] == '-') ? argv[1] : "";
+    bool autotune = (mode == "--autotune");
+    bool compare_pages = (mode == "--compare-pages");
+    if (autotune || compare_pages) {
+        --argc;
+        ++argv;
+    }
     
-    std::cout << "Створення матриць розміром " << N << "x" << N << "..." << std::endl;
-    std::vector<std::vector<double>> A(N, std::vector<double>(N));
-    std::vector<std::vector<double>> B(N, std::vector<double>(N));
-    std::vector<std::vector<double>> C_seq(N, std::vector<double>(N));
-    std::vector<std::vector<double>> C_par(N, std::vector<double>(N));
+    int n = (argc > 1) ? atoi(argv[1]) : N;
+    uint64_t seed = (argc > 2) ? strtoull(argv[2], nullptr, 10) : 42;
+    if (n <= 0) {
+        std::cout << "Використання: " << argv[0] << " [--autotune | --compare-pages] [розмір_матриць] [seed]" << std::endl;
+        return 1;
+    }
     
-    std::cout << "Генерація випадкових матриць..." << std::endl;
-    generate_random_matrix(A, N);
-    generate_random_matrix(B, N);
+    if (compare_pages) {
+        compare_page_backings(n, seed);
+        return 0;
+    }
     
-    write_matrix_to_file(A, N, "matrix_A.txt");
-    write_matrix_to_file(B, N, "matrix_B.txt");
+    std::cout << "Створення матриць розміром " << n << "x" << n << "..." << std::endl;
+    Matrix A(n), B(n), C_seq(n), C_par(n);
+    
+    // Випадкові числа від 0 до 10; A і B — різні seed, однаковий результат
+    // за будь-якої кількості потоків
+    std::cout << "Генерація випадкових матриць (seed " << seed << ")..." << std::endl;
+    MatrixGenOptions genA;
+    genA.seed = seed;
+    MatrixGenOptions genB = genA;
+    genB.seed = seed + 1;
+    matrix_generate(A, n, n, genA);
+    matrix_generate(B, n, n, genB);
+    std::cout << "Пам'ять матриць: " << page_backing_name(A.data.backing()) << std::endl;
+    
+    // Файли пишуться з уже згенерованих матриць, без другої генерації
+    matrix_write_to_file("matrix_A.txt", A, n, n, MatrixFileFormat::Text);
+    matrix_write_to_file("matrix_B.txt", B, n, n, MatrixFileFormat::Text);
+    std::cout << "Матриці записані у файли matrix_A.txt та matrix_B.txt" << std::endl;
+    
+    AutotuneStore tuned("lab5_2");
+    
+    if (autotune) {
+        AutotuneEntry best = autotune_search(n, n, n, [&](const MatmulConfig& config) {
+            double start = omp_get_wtime();
+            parallel_matrix_multiply_tuned(A, B, C_par, n, config);
+            return (omp_get_wtime() - start) * 1000.0;
+        });
+        
+        tuned.put(best);
+        if (!tuned.save()) {
+            return 1;
+        }
+        std::cout << "Найкраща конфігурація: " << matmul_kernel_name(best.config.kernel)
+                  << ", плитка " << best.config.tile << ", потоків " << best.config.threads
+                  << ", " << best.timeMs << " мс" << std::endl;
+        std::cout << "Збережено у файлі: " << tuned.path() << std::endl;
+        return 0;
+    }
     
     std::cout << "Виконання послідовного множення матриць..." << std::endl;
     double seq_start = omp_get_wtime();
     
-    sequential_matrix_multiply(A, B, C_seq, N);
+    sequential_matrix_multiply(A, B, C_seq, n);
     
     double seq_end = omp_get_wtime();
     double seq_time = seq_end - seq_start;
@@ -98,39 +200,51 @@ int main() {
         std::cout << "- Використання " << num_threads << " потоків..." << std::endl;
         double par_start = omp_get_wtime();
         
-        parallel_matrix_multiply(A, B, C_par, N);
+        parallel_matrix_multiply(A, B, C_par, n);
         
         double par_end = omp_get_wtime();
         par_times[t] = par_end - par_start;
     }
     
-    bool is_correct = true;
-    for (int i = 0; i < N && is_correct; i++) {
-        for (int j = 0; j < N && is_correct; j++) {
-            if (fabs(C_seq[i][j] - C_par[i][j]) > 1e-10) {
-                is_correct = false;
-                std::cout << "Помилка: відмінності в результатах (" << i << ", " << j 
-                         << "): " << C_seq[i][j] << " != " << C_par[i][j] << std::endl;
-                break;
-            }
-        }
+    MatmulConfig config;
+    bool exact = false;
+    bool has_tuned = tuned.lookup(n, n, n, config, exact);
+    double tuned_time = 0.0;
+    if (has_tuned) {
+        std::cout << "- Використання " << (exact ? "налаштованої" : "найближчої налаштованої")
+                  << " конфігурації з " << tuned.path() << "..." << std::endl;
+        double par_start = omp_get_wtime();
+        
+        parallel_matrix_multiply_tuned(A, B, C_par, n, config);
+        
+        tuned_time = omp_get_wtime() - par_start;
     }
     
-    if (is_correct) {
-        std::cout << "Перевірка: результати послідовного та паралельного множення співпадають." << std::endl;
+    // Перевірка за O(n²): повторне послідовне множення для великих N
+    // коштувало б більше, ніж сам вимір
+    FreivaldsResult check = freivalds_verify(A, B, C_par, n, n, n);
+    if (check.ok) {
+        std::cout << "Перевірка: результат паралельного множення коректний." << std::endl;
+    } else {
+        std::cout << "Помилка: відмінності в результатах у рядку " << check.worst_row
+                  << ", відхилення " << check.worst_diff << std::endl;
     }
     
-    write_matrix_to_file(C_seq, N, "result_sequential.txt");
-    write_matrix_to_file(C_par, N, "result_parallel.txt");
+    write_matrix_to_file(C_seq, n, "result_sequential.txt");
+    write_matrix_to_file(C_par, n, "result_parallel.txt");
     
     std::cout << "\nРезультати порівняння" << std::endl;
-    std::cout << "Розмірність матриць: " << N << " x " << N << std::endl;
+    std::cout << "Розмірність матриць: " << n << " x " << n << std::endl;
     std::cout << "Послідовне множення: " << seq_time << " секунд" << std::endl;
     
     std::cout << "\nПаралельне множення за кількістю потоків:" << std::endl;
     for (int t = 0; t < num_tests; t++) {
         std::cout << "- " << thread_counts[t] << " потоків: " << par_times[t] << " секунд" << std::endl;
     }
+    if (has_tuned) {
+        std::cout << "- " << config.threads << " потоків (" << matmul_kernel_name(config.kernel)
+                  << ", плитка " << config.tile << "): " << tuned_time << " секунд" << std::endl;
+    }
     
     return 0;
 }
@@ -8,10 +8,18 @@ set grid
 
 # Встановлюємо стиль ліній та маркерів
 set style line 1 lc rgb '#0060ad' lt 1 lw 2 pt 7 ps 1.5
+set style line 2 lc rgb '#dd181f' lt 1 lw 2 pt 5 ps 1.5
+set style line 3 lc rgb '#00a000' lt 1 lw 2 pt 9 ps 1.5
+set style line 4 lc rgb '#9400d3' lt 1 lw 2 pt 11 ps 1.5
+set style line 5 lc rgb '#ff8c00' lt 1 lw 2 pt 13 ps 1.5
+set style line 6 lc rgb '#505050' lt 1 lw 2 pt 15 ps 1.5
+set key top left
 
-# Встановлюємо діапазон для осі X відповідно до даних
-set xrange [0.5:10.5]
+# Діапазон осі X — за першим стовпчиком timing.dat, з півкроку з боків
+stats "timing.dat" using 1 nooutput
+set xrange [STATS_min - 0.5:STATS_max + 0.5]
 set xtics 1
 
-# Побудова графіка
-plot "timing.dat" using 1:2 with linespoints ls 1 title "Час виконання"
+# Побудова графіка: по одній лінії на кожен стовпчик timing.dat після
+# першого; назви стратегій беруться з рядка заголовка (./lab5 all чи одна)
+plot for [c=2:*] "timing.dat" using 1:c with linespoints ls (c - 1) title columnhead